@@ -0,0 +1,29 @@
+#define DepthSignature \
+    "RootFlags(ALLOW_INPUT_ASSEMBLER_INPUT_LAYOUT), " \
+    "RootConstants(b0,  num32BitConstants = 1, visibility = SHADER_VISIBILITY_ALL), " \
+    "CBV(b1, visibility = SHADER_VISIBILITY_VERTEX), " \
+    "CBV(b2, visibility = SHADER_VISIBILITY_VERTEX)"
+
+
+struct ObjectConstantBuffer
+{
+    float4x4 WVP;
+    float4x4 World;
+    float3x3 Normal;
+};
+
+// Geometry::QuantizedPosition; w is unused
+struct VS_IN
+{
+    float4 Position : POSITION;
+};
+
+ConstantBuffer<ObjectConstantBuffer> ObjectConstant : register(b2);
+
+// Same transform as FillGBuffer, kept precise so both passes write identical depth
+[RootSignature(DepthSignature)]
+float4 VSMain(VS_IN input) : SV_POSITION
+{
+    precise float4 position = mul(ObjectConstant.WVP, float4(input.Position.xyz, 1.0f));
+    return position;
+}
\ No newline at end of file
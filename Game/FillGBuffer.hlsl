@@ -27,11 +27,12 @@ struct ObjectConstantBuffer
 };
 
 
+// Geometry::QuantizedVertex: unorm position with the tangent handedness in w, octahedral normal and tangent
 struct VS_IN
 {
-    float3 Position : POSITION;
-    float3 Normal : NORMAL;
-    float3 Tangent : TANGENT;
+    float4 Position : POSITION;
+    float2 Normal : NORMAL;
+    float2 Tangent : TANGENT;
     float2 Texcoord : TEXCOORD;
 };
 
@@ -52,17 +53,26 @@ Texture2D<float4> Textures[] : register(t0);
 SamplerState SamplerAnisotropy : register(s0);
 SamplerState SamplerLinear : register(s1);
 
+float3 OctDecode(float2 e)
+{
+    float3 v = float3(e, 1.0 - abs(e.x) - abs(e.y));
+    float t = saturate(-v.z);
+    v.xy += (v.xy >= 0.0) ? -t : t;
+    return normalize(v);
+}
+
 [RootSignature(CommonSignature)]
  PS_IN VSMain(VS_IN input)
 {
 
     PS_IN result;
   
-    result.Position = mul(ObjectConstant.WVP, float4(input.Position, 1.0f));
+    precise float4 position = mul(ObjectConstant.WVP, float4(input.Position.xyz, 1.0f));
+    result.Position = position;
  
-    float3 N = mul((float3x3) ObjectConstant.Normal, input.Normal);
-    float3 T = mul((float3x3) ObjectConstant.Normal, input.Tangent);
-    float3 B = cross(T, N);
+    float3 N = mul((float3x3) ObjectConstant.Normal, OctDecode(input.Normal));
+    float3 T = mul((float3x3) ObjectConstant.Normal, OctDecode(input.Tangent));
+    float3 B = (2.0 * input.Position.w - 1.0) * cross(N, T);
 
   
     result.Texcoord = input.Texcoord;
@@ -7,7 +7,6 @@
 #include <wrl.h>
 
 #include <array>
-#include <iostream>
 #include <vector>
 #include <chrono>
 #include <ctime>
@@ -32,11 +31,34 @@
 #include <Hawk/Components/Transform.hpp>
 #include <Hawk/Common/NonCopyable.hpp>
 #include <Hawk/Common/Singleton.hpp>
+#include <Hawk/Common/FixedTimestep.hpp>
+#include <Hawk/Common/Jobs.hpp>
+#include <Hawk/Common/Task.hpp>
+#include <Hawk/Common/File.hpp>
+#include <Hawk/Common/Name.hpp>
+#include <Hawk/Common/Log.hpp>
+#include <Hawk/Containers/FlatHashMap.hpp>
+#include <Hawk/Containers/FixedVector.hpp>
+#include <Hawk/Containers/SmallVector.hpp>
+#include <Hawk/Geometry/Meshlets.hpp>
+#include <Hawk/Geometry/Optimize.hpp>
+#include <Hawk/Geometry/PositionStream.hpp>
+#include <Hawk/Geometry/Quantize.hpp>
+#include <Hawk/Geometry/Simplify.hpp>
+#include <Hawk/Geometry/Split.hpp>
+#include <Hawk/Geometry/Tangents.hpp>
+#include <Hawk/Geometry/Weld.hpp>
+#include <Hawk/Memory/DeletionQueue.hpp>
+#include <Hawk/Memory/ScopedStack.hpp>
 
 
 
 using namespace Hawk;
 
+HAWK_LOG_CATEGORY(Device, Info);
+HAWK_LOG_CATEGORY(Shader, Warning);
+HAWK_LOG_CATEGORY(Asset, Info);
+
 
 
 namespace DX {
@@ -87,15 +109,17 @@ public:
 	auto GetShaderBytecode() const->D3D12_SHADER_BYTECODE;
 	auto GetInputLayout()    const->D3D12_INPUT_LAYOUT_DESC;
 private:
-	Microsoft::WRL::ComPtr<ID3DBlob>               m_Code;
-	Microsoft::WRL::ComPtr<ID3D12ShaderReflection> m_Reflection;
-	std::vector<D3D12_INPUT_ELEMENT_DESC>          m_InputElemetDescArray;
+	Microsoft::WRL::ComPtr<ID3DBlob>                                                     m_Code;
+	Microsoft::WRL::ComPtr<ID3D12ShaderReflection>                                       m_Reflection;
+	FixedVector<D3D12_INPUT_ELEMENT_DESC, D3D12_IA_VERTEX_INPUT_STRUCTURE_ELEMENT_COUNT> m_InputElemetDescArray;
 };
 
 class CommandContext {
 public:
 	CommandContext(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE type, D3D12_FENCE_FLAGS fenceFlags);
 	auto WaitForGPU()     -> void;
+	auto WaitForFence(U64 value) -> void;
+	auto Signal()         -> U64;
 
 	auto ExecuteCmdList() -> void;
 	auto CloseCmdList()   -> void;
@@ -107,6 +131,7 @@ public:
 	auto GetFence()            const->ID3D12Fence*;
 	auto GetFenceValue()       const->U64;
 	auto GetFenceEvent()       const->HANDLE;
+	auto GetCompletedValue()   const->U64;
 private:
 	Microsoft::WRL::ComPtr<ID3D12CommandQueue>        m_CommandQueue;
 	Microsoft::WRL::ComPtr<ID3D12CommandAllocator>    m_CommandAllocator;
@@ -133,7 +158,7 @@ Shader::Shader(std::string const & fileName, std::string const & entryPoint, std
 	D3D12_SHADER_DESC shaderDesc;
 	m_Reflection->GetDesc(&shaderDesc);
 
-	m_InputElemetDescArray.resize(shaderDesc.InputParameters);
+	m_InputElemetDescArray.Resize(shaderDesc.InputParameters);
 	auto index = 0;
 	for (auto& e : m_InputElemetDescArray) {
 
@@ -186,7 +211,7 @@ auto Shader::GetShaderBytecode() const -> D3D12_SHADER_BYTECODE {
 }
 
 auto Shader::GetInputLayout() const -> D3D12_INPUT_LAYOUT_DESC {
-	return { std::data(m_InputElemetDescArray), static_cast<U32>(std::size(m_InputElemetDescArray)) };
+	return { m_InputElemetDescArray.Data(), static_cast<U32>(m_InputElemetDescArray.Size()) };
 }
 
 
@@ -240,13 +265,20 @@ CommandContext::CommandContext(ID3D12Device* device, D3D12_COMMAND_LIST_TYPE typ
 }
 
 auto CommandContext::WaitForGPU() -> void {
+	this->WaitForFence(this->Signal());
+}
 
-	m_CommandQueue->Signal(m_Fence.Get(), m_FenceValue);
-	if (m_Fence->GetCompletedValue() < m_FenceValue) {
-		m_Fence->SetEventOnCompletion(m_FenceValue, m_FenceEvent);
+auto CommandContext::WaitForFence(U64 value) -> void {
+	if (m_Fence->GetCompletedValue() < value) {
+		m_Fence->SetEventOnCompletion(value, m_FenceEvent);
 		WaitForSingleObject(m_FenceEvent, INFINITE);
 	}
-	m_FenceValue++;
+}
+
+// Marks the end of the work submitted so far; resources it uses can be retired against the returned value
+auto CommandContext::Signal() -> U64 {
+	DX::ThrowIfFailed(m_CommandQueue->Signal(m_Fence.Get(), m_FenceValue));
+	return m_FenceValue++;
 }
 
 auto CommandContext::CloseCmdList() -> void {
@@ -287,6 +319,10 @@ auto CommandContext::GetFenceEvent() const -> HANDLE {
 	return m_FenceEvent;
 }
 
+auto CommandContext::GetCompletedValue() const -> U64 {
+	return m_Fence->GetCompletedValue();
+}
+
 
 
 
@@ -306,14 +342,7 @@ struct ObjectConstantBuffer {
 
 
 
-#pragma pack(push,1)
-struct Vertex {
-	Math::Vec3 Position;
-	Math::Vec3 Normal;
-	Math::Vec3 Tangent;
-	Math::Vec2 Texcoord;
-};
-#pragma pack(pop)
+using Vertex = Geometry::Vertex;
 
 
 struct Material {
@@ -328,32 +357,60 @@ struct Material {
 
 };
 
-struct Mesh {
-	uint32_t IndexMaterial;
+// Error is the level's deviation from the source mesh in model units
+struct MeshLod {
 	uint32_t CountIndexes;
-	uint32_t VertexBase;
 	uint32_t Offset;
+	F32      Error;
+};
+
+// Indices of one meshlet relative to the first index of its mesh's level 0
+struct MeshletRange {
+	uint32_t FirstIndex;
+	uint32_t CountIndexes;
+};
+
+// DepthVertexBase locates the mesh in the position-only stream; its indices share the offsets of the full ones
+struct Mesh {
+	uint32_t                 IndexMaterial;
+	uint32_t                 VertexBase;
+	uint32_t                 CountVertices;
+	uint32_t                 DepthVertexBase;
+	Math::Vec3               Center;
+	F32                      Radius;
+	FixedVector<MeshLod, 8>  Lods;
+	uint32_t                 FirstMeshlet;
+	uint32_t                 CountMeshlets;
 };
 
 
 class Model
 {
 public:
-	Model(Microsoft::WRL::ComPtr<ID3D12Device> device, CommandContext& context, DescriptorHeap& heap, std::string filename);
-	auto Draw(CommandContext& context) const noexcept -> void;
-	auto DrawDepth(CommandContext& context) const noexcept -> void;
+	Model(Microsoft::WRL::ComPtr<ID3D12Device> device, CommandContext& context, DescriptorHeap& heap, Jobs::Scheduler& scheduler, Memory::DeletionQueue& deletionQueue, std::string filename);
+	auto Draw(CommandContext& context, Geometry::Frustum const& frustum, Math::Vec3 const& viewPosition, F32 lodScale) const noexcept -> void;
+	auto DrawDepth(CommandContext& context, Geometry::Frustum const& frustum, Math::Vec3 const& viewPosition, F32 lodScale) const noexcept -> void;
+	auto GetDequantize() const noexcept -> Math::Mat4x4 const&;
 
 private:
+	auto DrawMeshes(ID3D12GraphicsCommandList* pCommandList, Geometry::Frustum const& frustum, Math::Vec3 const& viewPosition, F32 lodScale, bool isDepth) const noexcept -> void;
 
 	Microsoft::WRL::ComPtr<ID3D12Resource>  m_VertexBuffer;
 	Microsoft::WRL::ComPtr<ID3D12Resource>  m_IndexBuffer;
 	D3D12_VERTEX_BUFFER_VIEW                m_VBV;
 	D3D12_INDEX_BUFFER_VIEW                 m_IBV;
+	Microsoft::WRL::ComPtr<ID3D12Resource>  m_DepthVertexBuffer;
+	Microsoft::WRL::ComPtr<ID3D12Resource>  m_DepthIndexBuffer;
+	D3D12_VERTEX_BUFFER_VIEW                m_DepthVBV;
+	D3D12_INDEX_BUFFER_VIEW                 m_DepthIBV;
 	uint32_t                                m_CountIndexes;
 	uint32_t                                m_CountVertices;
 	std::vector<DescriptorHandle>           m_SRVs;
 	std::vector<Material>                   m_Materials;
 	std::vector<Mesh>                       m_Meshes;
+	std::vector<MeshletRange>               m_MeshletRanges;
+	std::vector<Geometry::MeshletBounds>    m_MeshletBounds;
+	Math::Mat4x4                            m_Dequantize;
 	std::string                             m_Directory;
 
 };
@@ -371,6 +428,11 @@ int main(int arc, char* argv[]) {
 	auto WINDOW_WIDTH = 1280;
 	auto WINDOW_HEIGHT = 1000;
 
+	Log::Logger::Instance().AddSink(std::make_unique<Log::ConsoleSink>());
+	Log::Logger::Instance().AddSink(std::make_unique<Log::FileSink>("Log.txt"));
+
+	Jobs::Scheduler scheduler;
+
 	SDL_Init(SDL_INIT_EVERYTHING);
 	auto* window = SDL_CreateWindow("D3D12", SDL_WINDOWPOS_UNDEFINED, SDL_WINDOWPOS_UNDEFINED, WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_SHOWN);
 
@@ -453,19 +515,18 @@ int main(int arc, char* argv[]) {
 
 
 		{
-			std::vector<Microsoft::WRL::ComPtr<IDXGIAdapter1>> adapterList;
+			SmallVector<Microsoft::WRL::ComPtr<IDXGIAdapter1>, 4> adapterList;
 			Microsoft::WRL::ComPtr<IDXGIAdapter1> pAdapter;
 			U32 index = 0;
 			while (pFactory->EnumAdapters1(index, pAdapter.GetAddressOf()) != DXGI_ERROR_NOT_FOUND) {
 				DXGI_ADAPTER_DESC1 descAdapter;
 				pAdapter->GetDesc1(&descAdapter);
-				std::wcout << "Description: " << descAdapter.Description << std::endl;
-				std::wcout << "Device ID: " << descAdapter.DeviceId << std::endl;
-				std::wcout << "Video memory: " << descAdapter.DedicatedVideoMemory / (2 << 20) << " Mb" << std::endl;
-				std::wcout << "System memory: " << descAdapter.DedicatedSystemMemory / (2 << 20) << " Mb" << std::endl;
-				std::wcout << "Shared sys memory: " << descAdapter.SharedSystemMemory / (2 << 20) << " Mb" << std::endl;
-				std::wcout << "------------------------------------------------------" << std::endl;
-				adapterList.push_back(pAdapter);
+				HAWK_LOG_INFO(Device, "Description: {}", descAdapter.Description);
+				HAWK_LOG_INFO(Device, "Device ID: {}", descAdapter.DeviceId);
+				HAWK_LOG_INFO(Device, "Video memory: {} Mb", descAdapter.DedicatedVideoMemory / (2 << 20));
+				HAWK_LOG_INFO(Device, "System memory: {} Mb", descAdapter.DedicatedSystemMemory / (2 << 20));
+				HAWK_LOG_INFO(Device, "Shared sys memory: {} Mb", descAdapter.SharedSystemMemory / (2 << 20));
+				adapterList.PushBack(pAdapter);
 				index++;
 			}
 		}
@@ -618,7 +679,10 @@ int main(int arc, char* argv[]) {
 	DX::ThrowIfFailed(pConstantBuffers[1]->Map(0, &CD3DX12_RANGE(0, 0), reinterpret_cast<void**>(&pDataConstBuffer[1])));
 
 
-	Model model(pDevice, cmdGraphicsContext, *descriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV], "C:/Users/Mikhail Gorobets/Desktop/RenderAPI/_Output/v141/x64/Release/Resource/data/sponza.dae");
+	// Upload staging is released once the graphics fence passes the value signalled after the copies
+	Memory::DeletionQueue deletionQueue;
+
+	Model model(pDevice, cmdGraphicsContext, *descriptorHeaps[D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV], scheduler, deletionQueue, "C:/Users/Mikhail Gorobets/Desktop/RenderAPI/_Output/v141/x64/Release/Resource/data/sponza.dae");
 	
 
 	pDevice->CreateRenderTargetView(pRenderTargets[0].Get(), nullptr, RTVs[0].CPU);
@@ -659,22 +723,28 @@ int main(int arc, char* argv[]) {
 		Microsoft::WRL::ComPtr<ID3DBlob> pErrorPSBlob;
 		Microsoft::WRL::ComPtr<ID3DBlob> pRootSignatureBlob;
 
-		if (FAILED(D3DCompileFromFile(L"FillGBuffer.hlsl", nullptr, nullptr, "VSMain", "vs_5_1", compileFlags, 0, pCodeVSBlob.GetAddressOf(), pErrorVSBlob.GetAddressOf()))) {
-			std::cout << static_cast< const char*>(pErrorVSBlob->GetBufferPointer());		
+		if (auto const hr = D3DCompileFromFile(L"FillGBuffer.hlsl", nullptr, nullptr, "VSMain", "vs_5_1", compileFlags, 0, pCodeVSBlob.GetAddressOf(), pErrorVSBlob.GetAddressOf()); FAILED(hr)) {
+			if (pErrorVSBlob)
+				HAWK_LOG_ERROR(Shader, "{}", static_cast<char const*>(pErrorVSBlob->GetBufferPointer()));
+			else
+				HAWK_LOG_ERROR(Shader, "FillGBuffer.hlsl VSMain: compilation failed with HRESULT 0x{:X}", static_cast<U32>(hr));
 		}
 		
-		if (FAILED(D3DCompileFromFile(L"FillGBuffer.hlsl", nullptr, nullptr, "PSMain", "ps_5_1", compileFlags, 0, pCodePSBlob.GetAddressOf(), pErrorPSBlob.GetAddressOf()))) {
-			std::cout << static_cast< const char*>(pErrorPSBlob->GetBufferPointer());
+		if (auto const hr = D3DCompileFromFile(L"FillGBuffer.hlsl", nullptr, nullptr, "PSMain", "ps_5_1", compileFlags, 0, pCodePSBlob.GetAddressOf(), pErrorPSBlob.GetAddressOf()); FAILED(hr)) {
+			if (pErrorPSBlob)
+				HAWK_LOG_ERROR(Shader, "{}", static_cast<char const*>(pErrorPSBlob->GetBufferPointer()));
+			else
+				HAWK_LOG_ERROR(Shader, "FillGBuffer.hlsl PSMain: compilation failed with HRESULT 0x{:X}", static_cast<U32>(hr));
 		}
 
 		DX::ThrowIfFailed(D3DStripShader(pCodeVSBlob->GetBufferPointer(), pCodeVSBlob->GetBufferSize(), D3D_BLOB_ROOT_SIGNATURE, pRootSignatureBlob.GetAddressOf()));
 		DX::ThrowIfFailed(pDevice->CreateRootSignature(0, pRootSignatureBlob->GetBufferPointer(), pRootSignatureBlob->GetBufferSize(), IID_PPV_ARGS(pRSFillGBuffer.GetAddressOf())));
 
 		D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
-			{ "POSITION", 0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-			{ "NORMAL",   0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-			{ "TANGENT",  0, DXGI_FORMAT_R32G32B32_FLOAT, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
-			{ "TEXCOORD", 0, DXGI_FORMAT_R32G32_FLOAT,    0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
+			{ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+			{ "NORMAL",   0, DXGI_FORMAT_R16G16_SNORM,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+			{ "TANGENT",  0, DXGI_FORMAT_R16G16_SNORM,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 },
+			{ "TEXCOORD", 0, DXGI_FORMAT_R16G16_FLOAT,       0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
 		};
 
 		D3D12_GRAPHICS_PIPELINE_STATE_DESC piplineDesc = {};
@@ -684,19 +754,69 @@ int main(int arc, char* argv[]) {
 		piplineDesc.PS = { pCodePSBlob->GetBufferPointer(), pCodePSBlob->GetBufferSize() };
 		piplineDesc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
 		piplineDesc.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
+		// Depth comes from the prepass; this pass only tests against it
 		piplineDesc.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
 		piplineDesc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_GREATER_EQUAL;
+		piplineDesc.DepthStencilState.DepthWriteMask = D3D12_DEPTH_WRITE_MASK_ZERO;
 		
 		piplineDesc.SampleMask = UINT_MAX;
 		piplineDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
 		piplineDesc.NumRenderTargets = 1;
 		piplineDesc.RTVFormats[0] = DXGI_FORMAT_R8G8B8A8_UNORM;
+		piplineDesc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
 		piplineDesc.SampleDesc.Count = 1;
 
 		DX::ThrowIfFailed(pDevice->CreateGraphicsPipelineState(&piplineDesc, IID_PPV_ARGS(pPSOFillGBuffer.GetAddressOf())));
 	}
 
 
+	Microsoft::WRL::ComPtr<ID3D12RootSignature> pRSDepthPrepass;
+	Microsoft::WRL::ComPtr<ID3D12PipelineState> pPSODepthPrepass;
+	{
+
+		U32 compileFlags = D3DCOMPILE_PACK_MATRIX_ROW_MAJOR | D3DCOMPILE_WARNINGS_ARE_ERRORS | D3DCOMPILE_ENABLE_STRICTNESS | D3DCOMPILE_OPTIMIZATION_LEVEL3;
+#ifdef _DEBUG
+		compileFlags = D3DCOMPILE_DEBUG | D3DCOMPILE_PACK_MATRIX_ROW_MAJOR;
+#endif
+
+		Microsoft::WRL::ComPtr<ID3DBlob> pCodeVSBlob;
+		Microsoft::WRL::ComPtr<ID3DBlob> pErrorVSBlob;
+		Microsoft::WRL::ComPtr<ID3DBlob> pRootSignatureBlob;
+
+		if (auto const hr = D3DCompileFromFile(L"DepthPrepass.hlsl", nullptr, nullptr, "VSMain", "vs_5_1", compileFlags, 0, pCodeVSBlob.GetAddressOf(), pErrorVSBlob.GetAddressOf()); FAILED(hr)) {
+			if (pErrorVSBlob)
+				HAWK_LOG_ERROR(Shader, "{}", static_cast<char const*>(pErrorVSBlob->GetBufferPointer()));
+			else
+				HAWK_LOG_ERROR(Shader, "DepthPrepass.hlsl VSMain: compilation failed with HRESULT 0x{:X}", static_cast<U32>(hr));
+		}
+
+		DX::ThrowIfFailed(D3DStripShader(pCodeVSBlob->GetBufferPointer(), pCodeVSBlob->GetBufferSize(), D3D_BLOB_ROOT_SIGNATURE, pRootSignatureBlob.GetAddressOf()));
+		DX::ThrowIfFailed(pDevice->CreateRootSignature(0, pRootSignatureBlob->GetBufferPointer(), pRootSignatureBlob->GetBufferSize(), IID_PPV_ARGS(pRSDepthPrepass.GetAddressOf())));
+
+		D3D12_INPUT_ELEMENT_DESC inputLayout[] = {
+			{ "POSITION", 0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, D3D12_APPEND_ALIGNED_ELEMENT, D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA, 0 }
+		};
+
+		// No pixel shader and no render targets: the pass only lays down depth for the G-buffer to test against
+		D3D12_GRAPHICS_PIPELINE_STATE_DESC piplineDesc = {};
+		piplineDesc.InputLayout = { inputLayout, _countof(inputLayout) };
+		piplineDesc.pRootSignature = pRSDepthPrepass.Get();
+		piplineDesc.VS = { pCodeVSBlob->GetBufferPointer(), pCodeVSBlob->GetBufferSize() };
+		piplineDesc.RasterizerState = CD3DX12_RASTERIZER_DESC(D3D12_DEFAULT);
+		piplineDesc.BlendState = CD3DX12_BLEND_DESC(D3D12_DEFAULT);
+		piplineDesc.DepthStencilState = CD3DX12_DEPTH_STENCIL_DESC(D3D12_DEFAULT);
+		piplineDesc.DepthStencilState.DepthFunc = D3D12_COMPARISON_FUNC_GREATER_EQUAL;
+
+		piplineDesc.SampleMask = UINT_MAX;
+		piplineDesc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+		piplineDesc.NumRenderTargets = 0;
+		piplineDesc.DSVFormat = DXGI_FORMAT_D32_FLOAT;
+		piplineDesc.SampleDesc.Count = 1;
+
+		DX::ThrowIfFailed(pDevice->CreateGraphicsPipelineState(&piplineDesc, IID_PPV_ARGS(pPSODepthPrepass.GetAddressOf())));
+	}
+
+
 	Microsoft::WRL::ComPtr<ID3D12RootSignature> pRSAmbientOclussion;
 	Microsoft::WRL::ComPtr<ID3D12PipelineState> pPSOAmbientOclission;
 	{
@@ -710,8 +830,11 @@ int main(int arc, char* argv[]) {
 		Microsoft::WRL::ComPtr<ID3DBlob> pErrorCSBlob;
 		Microsoft::WRL::ComPtr<ID3DBlob> pRootSignatureBlob;
 
-		if (FAILED(D3DCompileFromFile(L"SSAO.hlsl", nullptr, nullptr, "CSMain", "cs_5_1", compileFlags, 0, pCodeCSBlob.GetAddressOf(), pErrorCSBlob.GetAddressOf()))) {
-			std::cout << static_cast< const char*>(pErrorCSBlob->GetBufferPointer());
+		if (auto const hr = D3DCompileFromFile(L"SSAO.hlsl", nullptr, nullptr, "CSMain", "cs_5_1", compileFlags, 0, pCodeCSBlob.GetAddressOf(), pErrorCSBlob.GetAddressOf()); FAILED(hr)) {
+			if (pErrorCSBlob)
+				HAWK_LOG_ERROR(Shader, "{}", static_cast<char const*>(pErrorCSBlob->GetBufferPointer()));
+			else
+				HAWK_LOG_ERROR(Shader, "SSAO.hlsl CSMain: compilation failed with HRESULT 0x{:X}", static_cast<U32>(hr));
 		}
 
 		DX::ThrowIfFailed(D3DStripShader(pCodeCSBlob->GetBufferPointer(), pCodeCSBlob->GetBufferSize(), D3D_BLOB_ROOT_SIGNATURE, pRootSignatureBlob.GetAddressOf()));
@@ -737,8 +860,11 @@ int main(int arc, char* argv[]) {
 		Microsoft::WRL::ComPtr<ID3DBlob> pErrorCSBlob;
 		Microsoft::WRL::ComPtr<ID3DBlob> pRootSignatureBlob;
 
-		if (FAILED(D3DCompileFromFile(L"SSLR.hlsl", nullptr, nullptr, "CSMain", "cs_5_1", compileFlags, 0, pCodeCSBlob.GetAddressOf(), pErrorCSBlob.GetAddressOf()))) {
-			std::cout << static_cast< const char*>(pErrorCSBlob->GetBufferPointer());
+		if (auto const hr = D3DCompileFromFile(L"SSLR.hlsl", nullptr, nullptr, "CSMain", "cs_5_1", compileFlags, 0, pCodeCSBlob.GetAddressOf(), pErrorCSBlob.GetAddressOf()); FAILED(hr)) {
+			if (pErrorCSBlob)
+				HAWK_LOG_ERROR(Shader, "{}", static_cast<char const*>(pErrorCSBlob->GetBufferPointer()));
+			else
+				HAWK_LOG_ERROR(Shader, "SSLR.hlsl CSMain: compilation failed with HRESULT 0x{:X}", static_cast<U32>(hr));
 		}
 
 		DX::ThrowIfFailed(D3DStripShader(pCodeCSBlob->GetBufferPointer(), pCodeCSBlob->GetBufferSize(), D3D_BLOB_ROOT_SIGNATURE, pRootSignatureBlob.GetAddressOf()));
@@ -766,12 +892,18 @@ int main(int arc, char* argv[]) {
 		Microsoft::WRL::ComPtr<ID3DBlob> pErrorPSBlob;
 		Microsoft::WRL::ComPtr<ID3DBlob> pRootSignatureBlob;
 
-		if (FAILED(D3DCompileFromFile(L"FinalPass.hlsl", nullptr, nullptr, "VSMain", "vs_5_1", compileFlags, 0, pCodeVSBlob.GetAddressOf(), pErrorVSBlob.GetAddressOf()))) {
-			std::cout << static_cast< const char*>(pErrorVSBlob->GetBufferPointer());
+		if (auto const hr = D3DCompileFromFile(L"FinalPass.hlsl", nullptr, nullptr, "VSMain", "vs_5_1", compileFlags, 0, pCodeVSBlob.GetAddressOf(), pErrorVSBlob.GetAddressOf()); FAILED(hr)) {
+			if (pErrorVSBlob)
+				HAWK_LOG_ERROR(Shader, "{}", static_cast<char const*>(pErrorVSBlob->GetBufferPointer()));
+			else
+				HAWK_LOG_ERROR(Shader, "FinalPass.hlsl VSMain: compilation failed with HRESULT 0x{:X}", static_cast<U32>(hr));
 		}
 
-		if (FAILED(D3DCompileFromFile(L"FinalPass.hlsl", nullptr, nullptr, "PSMain", "ps_5_1", compileFlags, 0, pCodePSBlob.GetAddressOf(), pErrorPSBlob.GetAddressOf()))) {
-			std::cout << static_cast< const char*>(pErrorPSBlob->GetBufferPointer());
+		if (auto const hr = D3DCompileFromFile(L"FinalPass.hlsl", nullptr, nullptr, "PSMain", "ps_5_1", compileFlags, 0, pCodePSBlob.GetAddressOf(), pErrorPSBlob.GetAddressOf()); FAILED(hr)) {
+			if (pErrorPSBlob)
+				HAWK_LOG_ERROR(Shader, "{}", static_cast<char const*>(pErrorPSBlob->GetBufferPointer()));
+			else
+				HAWK_LOG_ERROR(Shader, "FinalPass.hlsl PSMain: compilation failed with HRESULT 0x{:X}", static_cast<U32>(hr));
 		}
 
 		DX::ThrowIfFailed(D3DStripShader(pCodeVSBlob->GetBufferPointer(), pCodeVSBlob->GetBufferSize(), D3D_BLOB_ROOT_SIGNATURE, pRootSignatureBlob.GetAddressOf()));
@@ -800,6 +932,14 @@ int main(int arc, char* argv[]) {
 	auto camera = Components::Camera{};
 	auto transform = Components::Transform{};
 
+	auto cameraPrevious    = camera;
+	auto transformPrevious = transform;
+
+	// Camera position and frustum in model space, and pixels per unit of model error at unit distance,
+	// for LOD selection and meshlet culling
+	auto lodViewPosition = Math::Vec3{ 0.0f, 0.0f, 0.0f };
+	auto lodFrustum      = Geometry::Frustum{};
+	auto const lodScale  = static_cast<F32>(WINDOW_HEIGHT) / (2.0f * std::tan(3.14f / 8.0f));
 
 
 
@@ -807,11 +947,18 @@ int main(int arc, char* argv[]) {
 	//cmdContext.ExecuteCmdList();
 	//cmdContext.WaitForGPU();
 
+	// Model's uploads ran while the pipelines above were built; the first frame recycles their allocator
+	cmdGraphicsContext.WaitForGPU();
+	deletionQueue.Collect(cmdGraphicsContext.GetCompletedValue());
+
 	bool running = true;
 	SDL_Event event;
 
 	bool mouseDown = false;
 
+	auto simulationClock = FixedTimestep{ 1.0 / 60.0 };
+	auto mouseMotion = Math::Vec2{ 0.0f, 0.0f };
+
 	while (running) {
 
 		{
@@ -828,10 +975,8 @@ int main(int arc, char* argv[]) {
 					mouseDown = false;
 					break;
 				case SDL_MOUSEMOTION: {
-					if (mouseDown) {							
-						camera.Rotate(Components::Camera::LocalUp, -rotateSensivity * static_cast<F32>(event.motion.xrel));
-						camera.Rotate(camera.Right(),  -rotateSensivity * static_cast<F32>(event.motion.yrel));
-					}
+					if (mouseDown)
+						mouseMotion += Math::Vec2{ static_cast<F32>(event.motion.xrel), static_cast<F32>(event.motion.yrel) };
 					break;			
 				}
 				case SDL_QUIT:
@@ -844,29 +989,42 @@ int main(int arc, char* argv[]) {
 
 			auto const* keyboardState = SDL_GetKeyboardState(NULL);
 
-			auto distance = Math::Vec3{ 0.0f, 0.0f, 0.0f };
+			auto const countSteps = simulationClock.Advance();
+			for (auto step = 0u; step < countSteps; step++) {
 
-			if ((keyboardState[SDL_SCANCODE_DOWN]) || (keyboardState[SDL_SCANCODE_W]))
-				distance += moveSensivity * camera.Forward();
+				cameraPrevious    = camera;
+				transformPrevious = transform;
+
+				if (step == 0) {
+					camera.Rotate(Components::Camera::LocalUp, -rotateSensivity * mouseMotion.x);
+					camera.Rotate(camera.Right(), -rotateSensivity * mouseMotion.y);
+					mouseMotion = Math::Vec2{ 0.0f, 0.0f };
+				}
 
-			if ((keyboardState[SDL_SCANCODE_DOWN]) || (keyboardState[SDL_SCANCODE_S]))
-				distance -= moveSensivity * camera.Forward();
+				auto distance = Math::Vec3{ 0.0f, 0.0f, 0.0f };
 
+				if ((keyboardState[SDL_SCANCODE_DOWN]) || (keyboardState[SDL_SCANCODE_W]))
+					distance += moveSensivity * camera.Forward();
 
-			if ((keyboardState[SDL_SCANCODE_DOWN]) || (keyboardState[SDL_SCANCODE_A]))
-				distance -= moveSensivity * camera.Right();
+				if ((keyboardState[SDL_SCANCODE_DOWN]) || (keyboardState[SDL_SCANCODE_S]))
+					distance -= moveSensivity * camera.Forward();
 
-			if ((keyboardState[SDL_SCANCODE_DOWN]) || (keyboardState[SDL_SCANCODE_D]))
-				distance += moveSensivity * camera.Right();
 
+				if ((keyboardState[SDL_SCANCODE_DOWN]) || (keyboardState[SDL_SCANCODE_A]))
+					distance -= moveSensivity * camera.Right();
 
-			if ((keyboardState[SDL_SCANCODE_DOWN]) || (keyboardState[SDL_SCANCODE_Q]))
-				distance += moveSensivity * camera.Up();
+				if ((keyboardState[SDL_SCANCODE_DOWN]) || (keyboardState[SDL_SCANCODE_D]))
+					distance += moveSensivity * camera.Right();
 
-			if ((keyboardState[SDL_SCANCODE_DOWN]) || (keyboardState[SDL_SCANCODE_E]))
-				distance -= moveSensivity * camera.Up();
 
-			camera.Translate(distance);
+				if ((keyboardState[SDL_SCANCODE_DOWN]) || (keyboardState[SDL_SCANCODE_Q]))
+					distance += moveSensivity * camera.Up();
+
+				if ((keyboardState[SDL_SCANCODE_DOWN]) || (keyboardState[SDL_SCANCODE_E]))
+					distance -= moveSensivity * camera.Up();
+
+				camera.Translate(distance);
+			}
 
 		}
 
@@ -886,6 +1044,22 @@ int main(int arc, char* argv[]) {
 		//Z-PrePass
 		{
 
+			D3D12_RESOURCE_BARRIER pPrepassBarriers[] = {
+				CD3DX12_RESOURCE_BARRIER::Transition(pGBufferDepth.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_DEPTH_WRITE)
+			};
+
+			pCmdListGraphics->RSSetViewports(1, &CD3DX12_VIEWPORT{ 0.0f, 0.0f, static_cast<F32>(WINDOW_WIDTH),static_cast<F32>(WINDOW_HEIGHT), 0.0f, 1.0f });
+			pCmdListGraphics->RSSetScissorRects(1, &CD3DX12_RECT{ 0, 0, WINDOW_WIDTH, WINDOW_HEIGHT });
+			pCmdListGraphics->ResourceBarrier(_countof(pPrepassBarriers), pPrepassBarriers);
+			pCmdListGraphics->OMSetRenderTargets(0, nullptr, false, &DSVGBufferDepth.CPU);
+			pCmdListGraphics->ClearDepthStencilView(DSVGBufferDepth.CPU, D3D12_CLEAR_FLAG_DEPTH, 0.0f, 0, 0, nullptr);
+
+			pCmdListGraphics->SetPipelineState(pPSODepthPrepass.Get());
+			pCmdListGraphics->SetGraphicsRootSignature(pRSDepthPrepass.Get());
+			pCmdListGraphics->SetGraphicsRootConstantBufferView(1, pConstantBuffers[0]->GetGPUVirtualAddress());
+			pCmdListGraphics->SetGraphicsRootConstantBufferView(2, pConstantBuffers[1]->GetGPUVirtualAddress());
+			pCmdListGraphics->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+			model.DrawDepth(cmdGraphicsContext, lodFrustum, lodViewPosition, lodScale);
 
 		}
 
@@ -902,8 +1076,7 @@ int main(int arc, char* argv[]) {
 
 			D3D12_RESOURCE_BARRIER pGBufferBeginBarriers[] = {
 				CD3DX12_RESOURCE_BARRIER::Transition(pGBufferDiffuse.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET),
-				CD3DX12_RESOURCE_BARRIER::Transition(pGBufferNormal.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET),
-				CD3DX12_RESOURCE_BARRIER::Transition(pGBufferDepth.Get(),  D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE,  D3D12_RESOURCE_STATE_DEPTH_WRITE)
+				CD3DX12_RESOURCE_BARRIER::Transition(pGBufferNormal.Get(), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, D3D12_RESOURCE_STATE_RENDER_TARGET)
 			};
 
 			D3D12_RESOURCE_BARRIER pGBufferEndBarriers[] = {
@@ -928,7 +1101,6 @@ int main(int arc, char* argv[]) {
 
 			pCmdListGraphics->ClearRenderTargetView(RTVGBufferDiffuse.CPU, std::data({ 0.0f, 0.0f, 0.0f, 1.0f }), 0, nullptr);
 			pCmdListGraphics->ClearRenderTargetView(RTVGBufferNormal.CPU,  std::data({ 0.0f, 0.0f, 0.0f, 1.0f }), 0, nullptr);
-			pCmdListGraphics->ClearDepthStencilView(DSVGBufferDepth.CPU, D3D12_CLEAR_FLAG_DEPTH, 0.0f, 0, 0, nullptr);
 
 
 			pCmdListGraphics->SetPipelineState(pPSOFillGBuffer.Get());
@@ -939,7 +1111,7 @@ int main(int arc, char* argv[]) {
 			pCmdListGraphics->SetGraphicsRootConstantBufferView(1, pConstantBuffers[0]->GetGPUVirtualAddress());
 			pCmdListGraphics->SetGraphicsRootConstantBufferView(2, pConstantBuffers[1]->GetGPUVirtualAddress());
 			pCmdListGraphics->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
-			model.Draw(cmdGraphicsContext);
+			model.Draw(cmdGraphicsContext, lodFrustum, lodViewPosition, lodScale);
 			pCmdListGraphics->ResourceBarrier(_countof(pGBufferEndBarriers), pGBufferEndBarriers);
 
 		
@@ -1010,22 +1182,33 @@ int main(int arc, char* argv[]) {
 		cmdGraphicsContext.ExecuteCmdList();
 		DX::ThrowIfFailed(pSwapChain->Present(0, 0));
 		cmdGraphicsContext.WaitForGPU();
+		deletionQueue.Collect(cmdGraphicsContext.GetCompletedValue());
 
 
 
 
 		{
+			auto cameraRender    = Components::Lerp(cameraPrevious, camera, simulationClock.Alpha());
+			auto transformRender = Components::Lerp(transformPrevious, transform, simulationClock.Alpha());
+
 			FrameConstantBuffer frameBuffer;
-			frameBuffer.View    = camera.ToMatrix();
+			frameBuffer.View    = cameraRender.ToMatrix();
 			frameBuffer.Project = Math::Perspective(3.14f / 4.0f, static_cast<F32>(WINDOW_WIDTH) / static_cast<F32>(WINDOW_HEIGHT), 0.1f, 1000.0f);
 			std::memcpy(pDataConstBuffer[0], &frameBuffer, sizeof(FrameConstantBuffer));
 
+			// Culling works in model space; only the shader sees the quantized positions
+			auto const world = transformRender.ToMatrix();
+
 			ObjectConstantBuffer objectBuffer;		
-			objectBuffer.World  = transform.ToMatrix();
-			objectBuffer.WVP    = frameBuffer.Project * camera.ToMatrix() * transform.ToMatrix();
-			objectBuffer.Normal = Math::Convert<Math::Quat, Math::Mat4x4>(transform.Rotation());
+			objectBuffer.World  = world * model.GetDequantize();
+			objectBuffer.WVP    = frameBuffer.Project * cameraRender.ToMatrix() * objectBuffer.World;
+			objectBuffer.Normal = Math::Convert<Math::Quat, Math::Mat4x4>(transformRender.Rotation());
 			std::memcpy(pDataConstBuffer[1], &objectBuffer, sizeof(ObjectConstantBuffer));
 
+			auto const viewPosition = Math::Inverse(world) * Math::Vec4{ cameraRender.Translation(), 1.0f };
+			lodViewPosition = Math::Vec3{ viewPosition.x, viewPosition.y, viewPosition.z };
+			lodFrustum      = Geometry::ExtractFrustum(frameBuffer.Project * cameraRender.ToMatrix() * world);
+
 		}
 
 		
@@ -1036,6 +1219,7 @@ int main(int arc, char* argv[]) {
 
 	SDL_DestroyWindow(window);
 	SDL_Quit();
+	Log::Logger::Instance().Shutdown();
 	return 0;
 }
 
@@ -1043,7 +1227,7 @@ int main(int arc, char* argv[]) {
 
 
 
-Model::Model(Microsoft::WRL::ComPtr<ID3D12Device> device, CommandContext& context, DescriptorHeap& heap, std::string filename) {
+Model::Model(Microsoft::WRL::ComPtr<ID3D12Device> device, CommandContext& context, DescriptorHeap& heap, Jobs::Scheduler& scheduler, Memory::DeletionQueue& deletionQueue, std::string filename) {
 
 	m_Directory = filename.substr(0, filename.find_last_of('/'));
 
@@ -1053,36 +1237,65 @@ Model::Model(Microsoft::WRL::ComPtr<ID3D12Device> device, CommandContext& contex
 		aiProcess_FlipUVs |
 		aiProcess_GenNormals |
 		aiProcess_GenSmoothNormals |
-		aiProcess_CalcTangentSpace |
 		aiProcess_FixInfacingNormals |
-		aiProcess_ImproveCacheLocality |
 		aiProcess_OptimizeGraph |
 		aiProcess_OptimizeMeshes |
-		aiProcessPreset_TargetRealtime_MaxQuality);
+		(aiProcessPreset_TargetRealtime_MaxQuality & ~(aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices)));
 
 	if (pScene == NULL)
 		throw std::runtime_error("Dont't load file: " + filename);
 
 
-	std::vector<Vertex>   vertices;
-	std::vector<uint32_t> indices;
+	auto countVertices = size_t{ 0 };
+	auto countIndices  = size_t{ 0 };
+	for (auto indexMesh = 0u; indexMesh < pScene->mNumMeshes; indexMesh++) {
+		auto const countMeshVertices = 2 * size_t{ pScene->mMeshes[indexMesh]->mNumVertices };
+		auto const countMeshIndices  = 3 * size_t{ pScene->mMeshes[indexMesh]->mNumFaces };
+		countVertices += countMeshVertices > Geometry::MaxVertices16Bit ? (std::max)(countMeshVertices, countMeshIndices) : countMeshVertices;
+		countIndices  += countMeshIndices;
+	}
 
-	Material materialDefault;	
-	
-	auto filenameDiffuse  = m_Directory + "/sponza/dummy.dds";
-	auto filenameSpecular = m_Directory + "/sponza/dummy_specular.dds";
-	auto filenameNormal   = m_Directory + "/sponza/dummy_ddn.dds";
+	// Loader scratch lives on one stack block sized up front, so assembling the geometry never reallocates.
+	// Tangent generation splits a vertex at most once, on a mirrored UV seam, so twice the vertices always fit.
+	// A mesh that may outgrow 16-bit indices also copies vertices across its cuts, to at most one per index.
+	// Simplified levels depend on the error budget, so they and the final index buffer go to the heap instead
+	Memory::ScopedStack scratch{ countVertices * sizeof(Vertex) + countIndices * sizeof(uint32_t) + 4 * HAWK_CACHE_LINE_SIZE };
+
+	std::pmr::vector<Vertex>   vertices{ &scratch.Resource() };
+	std::pmr::vector<uint32_t> indices{ &scratch.Resource() };
+	vertices.reserve(countVertices);
+	indices.reserve(countIndices);
+	m_Meshes.reserve(pScene->mNumMeshes);
+
+	// Texture files are read on the worker pool while the geometry below is assembled on this thread.
+	// Materials share many textures, so each normalized path is read and created once and the rest alias it
+	Jobs::Counter                                                        textureReads;
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>*>                 textureTargets;
+	std::vector<Task<std::vector<U8>>>                                   textureFiles;
+	std::vector<std::pair<Microsoft::WRL::ComPtr<ID3D12Resource>*, U32>> textureAliases;
+	FlatHashMap<Name, U32>                                               textureIndices;
+	textureTargets.reserve(3 * (pScene->mNumMaterials + 1));
+	textureFiles.reserve(3 * (pScene->mNumMaterials + 1));
+	textureIndices.Reserve(3 * (pScene->mNumMaterials + 1));
+
+	auto loadTexture = [&](Microsoft::WRL::ComPtr<ID3D12Resource>& texture, std::string filename) {
+		auto const [index, isInserted] = textureIndices.TryEmplace(Name{ filename }, static_cast<U32>(textureFiles.size()));
+		if (!isInserted) {
+			textureAliases.emplace_back(&texture, *index);
+			return;
+		}
+		textureTargets.push_back(&texture);
+		textureFiles.push_back(File::ReadAsync(scheduler, std::move(filename)));
+		Launch(scheduler, textureFiles.back(), textureReads);
+	};
 
+	m_Materials.resize(pScene->mNumMaterials + 1);
 
-	DirectX::ResourceUploadBatch resourceUpload{ device.Get() };
-	resourceUpload.Begin();
-	DX::ThrowIfFailed(DirectX::CreateDDSTextureFromFile(device.Get(), resourceUpload, std::wstring(filenameDiffuse.begin(),  filenameDiffuse.end()).c_str(), materialDefault.TexDiffuse.ReleaseAndGetAddressOf()));
-	DX::ThrowIfFailed(DirectX::CreateDDSTextureFromFile(device.Get(), resourceUpload, std::wstring(filenameSpecular.begin(), filenameSpecular.end()).c_str(), materialDefault.TexSpecular.ReleaseAndGetAddressOf()));
-	DX::ThrowIfFailed(DirectX::CreateDDSTextureFromFile(device.Get(), resourceUpload, std::wstring(filenameNormal.begin(),   filenameNormal.end()).c_str(), materialDefault.TexNormal.ReleaseAndGetAddressOf()));
-	resourceUpload.End(context.GetCmdQueue()).wait();
+	auto& materialDefault = m_Materials[0];
+	loadTexture(materialDefault.TexDiffuse,  m_Directory + "/sponza/dummy.dds");
+	loadTexture(materialDefault.TexSpecular, m_Directory + "/sponza/dummy_specular.dds");
+	loadTexture(materialDefault.TexNormal,   m_Directory + "/sponza/dummy_ddn.dds");
 
-	m_Materials.push_back(materialDefault);
-	
 	for (auto indexMaterial = 0u; indexMaterial < pScene->mNumMaterials; indexMaterial++) {
 
 		aiString  strDiffuse;
@@ -1100,45 +1313,40 @@ Model::Model(Microsoft::WRL::ComPtr<ID3D12Device> device, CommandContext& contex
 		pScene->mMaterials[indexMaterial]->Get(AI_MATKEY_COLOR_SPECULAR, specular);
 		pScene->mMaterials[indexMaterial]->Get(AI_MATKEY_COLOR_EMISSIVE, emissive);
 		pScene->mMaterials[indexMaterial]->Get(AI_MATKEY_COLOR_TRANSPARENT, transperent);
-	
-		Material material{ materialDefault };
-		
-		DirectX::ResourceUploadBatch resourceUpload{ device.Get() };
-		resourceUpload.Begin();
-
-		if (pScene->mMaterials[indexMaterial]->GetTextureCount(aiTextureType_DIFFUSE) > 0) {
-			filenameDiffuse = m_Directory + strDiffuse.C_Str();
-			DX::ThrowIfFailed(DirectX::CreateDDSTextureFromFile(device.Get(), resourceUpload, std::wstring(filenameDiffuse.begin(), filenameDiffuse.end()).c_str(), material.TexDiffuse.GetAddressOf()));
-		}
-
-		if (pScene->mMaterials[indexMaterial]->GetTextureCount(aiTextureType_SPECULAR) > 0) {
-			filenameSpecular = m_Directory + strSpecular.C_Str();
-			DX::ThrowIfFailed(DirectX::CreateDDSTextureFromFile(device.Get(), resourceUpload, std::wstring(filenameSpecular.begin(), filenameSpecular.end()).c_str(), material.TexSpecular.GetAddressOf()));
-		}
 
-		if (pScene->mMaterials[indexMaterial]->GetTextureCount(aiTextureType_NORMALS) > 0) {
-			filenameNormal = m_Directory + strNormal.C_Str();
-			DX::ThrowIfFailed(DirectX::CreateDDSTextureFromFile(device.Get(), resourceUpload, std::wstring(filenameNormal.begin(), filenameNormal.end()).c_str(), material.TexNormal.GetAddressOf()));
-		}
+		auto& material = m_Materials[indexMaterial + 1];
 
-		resourceUpload.End(context.GetCmdQueue()).wait();
+		if (pScene->mMaterials[indexMaterial]->GetTextureCount(aiTextureType_DIFFUSE) > 0)
+			loadTexture(material.TexDiffuse, m_Directory + strDiffuse.C_Str());
 
-		m_SRVs.push_back(heap.GenerateHandle());
-		m_SRVs.push_back(heap.GenerateHandle());
-		m_SRVs.push_back(heap.GenerateHandle());
+		if (pScene->mMaterials[indexMaterial]->GetTextureCount(aiTextureType_SPECULAR) > 0)
+			loadTexture(material.TexSpecular, m_Directory + strSpecular.C_Str());
 
-		DirectX::CreateShaderResourceView(device.Get(), material.TexDiffuse.Get(),  m_SRVs[3 * indexMaterial + 0].CPU);
-		DirectX::CreateShaderResourceView(device.Get(), material.TexSpecular.Get(), m_SRVs[3 * indexMaterial + 1].CPU);
-		DirectX::CreateShaderResourceView(device.Get(), material.TexNormal.Get(),   m_SRVs[3 * indexMaterial + 2].CPU);
-
-		m_Materials.push_back(material);
-	
+		if (pScene->mMaterials[indexMaterial]->GetTextureCount(aiTextureType_NORMALS) > 0)
+			loadTexture(material.TexNormal, m_Directory + strNormal.C_Str());
 	}
 
 	
 	m_CountVertices = 0;
 	m_CountIndexes  = 0;
 
+	auto countImported = size_t{ 0 };
+	auto countWelded   = size_t{ 0 };
+	auto bytesWelded   = size_t{ 0 };
+
+	std::vector<uint32_t> lodIndices;
+	auto countLevels    = size_t{ 0 };
+	auto countSubMeshes = size_t{ 0 };
+
+	auto before = Geometry::MeshStatistics{};
+	auto after  = Geometry::MeshStatistics{};
+	auto const accumulate = [](Geometry::MeshStatistics& total, Geometry::MeshStatistics const& mesh) {
+		total.CountVertices  += mesh.CountVertices;
+		total.CountTriangles += mesh.CountTriangles;
+		total.Cache.CountTransformed += mesh.Cache.CountTransformed;
+		total.Fetch.BytesFetched     += mesh.Fetch.BytesFetched;
+	};
+
 	for (auto indexMesh = 0u; indexMesh < pScene->mNumMeshes; indexMesh++) {
 
 		for (auto indexElement = 0u; indexElement < pScene->mMeshes[indexMesh]->mNumVertices; indexElement++) {
@@ -1154,11 +1362,6 @@ Model::Model(Microsoft::WRL::ComPtr<ID3D12Device> device, CommandContext& contex
 				pScene->mMeshes[indexMesh]->mNormals[indexElement].y,
 				pScene->mMeshes[indexMesh]->mNormals[indexElement].z };
 
-			vertex.Tangent = {
-				pScene->mMeshes[indexMesh]->mTangents[indexElement].x,
-				pScene->mMeshes[indexMesh]->mTangents[indexElement].y,
-				pScene->mMeshes[indexMesh]->mTangents[indexElement].z };
-
 			vertex.Texcoord = {
 				pScene->mMeshes[indexMesh]->mTextureCoords[0][indexElement].x,
 				pScene->mMeshes[indexMesh]->mTextureCoords[0][indexElement].y };
@@ -1172,31 +1375,190 @@ Model::Model(Microsoft::WRL::ComPtr<ID3D12Device> device, CommandContext& contex
 			indices.push_back(face.mIndices[1]);
 			indices.push_back(face.mIndices[2]);
 		}
+
+		// Importers emit a copy of a vertex for every face that uses it; weld them before tangents are generated
+		auto const weld = Geometry::Weld(std::span<Vertex>{ vertices }.subspan(m_CountVertices), std::span<uint32_t>{ indices }.subspan(m_CountIndexes), {}, &scheduler);
+		vertices.resize(m_CountVertices + weld.CountVerticesAfter);
+		countImported += weld.CountVerticesBefore;
+		countWelded   += weld.CountVerticesAfter;
+		bytesWelded   += weld.BytesSaved;
+
+		// Tangent frames are generated here rather than by Assimp; a vertex only gains a copy on a mirrored UV seam
+		auto const split = Geometry::ComputeTangents(std::span<Vertex const>{ vertices }.subspan(m_CountVertices), std::span<uint32_t>{ indices }.subspan(m_CountIndexes), &scheduler);
+		vertices.resize(m_CountVertices + split.Remap.size());
+		for (auto index = split.Remap.size(); index-- > 0;) {
+			vertices[m_CountVertices + index] = vertices[m_CountVertices + split.Remap[index]];
+			vertices[m_CountVertices + index].Tangent = split.Tangents[index];
+		}
+
+		// Replaces Assimp's cache locality step: triangle order for the post-transform cache and overdraw,
+		// then vertex order for fetch, which also drops vertices no triangle references
+		auto const meshVertices = std::span<Vertex>{ vertices }.subspan(m_CountVertices);
+		auto const meshIndices  = std::span<uint32_t>{ indices }.subspan(m_CountIndexes);
+		auto const cache    = Geometry::OptimizeVertexCache(meshVertices, meshIndices);
+		auto const overdraw = Geometry::OptimizeOverdraw(meshVertices, meshIndices);
+		auto const fetch    = Geometry::OptimizeVertexFetch(meshVertices, meshIndices);
+		vertices.resize(m_CountVertices + fetch.After.CountVertices);
+		accumulate(before, cache.Before);
+		accumulate(after, fetch.After);
 		
-		Mesh mesh;
-		mesh.IndexMaterial = pScene->mMeshes[indexMesh]->mMaterialIndex;
-		mesh.CountIndexes = 3 * pScene->mMeshes[indexMesh]->mNumFaces;
-		mesh.Offset     = m_CountIndexes;
-		mesh.VertexBase = m_CountVertices;
-		m_Meshes.push_back(mesh);
-
-		m_CountVertices += pScene->mMeshes[indexMesh]->mNumVertices;
+		// Sub-meshes address at most 65536 vertices each, so every index is 16-bit; a larger mesh is cut in
+		// triangle order and only the vertices shared across a cut are copied
+		auto const parts = Geometry::SplitFor16BitIndices(meshIndices, static_cast<uint32_t>(fetch.After.CountVertices));
+		vertices.resize(m_CountVertices + parts.Remap.size());
+		for (auto index = parts.Remap.size(); index-- > 0;)
+			vertices[m_CountVertices + index] = vertices[m_CountVertices + parts.Remap[index]];
+		countSubMeshes += parts.SubMeshes.size();
+
+		// Cuts are borders to the simplifier, so they are pinned to keep the sub-meshes of one mesh watertight
+		auto lodOptions = Geometry::LodOptions{};
+		lodOptions.Simplify.LockBorder = parts.SubMeshes.size() > 1;
+
+		for (auto const& part : parts.SubMeshes) {
+			auto const vertexBase = m_CountVertices + part.VertexBase;
+			auto const indexBase  = m_CountIndexes + part.FirstIndex;
+
+			// Levels past the first index the same vertices, so they only add indices; each gets its own cache pass
+			auto const lodVertices = std::span<Vertex const>{ vertices }.subspan(vertexBase, part.CountVertices);
+			auto const chain = Geometry::GenerateLodChain(lodVertices, std::span<uint32_t const>{ indices }.subspan(indexBase, part.CountIndices), lodOptions, &scheduler);
+
+			Mesh mesh;
+			mesh.IndexMaterial = pScene->mMeshes[indexMesh]->mMaterialIndex;
+			mesh.VertexBase    = vertexBase;
+			mesh.CountVertices = part.CountVertices;
+			mesh.Lods.PushBack(MeshLod{ chain.Levels[0].CountIndices, indexBase, 0.0f });
+			for (auto level = size_t{ 1 }; level < chain.Levels.size(); level++) {
+				auto const& source = chain.Levels[level];
+				auto const offset = lodIndices.size();
+				lodIndices.insert(lodIndices.end(), chain.Indices.begin() + source.FirstIndex, chain.Indices.begin() + source.FirstIndex + source.CountIndices);
+				static_cast<void>(Geometry::OptimizeVertexCache(std::span<Vertex>{ vertices }.subspan(vertexBase, part.CountVertices), std::span<uint32_t>{ lodIndices }.subspan(offset)));
+				mesh.Lods.PushBack(MeshLod{ source.CountIndices, static_cast<uint32_t>(offset), source.Error });
+			}
+			countLevels += chain.Levels.size();
+
+			// Level 0 is drawn meshlet by meshlet, so its triangles are regrouped in meshlet order in place
+			auto const meshlets = Geometry::BuildMeshlets(lodVertices, std::span<uint32_t const>{ indices }.subspan(indexBase, part.CountIndices), {}, &scheduler);
+			mesh.FirstMeshlet  = static_cast<uint32_t>(m_MeshletRanges.size());
+			mesh.CountMeshlets = static_cast<uint32_t>(meshlets.Meshlets.size());
+			for (auto const& meshlet : meshlets.Meshlets) {
+				m_MeshletRanges.push_back(MeshletRange{ 3 * meshlet.TriangleOffset, 3 * meshlet.CountTriangles });
+				for (auto index = 3 * meshlet.TriangleOffset; index < 3 * (meshlet.TriangleOffset + meshlet.CountTriangles); index++)
+					indices[indexBase + index] = meshlets.Vertices[meshlet.VertexOffset + meshlets.Triangles[index]];
+			}
+			m_MeshletBounds.insert(m_MeshletBounds.end(), meshlets.Bounds.begin(), meshlets.Bounds.end());
+
+			auto minimum = lodVertices[0].Position;
+			auto maximum = lodVertices[0].Position;
+			for (auto const& vertex : lodVertices) {
+				minimum = Math::Vec3{ (std::min)(minimum.x, vertex.Position.x), (std::min)(minimum.y, vertex.Position.y), (std::min)(minimum.z, vertex.Position.z) };
+				maximum = Math::Vec3{ (std::max)(maximum.x, vertex.Position.x), (std::max)(maximum.y, vertex.Position.y), (std::max)(maximum.z, vertex.Position.z) };
+			}
+			mesh.Center = (minimum + maximum) * 0.5f;
+			mesh.Radius = 0.0f;
+			for (auto const& vertex : lodVertices)
+				mesh.Radius = (std::max)(mesh.Radius, Math::Distance(vertex.Position, mesh.Center));
+			m_Meshes.push_back(mesh);
+		}
+
+		m_CountVertices += static_cast<uint32_t>(parts.Remap.size());
 		m_CountIndexes  += pScene->mMeshes[indexMesh]->mNumFaces * 3;
 			
 	}
+	HAWK_LOG_INFO(Asset, "{}: welded {} vertices into {}, {} KB saved", filename, countImported, countWelded, bytesWelded / 1024);
+	HAWK_LOG_INFO(Asset, "{}: ACMR {:.3} -> {:.3}, ATVR {:.3} -> {:.3}, vertex fetch {} KB -> {} KB", filename,
+		static_cast<F32>(before.Cache.CountTransformed) / std::max<size_t>(before.CountTriangles, 1), static_cast<F32>(after.Cache.CountTransformed) / std::max<size_t>(after.CountTriangles, 1),
+		static_cast<F32>(before.Cache.CountTransformed) / std::max<size_t>(before.CountVertices, 1), static_cast<F32>(after.Cache.CountTransformed) / std::max<size_t>(after.CountVertices, 1),
+		before.Fetch.BytesFetched / 1024, after.Fetch.BytesFetched / 1024);
+	HAWK_LOG_INFO(Asset, "{}: {} meshes in {} 16-bit sub-meshes", filename, pScene->mNumMeshes, countSubMeshes);
+	HAWK_LOG_INFO(Asset, "{}: {} LOD levels over {} meshes, {} KB of simplified indices", filename, countLevels, m_Meshes.size(), lodIndices.size() * sizeof(uint32_t) / 1024);
+	HAWK_LOG_INFO(Asset, "{}: {} meshlets, {:.3} triangles each", filename, m_MeshletRanges.size(), static_cast<F32>(m_CountIndexes / 3) / std::max<size_t>(m_MeshletRanges.size(), 1));
+
+	// One set of bounds for the whole model, so the dequantize transform folds into the object matrices
+	auto const quantization = Geometry::ComputeQuantizationBounds(vertices);
+	std::vector<Geometry::QuantizedVertex> quantized(vertices.size());
+	Geometry::EncodeVertices(vertices, quantized, quantization, &scheduler);
+	m_Dequantize = Math::Translate(quantization.Offset) * Math::Scale(quantization.Scale);
+
+	auto const error = Geometry::MeasureQuantization(vertices, quantized, quantization);
+	HAWK_LOG_INFO(Asset, "{}: quantized vertices {} KB -> {} KB, error position {:.3}, normal {:.3} deg, tangent {:.3} deg, texcoord {:.3}", filename,
+		error.BytesBefore / 1024, error.BytesAfter / 1024, error.MaxPositionError, error.MaxNormalError, error.MaxTangentError, error.MaxTexcoordError);
 
 	
 
 
 
 
-	{
-		Microsoft::WRL::ComPtr<ID3D12Resource> pUploadBuffer;
+	scheduler.Wait(textureReads);
+
+	DirectX::ResourceUploadBatch resourceUpload{ device.Get() };
+	resourceUpload.Begin();
+	for (auto index = 0u; index < textureFiles.size(); index++) {
+		auto const& data = textureFiles[index].Result();
+		DX::ThrowIfFailed(DirectX::CreateDDSTextureFromMemory(device.Get(), resourceUpload, data.data(), data.size(), textureTargets[index]->ReleaseAndGetAddressOf()));
+	}
+	auto textureUpload = resourceUpload.End(context.GetCmdQueue());
+	textureFiles.clear();
+
+	for (auto const& [texture, index] : textureAliases)
+		*texture = *textureTargets[index];
+
+	for (auto indexMaterial = 0u; indexMaterial < pScene->mNumMaterials; indexMaterial++) {
+		auto& material = m_Materials[indexMaterial + 1];
+
+		if (!material.TexDiffuse)
+			material.TexDiffuse = materialDefault.TexDiffuse;
+		if (!material.TexSpecular)
+			material.TexSpecular = materialDefault.TexSpecular;
+		if (!material.TexNormal)
+			material.TexNormal = materialDefault.TexNormal;
+
+		m_SRVs.push_back(heap.GenerateHandle());
+		m_SRVs.push_back(heap.GenerateHandle());
+		m_SRVs.push_back(heap.GenerateHandle());
+
+		DirectX::CreateShaderResourceView(device.Get(), material.TexDiffuse.Get(),  m_SRVs[3 * indexMaterial + 0].CPU);
+		DirectX::CreateShaderResourceView(device.Get(), material.TexSpecular.Get(), m_SRVs[3 * indexMaterial + 1].CPU);
+		DirectX::CreateShaderResourceView(device.Get(), material.TexNormal.Get(),   m_SRVs[3 * indexMaterial + 2].CPU);
+	}
+
+
+	// Vertex and index copies share one command list; the staging buffers are retired instead of waited on
+	Microsoft::WRL::ComPtr<ID3D12Resource> pUploadVertices;
+	Microsoft::WRL::ComPtr<ID3D12Resource> pUploadIndices;
+	Microsoft::WRL::ComPtr<ID3D12Resource> pUploadDepthVertices;
+	Microsoft::WRL::ComPtr<ID3D12Resource> pUploadDepthIndices;
 
+	auto const uploadBuffer = [&](Microsoft::WRL::ComPtr<ID3D12Resource>& buffer, Microsoft::WRL::ComPtr<ID3D12Resource>& upload, void const* pSource, size_t size, D3D12_RESOURCE_STATES state) {
 		DX::ThrowIfFailed(device->CreateCommittedResource(
 			&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
 			D3D12_HEAP_FLAG_NONE,
-			&CD3DX12_RESOURCE_DESC::Buffer(vertices.size() * sizeof(Vertex)),
+			&CD3DX12_RESOURCE_DESC::Buffer(size),
+			D3D12_RESOURCE_STATE_COPY_DEST,
+			nullptr,
+			IID_PPV_ARGS(buffer.GetAddressOf())));
+
+		DX::ThrowIfFailed(device->CreateCommittedResource(
+			&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD),
+			D3D12_HEAP_FLAG_NONE,
+			&CD3DX12_RESOURCE_DESC::Buffer(GetRequiredIntermediateSize(buffer.Get(), 0, 1)),
+			D3D12_RESOURCE_STATE_GENERIC_READ,
+			nullptr,
+			IID_PPV_ARGS(upload.GetAddressOf())));
+
+		D3D12_SUBRESOURCE_DATA pData = {};
+		pData.pData = pSource;
+		pData.RowPitch = size;
+		pData.SlicePitch = size;
+
+		UpdateSubresources(context.GetCmdList(), buffer.Get(), upload.Get(), 0, 0, 1, &pData);
+		context.GetCmdList()->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(buffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST, state));
+	};
+
+	{
+		DX::ThrowIfFailed(device->CreateCommittedResource(
+			&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
+			D3D12_HEAP_FLAG_NONE,
+			&CD3DX12_RESOURCE_DESC::Buffer(quantized.size() * sizeof(Geometry::QuantizedVertex)),
 			D3D12_RESOURCE_STATE_COPY_DEST,
 			nullptr,
 			IID_PPV_ARGS(m_VertexBuffer.GetAddressOf())));
@@ -1208,24 +1570,20 @@ Model::Model(Microsoft::WRL::ComPtr<ID3D12Device> device, CommandContext& contex
 			&CD3DX12_RESOURCE_DESC::Buffer(GetRequiredIntermediateSize(m_VertexBuffer.Get(), 0, 1)),
 			D3D12_RESOURCE_STATE_GENERIC_READ,
 			nullptr,
-			IID_PPV_ARGS(pUploadBuffer.GetAddressOf())));
+			IID_PPV_ARGS(pUploadVertices.GetAddressOf())));
 
 
 		D3D12_SUBRESOURCE_DATA pData = {};
-		pData.pData = vertices.data();
-		pData.RowPitch = sizeof(Vertex) * vertices.size();
-		pData.SlicePitch = sizeof(Vertex) * vertices.size();
+		pData.pData = quantized.data();
+		pData.RowPitch = sizeof(Geometry::QuantizedVertex) * quantized.size();
+		pData.SlicePitch = sizeof(Geometry::QuantizedVertex) * quantized.size();
 
-	//	context.ResetCmdList();
-		UpdateSubresources(context.GetCmdList(), m_VertexBuffer.Get(), pUploadBuffer.Get(), 0, 0, 1, &pData);
+		UpdateSubresources(context.GetCmdList(), m_VertexBuffer.Get(), pUploadVertices.Get(), 0, 0, 1, &pData);
 		context.GetCmdList()->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(m_VertexBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER));
-		context.CloseCmdList();
-		context.ExecuteCmdList();
-		context.WaitForGPU();
 
 		m_VBV.BufferLocation = m_VertexBuffer->GetGPUVirtualAddress();
-		m_VBV.StrideInBytes  = sizeof(Vertex);
-		m_VBV.SizeInBytes    = static_cast<uint32_t>(sizeof(Vertex) * vertices.size());
+		m_VBV.StrideInBytes  = sizeof(Geometry::QuantizedVertex);
+		m_VBV.SizeInBytes    = static_cast<uint32_t>(sizeof(Geometry::QuantizedVertex) * quantized.size());
 
 	}
 
@@ -1236,23 +1594,30 @@ Model::Model(Microsoft::WRL::ComPtr<ID3D12Device> device, CommandContext& contex
 
 		std::sort(m_Meshes.begin(), m_Meshes.end(), [](auto const& x, auto const& y) { return  x.IndexMaterial < y.IndexMaterial;  });
 
-		std::vector<uint32_t> optimazeIndices;
+		// Level 0 still points into the imported indices, coarser levels into the simplified ones
+		auto countOptimized = size_t{ 0 };
+		for (auto const& e : m_Meshes)
+			for (auto const& lod : e.Lods)
+				countOptimized += lod.CountIndexes;
+
+		// Indices are local to their sub-mesh, so all of them narrow to 16 bits
+		std::vector<uint16_t> optimazeIndices(countOptimized);
+		auto countNarrowed = uint32_t{ 0 };
 		for (auto& e : m_Meshes) {
-			auto index  = e.Offset;
-			auto count  = e.CountIndexes;
-			auto offset = index + count;
-			e.Offset = static_cast<uint32_t>(optimazeIndices.size());
-			for (; index < offset; index++)
-				optimazeIndices.push_back(indices[index]);
+			for (auto level = size_t{ 0 }; level < e.Lods.Size(); level++) {
+				auto& lod = e.Lods[level];
+				auto const* pSource = level == 0 ? indices.data() : lodIndices.data();
+				Geometry::NarrowIndices(std::span<uint32_t const>{ pSource + lod.Offset, lod.CountIndexes }, std::span<uint16_t>{ optimazeIndices }.subspan(countNarrowed));
+				lod.Offset = countNarrowed;
+				countNarrowed += lod.CountIndexes;
+			}
 		}
 
 
-		Microsoft::WRL::ComPtr<ID3D12Resource>  pUploadBuffer;
-
 		DX::ThrowIfFailed(device->CreateCommittedResource(
 			&CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_DEFAULT),
 			D3D12_HEAP_FLAG_NONE,
-			&CD3DX12_RESOURCE_DESC::Buffer(indices.size() * sizeof(uint32_t)),
+			&CD3DX12_RESOURCE_DESC::Buffer(optimazeIndices.size() * sizeof(uint16_t)),
 			D3D12_RESOURCE_STATE_COPY_DEST,
 			nullptr,
 			IID_PPV_ARGS(m_IndexBuffer.GetAddressOf())));
@@ -1263,45 +1628,139 @@ Model::Model(Microsoft::WRL::ComPtr<ID3D12Device> device, CommandContext& contex
 			&CD3DX12_RESOURCE_DESC::Buffer(GetRequiredIntermediateSize(m_IndexBuffer.Get(), 0, 1)),
 			D3D12_RESOURCE_STATE_GENERIC_READ,
 			nullptr,
-			IID_PPV_ARGS(pUploadBuffer.GetAddressOf())));
+			IID_PPV_ARGS(pUploadIndices.GetAddressOf())));
 
 		D3D12_SUBRESOURCE_DATA pData = {};
 		pData.pData = optimazeIndices.data();
-		pData.RowPitch = optimazeIndices.size() * sizeof(uint32_t);
-		pData.SlicePitch = optimazeIndices.size() * sizeof(uint32_t);
+		pData.RowPitch = optimazeIndices.size() * sizeof(uint16_t);
+		pData.SlicePitch = optimazeIndices.size() * sizeof(uint16_t);
 
 
-		context.ResetCmdList();
-		UpdateSubresources(context.GetCmdList(), m_IndexBuffer.Get(), pUploadBuffer.Get(), 0, 0, 1, &pData);
+		UpdateSubresources(context.GetCmdList(), m_IndexBuffer.Get(), pUploadIndices.Get(), 0, 0, 1, &pData);
 		context.GetCmdList()->ResourceBarrier(1, &CD3DX12_RESOURCE_BARRIER::Transition(m_IndexBuffer.Get(), D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_INDEX_BUFFER));
-		context.CloseCmdList();
-		context.ExecuteCmdList();
-		context.WaitForGPU();
 
 		m_IBV.BufferLocation = m_IndexBuffer->GetGPUVirtualAddress();
-		m_IBV.Format = DXGI_FORMAT_R32_UINT;
-		m_IBV.SizeInBytes = static_cast<uint32_t>(optimazeIndices.size() * sizeof(uint32_t));
+		m_IBV.Format = DXGI_FORMAT_R16_UINT;
+		m_IBV.SizeInBytes = static_cast<uint32_t>(optimazeIndices.size() * sizeof(uint16_t));
+
+		// Depth passes fetch 8-byte positions with seams collapsed. The depth indices mirror the full ones level
+		// by level, so both passes pick the same LOD and meshlets and every corner is checked to land on the same position
+		std::vector<Geometry::QuantizedPosition> depthVertices;
+		std::vector<uint16_t>                    depthIndices(optimazeIndices.size());
+		auto countMismatches = size_t{ 0 };
+		for (auto& e : m_Meshes) {
+			auto const meshVertices = std::span<Geometry::QuantizedVertex const>{ quantized }.subspan(e.VertexBase, e.CountVertices);
+			auto const stream = Geometry::BuildPositionStream(meshVertices);
+			e.DepthVertexBase = static_cast<uint32_t>(depthVertices.size());
+			depthVertices.insert(depthVertices.end(), stream.Positions.begin(), stream.Positions.end());
+
+			for (auto const& lod : e.Lods) {
+				auto const source = std::span<uint16_t const>{ optimazeIndices }.subspan(lod.Offset, lod.CountIndexes);
+				auto const target = std::span<uint16_t>{ depthIndices }.subspan(lod.Offset, lod.CountIndexes);
+				Geometry::RemapPositionIndices(source, stream, target);
+				countMismatches += Geometry::ValidatePositionStream(meshVertices, source, std::span<Geometry::QuantizedPosition const>{ stream.Positions }, std::span<uint16_t const>{ target });
+			}
+		}
+		if (countMismatches > 0)
+			throw std::runtime_error("Depth stream doesn't match the vertex stream: " + filename);
+
+		uploadBuffer(m_DepthVertexBuffer, pUploadDepthVertices, depthVertices.data(), depthVertices.size() * sizeof(Geometry::QuantizedPosition), D3D12_RESOURCE_STATE_VERTEX_AND_CONSTANT_BUFFER);
+		uploadBuffer(m_DepthIndexBuffer, pUploadDepthIndices, depthIndices.data(), depthIndices.size() * sizeof(uint16_t), D3D12_RESOURCE_STATE_INDEX_BUFFER);
 
+		m_DepthVBV.BufferLocation = m_DepthVertexBuffer->GetGPUVirtualAddress();
+		m_DepthVBV.StrideInBytes  = sizeof(Geometry::QuantizedPosition);
+		m_DepthVBV.SizeInBytes    = static_cast<uint32_t>(sizeof(Geometry::QuantizedPosition) * depthVertices.size());
+
+		m_DepthIBV.BufferLocation = m_DepthIndexBuffer->GetGPUVirtualAddress();
+		m_DepthIBV.Format = DXGI_FORMAT_R16_UINT;
+		m_DepthIBV.SizeInBytes = static_cast<uint32_t>(depthIndices.size() * sizeof(uint16_t));
+
+		HAWK_LOG_INFO(Asset, "{}: depth stream {} positions for {} vertices, {} KB -> {} KB", filename, depthVertices.size(), quantized.size(),
+			quantized.size() * sizeof(Geometry::QuantizedVertex) / 1024, depthVertices.size() * sizeof(Geometry::QuantizedPosition) / 1024);
 
 	}
 
+	context.CloseCmdList();
+	context.ExecuteCmdList();
+
+	// The texture batch was submitted to the same queue first, so this fence value covers it as well
+	auto const fenceUpload = context.Signal();
+	deletionQueue.Retire(fenceUpload, std::move(pUploadVertices));
+	deletionQueue.Retire(fenceUpload, std::move(pUploadIndices));
+	deletionQueue.Retire(fenceUpload, std::move(pUploadDepthVertices));
+	deletionQueue.Retire(fenceUpload, std::move(pUploadDepthIndices));
+	deletionQueue.Retire(fenceUpload, std::move(textureUpload));
+
+
 	
 
 }
 
-auto Model::Draw(CommandContext& context) const noexcept -> void {
+auto Model::Draw(CommandContext& context, Geometry::Frustum const& frustum, Math::Vec3 const& viewPosition, F32 lodScale) const noexcept -> void {
 
 	ID3D12GraphicsCommandList* pCommandList = context.GetCmdList();	
 	pCommandList->IASetVertexBuffers(0, 1, &m_VBV);
 	pCommandList->IASetIndexBuffer(&m_IBV);
 	pCommandList->SetGraphicsRootDescriptorTable(3, m_SRVs[0].GPU);
+	DrawMeshes(pCommandList, frustum, viewPosition, lodScale, false);
+
+}
+
+auto Model::DrawDepth(CommandContext& context, Geometry::Frustum const& frustum, Math::Vec3 const& viewPosition, F32 lodScale) const noexcept -> void {
 
+	ID3D12GraphicsCommandList* pCommandList = context.GetCmdList();
+	pCommandList->IASetVertexBuffers(0, 1, &m_DepthVBV);
+	pCommandList->IASetIndexBuffer(&m_DepthIBV);
+	DrawMeshes(pCommandList, frustum, viewPosition, lodScale, true);
+
+}
+
+// Both passes must select the same triangles, or the G-buffer pass fails the depth test against the prepass
+auto Model::DrawMeshes(ID3D12GraphicsCommandList* pCommandList, Geometry::Frustum const& frustum, Math::Vec3 const& viewPosition, F32 lodScale, bool isDepth) const noexcept -> void {
+
+	// The coarsest level whose error projects to at most a pixel from the nearest point of the bounding sphere
 	for (auto const& e : m_Meshes) {
-		pCommandList->SetGraphicsRoot32BitConstant(0, e.IndexMaterial, 0);
-		pCommandList->DrawIndexedInstanced(e.CountIndexes, 1, e.Offset, e.VertexBase, 0);
+		if (!Geometry::IsSphereVisible(frustum, e.Center, e.Radius))
+			continue;
+
+		auto const distance = (std::max)(Math::Distance(viewPosition, e.Center) - e.Radius, 0.1f);
+		auto level = e.Lods.Size() - 1;
+		while (level > 0 && e.Lods[level].Error * lodScale > distance)
+			level--;
+
+		auto const vertexBase = static_cast<int32_t>(isDepth ? e.DepthVertexBase : e.VertexBase);
+		if (!isDepth)
+			pCommandList->SetGraphicsRoot32BitConstant(0, e.IndexMaterial, 0);
+		if (level > 0) {
+			pCommandList->DrawIndexedInstanced(e.Lods[level].CountIndexes, 1, e.Lods[level].Offset, vertexBase, 0);
+			continue;
+		}
+
+		// Full detail is culled per meshlet; neighbouring survivors are contiguous and go out as one draw
+		auto runFirst = uint32_t{ 0 };
+		auto runCount = uint32_t{ 0 };
+		for (auto index = e.FirstMeshlet; index < e.FirstMeshlet + e.CountMeshlets; index++) {
+			if (!Geometry::IsMeshletVisible(m_MeshletBounds[index], frustum, viewPosition))
+				continue;
+			auto const& range = m_MeshletRanges[index];
+			if (runCount > 0 && runFirst + runCount == range.FirstIndex) {
+				runCount += range.CountIndexes;
+				continue;
+			}
+			if (runCount > 0)
+				pCommandList->DrawIndexedInstanced(runCount, 1, e.Lods[0].Offset + runFirst, vertexBase, 0);
+			runFirst = range.FirstIndex;
+			runCount = range.CountIndexes;
+		}
+		if (runCount > 0)
+			pCommandList->DrawIndexedInstanced(runCount, 1, e.Lods[0].Offset + runFirst, vertexBase, 0);
 	}
 
 }
 
+auto Model::GetDequantize() const noexcept -> Math::Mat4x4 const& {
+	return m_Dequantize;
+}
+
 
 
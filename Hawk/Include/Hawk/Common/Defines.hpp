@@ -9,6 +9,8 @@
 
 #define ILINE inline
 
+#define HAWK_CACHE_LINE_SIZE 64
+
 using F32 = float;
 using F64 = double;
 
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "./Defines.hpp"
+#include "./Jobs.hpp"
+#include "./Task.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/Jobs.hpp>
+//#include <Hawk/Common/Task.hpp>
+
+namespace Hawk {
+	namespace File {
+
+		auto Read(std::string const& filename) -> std::vector<U8>;
+		auto ReadAsync(Jobs::Scheduler& scheduler, std::string filename) -> Task<std::vector<U8>>;
+
+	}
+}
+
+namespace Hawk {
+	namespace File {
+
+		[[nodiscard]] ILINE auto Read(std::string const& filename) -> std::vector<U8> {
+			auto file = std::ifstream{ filename, std::ios::binary | std::ios::ate };
+			if (!file)
+				throw std::runtime_error("Can't open file: " + filename);
+
+			auto const size = static_cast<size_t>(file.tellg());
+			auto data = std::vector<U8>(size);
+			file.seekg(0, std::ios::beg);
+			if (!file.read(reinterpret_cast<char*>(data.data()), size))
+				throw std::runtime_error("Can't read file: " + filename);
+			return data;
+		}
+
+		// The filename is taken by value: the coroutine frame must own it across the hop to the pool
+		[[nodiscard]] ILINE auto ReadAsync(Jobs::Scheduler& scheduler, std::string filename) -> Task<std::vector<U8>> {
+			co_await ScheduleOn(scheduler);
+			co_return Read(filename);
+		}
+
+	}
+}
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <chrono>
+
+#include "./Defines.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+
+namespace Hawk {
+
+	// Accumulates wall-clock time and hands it out as whole simulation steps of a fixed length.
+	// The remainder is exposed as an interpolation factor between the last two simulated states.
+	class FixedTimestep {
+	public:
+		using Clock    = std::chrono::steady_clock;
+		using Duration = std::chrono::nanoseconds;
+
+		FixedTimestep(F64 stepSeconds, U32 maxStepsPerFrame = 8) noexcept;
+
+		auto Advance()                  noexcept->U32;
+		auto Advance(Duration elapsed)  noexcept->U32;
+		auto Reset()                    noexcept->void;
+
+		auto Alpha()         const noexcept->F32;
+		auto StepSeconds()   const noexcept->F32;
+		auto StepCount()     const noexcept->U64;
+
+	private:
+		Clock::time_point m_LastTime;
+		Duration          m_Step;
+		Duration          m_Accumulator;
+		U64               m_StepCount;
+		U32               m_MaxStepsPerFrame;
+	};
+
+}
+
+namespace Hawk {
+
+	ILINE FixedTimestep::FixedTimestep(F64 stepSeconds, U32 maxStepsPerFrame) noexcept
+		: m_LastTime(Clock::now())
+		, m_Step(std::chrono::duration_cast<Duration>(std::chrono::duration<F64>(stepSeconds)))
+		, m_Accumulator(Duration::zero())
+		, m_StepCount(0)
+		, m_MaxStepsPerFrame(maxStepsPerFrame) {
+		assert(m_Step > Duration::zero());
+		assert(m_MaxStepsPerFrame > 0);
+	}
+
+	ILINE auto FixedTimestep::Advance() noexcept -> U32 {
+		auto const time = Clock::now();
+		auto const elapsed = std::chrono::duration_cast<Duration>(time - m_LastTime);
+		m_LastTime = time;
+		return this->Advance(elapsed);
+	}
+
+	ILINE auto FixedTimestep::Advance(Duration elapsed) noexcept -> U32 {
+		m_Accumulator += elapsed;
+
+		auto countSteps = static_cast<U32>(0);
+		while (m_Accumulator >= m_Step && countSteps < m_MaxStepsPerFrame) {
+			m_Accumulator -= m_Step;
+			countSteps++;
+		}
+
+		// After a long stall (debugger, window drag) drop the backlog instead of trying to catch up
+		if (m_Accumulator >= m_Step)
+			m_Accumulator = m_Accumulator % m_Step;
+
+		m_StepCount += countSteps;
+		return countSteps;
+	}
+
+	ILINE auto FixedTimestep::Reset() noexcept -> void {
+		m_LastTime = Clock::now();
+		m_Accumulator = Duration::zero();
+	}
+
+	[[nodiscard]] ILINE auto FixedTimestep::Alpha() const noexcept -> F32 {
+		return static_cast<F32>(static_cast<F64>(m_Accumulator.count()) / static_cast<F64>(m_Step.count()));
+	}
+
+	[[nodiscard]] ILINE auto FixedTimestep::StepSeconds() const noexcept -> F32 {
+		return std::chrono::duration<F32>(m_Step).count();
+	}
+
+	[[nodiscard]] ILINE auto FixedTimestep::StepCount() const noexcept -> U64 {
+		return m_StepCount;
+	}
+
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#include "./Defines.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+
+namespace Hawk {
+	namespace Hash {
+
+		auto Bytes(void const* data, size_t size, U64 seed = 0) noexcept -> U64;
+		auto Mix(U64 a, U64 b) noexcept -> U64;
+		auto Integer(U64 value) noexcept -> U64;
+		auto Combine(U64 seed, U64 value) noexcept -> U64;
+
+	}
+
+	// Default hash functor. Strings hash by content and accept any string-like key (is_transparent),
+	// integers, enums and pointers go through a single multiply-mix, and other trivially copyable types with
+	// unique object representations hash their bytes.
+	template<typename T, typename = void>
+	struct Hasher;
+
+	template<typename T>
+	struct Hasher<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>>> {
+		auto operator()(T value) const noexcept -> U64;
+	};
+
+	template<typename T>
+	struct Hasher<T, std::enable_if_t<!std::is_integral_v<T> && !std::is_enum_v<T> && !std::is_pointer_v<T> && std::has_unique_object_representations_v<T>>> {
+		auto operator()(T const& value) const noexcept -> U64;
+	};
+
+	struct StringHasher {
+		using is_transparent = void;
+		auto operator()(std::string_view value) const noexcept -> U64;
+	};
+
+	template<> struct Hasher<std::string>      : StringHasher {};
+	template<> struct Hasher<std::string_view> : StringHasher {};
+
+}
+
+namespace Hawk {
+	namespace Hash {
+
+		namespace Detail {
+
+			constexpr U64 Secret[4] = { 0x2D358DCCAA6C78A5ull, 0x8BB84B93962EACC9ull, 0x4B33A62ED433D4A3ull, 0x4D5A2DA51DE1AA47ull };
+
+			ILINE auto Multiply(U64& a, U64& b) noexcept -> void {
+#if defined(_MSC_VER) && defined(_M_X64)
+				a = _umul128(a, b, &b);
+#elif defined(__SIZEOF_INT128__)
+				auto const r = static_cast<unsigned __int128>(a) * b;
+				a = static_cast<U64>(r);
+				b = static_cast<U64>(r >> 64);
+#else
+				auto const ha = a >> 32, hb = b >> 32, la = static_cast<U32>(a), lb = static_cast<U32>(b);
+				auto const rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+				auto const t = rl + (rm0 << 32);
+				auto const lo = t + (rm1 << 32);
+				auto const hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+				a = lo;
+				b = hi;
+#endif
+			}
+
+			ILINE auto Read8(U8 const* p) noexcept -> U64 {
+				auto value = U64{};
+				std::memcpy(&value, p, sizeof(value));
+				return value;
+			}
+
+			ILINE auto Read4(U8 const* p) noexcept -> U64 {
+				auto value = U32{};
+				std::memcpy(&value, p, sizeof(value));
+				return value;
+			}
+
+			ILINE auto Read3(U8 const* p, size_t k) noexcept -> U64 {
+				return (static_cast<U64>(p[0]) << 16) | (static_cast<U64>(p[k >> 1]) << 8) | p[k - 1];
+			}
+
+		}
+
+		[[nodiscard]] ILINE auto Mix(U64 a, U64 b) noexcept -> U64 {
+			Detail::Multiply(a, b);
+			return a ^ b;
+		}
+
+		// wyhash (final version 4) by Wang Yi, released into the public domain
+		[[nodiscard]] ILINE auto Bytes(void const* data, size_t size, U64 seed) noexcept -> U64 {
+			using namespace Detail;
+
+			auto const* p = static_cast<U8 const*>(data);
+			seed ^= Mix(seed ^ Secret[0], Secret[1]);
+
+			auto a = U64{ 0 };
+			auto b = U64{ 0 };
+			if (size <= 16) {
+				if (size >= 4) {
+					a = (Read4(p) << 32) | Read4(p + ((size >> 3) << 2));
+					b = (Read4(p + size - 4) << 32) | Read4(p + size - 4 - ((size >> 3) << 2));
+				} else if (size > 0) {
+					a = Read3(p, size);
+				}
+			} else {
+				auto i = size;
+				if (i > 48) {
+					auto see1 = seed;
+					auto see2 = seed;
+					do {
+						seed = Mix(Read8(p) ^ Secret[1], Read8(p + 8) ^ seed);
+						see1 = Mix(Read8(p + 16) ^ Secret[2], Read8(p + 24) ^ see1);
+						see2 = Mix(Read8(p + 32) ^ Secret[3], Read8(p + 40) ^ see2);
+						p += 48;
+						i -= 48;
+					} while (i > 48);
+					seed ^= see1 ^ see2;
+				}
+				while (i > 16) {
+					seed = Mix(Read8(p) ^ Secret[1], Read8(p + 8) ^ seed);
+					i -= 16;
+					p += 16;
+				}
+				a = Read8(p + i - 16);
+				b = Read8(p + i - 8);
+			}
+
+			a ^= Secret[1];
+			b ^= seed;
+			Multiply(a, b);
+			return Mix(a ^ Secret[0] ^ size, b ^ Secret[1]);
+		}
+
+		[[nodiscard]] ILINE auto Integer(U64 value) noexcept -> U64 {
+			return Mix(value ^ Detail::Secret[0], Detail::Secret[1]);
+		}
+
+		[[nodiscard]] ILINE auto Combine(U64 seed, U64 value) noexcept -> U64 {
+			return Mix(seed ^ Detail::Secret[2], value ^ Detail::Secret[3]);
+		}
+
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto Hasher<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>>>::operator()(T value) const noexcept -> U64 {
+		if constexpr (std::is_pointer_v<T>)
+			return Hash::Integer(reinterpret_cast<uintptr_t>(value));
+		else
+			return Hash::Integer(static_cast<U64>(value));
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto Hasher<T, std::enable_if_t<!std::is_integral_v<T> && !std::is_enum_v<T> && !std::is_pointer_v<T> && std::has_unique_object_representations_v<T>>>::operator()(T const& value) const noexcept -> U64 {
+		return Hash::Bytes(&value, sizeof(T));
+	}
+
+	[[nodiscard]] ILINE auto StringHasher::operator()(std::string_view value) const noexcept -> U64 {
+		return Hash::Bytes(value.data(), value.size());
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,463 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "./Defines.hpp"
+#include "./MPMCQueue.hpp"
+#include "./NonCopyable.hpp"
+#include "./Thread.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/MPMCQueue.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+//#include <Hawk/Common/Thread.hpp>
+
+namespace Hawk {
+	namespace Jobs {
+
+		class Counter : NonCopyable {
+		public:
+			Counter(U32 value = 0) noexcept;
+			auto Add(U32 value) noexcept -> void;
+			auto Decrement()    noexcept -> bool;
+			auto Value()  const noexcept -> U32;
+			auto IsDone() const noexcept -> bool;
+		private:
+			std::atomic<U32> m_Value;
+		};
+
+		struct alignas(HAWK_CACHE_LINE_SIZE) Job {
+			static constexpr size_t PayloadSize = HAWK_CACHE_LINE_SIZE - sizeof(void(*)(Job&)) - sizeof(Counter*) - alignof(void*);
+
+			void (*Function)(Job&);
+			Counter* Signal;
+			std::atomic<bool> IsInFlight{ false };
+			alignas(alignof(void*)) U8 Payload[PayloadSize];
+		};
+
+		static_assert(sizeof(Job) == HAWK_CACHE_LINE_SIZE, "Job must occupy exactly one cache line");
+
+		namespace Detail {
+
+			// Chase-Lev deque with a fixed ring: the owner pushes and pops at the bottom, thieves steal from the top.
+			class WorkStealingDeque : NonCopyable {
+			public:
+				WorkStealingDeque(U32 capacity);
+				auto Push(Job* job) noexcept -> bool;
+				auto Pop()          noexcept -> Job*;
+				auto Steal()        noexcept -> Job*;
+				auto IsEmpty() const noexcept -> bool;
+			private:
+				alignas(HAWK_CACHE_LINE_SIZE) std::atomic<I64> m_Top;
+				alignas(HAWK_CACHE_LINE_SIZE) std::atomic<I64> m_Bottom;
+				alignas(HAWK_CACHE_LINE_SIZE) std::unique_ptr<std::atomic<Job*>[]> m_Buffer;
+				I64 m_Mask;
+			};
+
+			struct Worker {
+				Worker(U32 capacity);
+
+				WorkStealingDeque      Queue;
+				std::unique_ptr<Job[]> Jobs;
+				U32                    JobIndex;
+				U32                    Random;
+				std::thread            Thread;
+			};
+
+			struct ThreadContext {
+				void const* Owner = nullptr;
+				U32         Index = 0;
+			};
+
+			inline thread_local ThreadContext t_Context;
+
+		}
+
+		class Scheduler : NonCopyable {
+		public:
+			Scheduler(U32 countWorkers = Thread::CountHardwareThreads(), U32 jobCapacity = 4096, bool pinWorkers = true);
+			~Scheduler();
+
+			template<typename F> auto Run(F&& function, Counter* counter = nullptr) noexcept -> void;
+			template<typename F> auto ParallelFor(U32 count, F&& function, U32 grainSize = 0) -> void;
+			auto Wait(Counter const& counter) noexcept -> void;
+
+			auto CountWorkers()      const noexcept -> U32;
+			auto WorkerIndex()       const noexcept -> U32;
+			auto IsWorkerThread()    const noexcept -> bool;
+			auto GrainSize(U32 count) const noexcept -> U32;
+
+		private:
+			auto WorkerMain(U32 index)    noexcept -> void;
+			auto AllocateJob()            noexcept -> Job*;
+			auto Submit(Job* job)         noexcept -> void;
+			auto WakeWorker()             noexcept -> void;
+			auto FindJob(U32 index)       noexcept -> Job*;
+			auto Execute(Job* job)        noexcept -> void;
+			auto HasWork()          const noexcept -> bool;
+
+			std::vector<std::unique_ptr<Detail::Worker>> m_Workers;
+			std::unique_ptr<Job[]>                       m_ExternalJobs;
+			MPMCQueue<U32>                               m_ExternalFree;
+			MPMCQueue<Job*>                              m_ExternalPending;
+			std::atomic<bool>                            m_Running;
+			std::atomic<U32>                             m_CountSleeping;
+			std::mutex                                   m_Mutex;
+			std::condition_variable                      m_WakeCondition;
+			U32                                          m_JobMask;
+		};
+
+	}
+}
+
+namespace Hawk {
+	namespace Jobs {
+
+		ILINE Counter::Counter(U32 value) noexcept : m_Value(value) {}
+
+		ILINE auto Counter::Add(U32 value) noexcept -> void {
+			m_Value.fetch_add(value, std::memory_order_relaxed);
+		}
+
+		ILINE auto Counter::Decrement() noexcept -> bool {
+			return m_Value.fetch_sub(1, std::memory_order_acq_rel) == 1;
+		}
+
+		[[nodiscard]] ILINE auto Counter::Value() const noexcept -> U32 {
+			return m_Value.load(std::memory_order_acquire);
+		}
+
+		[[nodiscard]] ILINE auto Counter::IsDone() const noexcept -> bool {
+			return m_Value.load(std::memory_order_acquire) == 0;
+		}
+
+		namespace Detail {
+
+			ILINE WorkStealingDeque::WorkStealingDeque(U32 capacity)
+				: m_Top(0)
+				, m_Bottom(0)
+				, m_Buffer(std::make_unique<std::atomic<Job*>[]>(capacity))
+				, m_Mask(static_cast<I64>(capacity) - 1) {
+				assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+			}
+
+			ILINE auto WorkStealingDeque::Push(Job* job) noexcept -> bool {
+				auto const bottom = m_Bottom.load(std::memory_order_relaxed);
+				auto const top = m_Top.load(std::memory_order_acquire);
+				if (bottom - top > m_Mask)
+					return false;
+
+				m_Buffer[bottom & m_Mask].store(job, std::memory_order_release);
+				m_Bottom.store(bottom + 1, std::memory_order_release);
+				return true;
+			}
+
+			ILINE auto WorkStealingDeque::Pop() noexcept -> Job* {
+				auto const bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+				m_Bottom.store(bottom, std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				auto top = m_Top.load(std::memory_order_relaxed);
+
+				if (top > bottom) {
+					m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+					return nullptr;
+				}
+
+				auto* job = m_Buffer[bottom & m_Mask].load(std::memory_order_relaxed);
+				if (top == bottom) {
+					if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+						job = nullptr;
+					m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+				}
+				return job;
+			}
+
+			ILINE auto WorkStealingDeque::Steal() noexcept -> Job* {
+				auto top = m_Top.load(std::memory_order_acquire);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				auto const bottom = m_Bottom.load(std::memory_order_acquire);
+
+				if (top >= bottom)
+					return nullptr;
+
+				auto* job = m_Buffer[top & m_Mask].load(std::memory_order_acquire);
+				if (!m_Top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+					return nullptr;
+				return job;
+			}
+
+			[[nodiscard]] ILINE auto WorkStealingDeque::IsEmpty() const noexcept -> bool {
+				return m_Bottom.load(std::memory_order_acquire) <= m_Top.load(std::memory_order_acquire);
+			}
+
+			ILINE Worker::Worker(U32 capacity)
+				: Queue(capacity)
+				, Jobs(std::make_unique<Job[]>(capacity))
+				, JobIndex(0)
+				, Random(0x9E3779B9u ^ capacity) {}
+
+		}
+
+		ILINE Scheduler::Scheduler(U32 countWorkers, U32 jobCapacity, bool pinWorkers)
+			: m_ExternalJobs(std::make_unique<Job[]>(jobCapacity))
+			, m_ExternalFree(jobCapacity)
+			, m_ExternalPending(jobCapacity)
+			, m_Running(true)
+			, m_CountSleeping(0)
+			, m_JobMask(jobCapacity - 1) {
+			assert(countWorkers > 0);
+			assert(jobCapacity > 1 && (jobCapacity & (jobCapacity - 1)) == 0);
+
+			for (auto index = 0u; index < jobCapacity; index++)
+				m_ExternalFree.TryPush(index);
+
+			m_Workers.reserve(countWorkers);
+			for (auto index = 0u; index < countWorkers; index++) {
+				m_Workers.push_back(std::make_unique<Detail::Worker>(jobCapacity));
+				m_Workers.back()->Random += index * 0x85EBCA6Bu;
+			}
+
+			// The constructing thread takes part in the pool as worker 0
+			Detail::t_Context = { this, 0 };
+
+			auto const countCores = Thread::CountHardwareThreads();
+			for (auto index = 1u; index < countWorkers; index++) {
+				auto& thread = m_Workers[index]->Thread;
+				thread = std::thread([this, index]() { this->WorkerMain(index); });
+				Thread::SetName(thread, "Hawk Worker " + std::to_string(index));
+				if (pinWorkers && countWorkers <= countCores)
+					Thread::SetAffinity(thread, index);
+			}
+		}
+
+		ILINE Scheduler::~Scheduler() {
+			m_Running.store(false, std::memory_order_seq_cst);
+			{
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_WakeCondition.notify_all();
+			}
+
+			for (auto& e : m_Workers)
+				if (e->Thread.joinable())
+					e->Thread.join();
+
+			if (Detail::t_Context.Owner == this)
+				Detail::t_Context = {};
+		}
+
+		template<typename F>
+		ILINE auto Scheduler::Run(F&& function, Counter* counter) noexcept -> void {
+			using Functor = std::decay_t<F>;
+			static_assert(sizeof(Functor) <= Job::PayloadSize, "Job functor is too large, capture by reference or pointer");
+			static_assert(alignof(Functor) <= alignof(void*), "Job functor is over-aligned");
+
+			auto* job = this->AllocateJob();
+			if (job == nullptr) {
+				function();
+				return;
+			}
+
+			new (job->Payload) Functor(std::forward<F>(function));
+			job->Function = [](Job& e) {
+				auto* functor = std::launder(reinterpret_cast<Functor*>(e.Payload));
+				(*functor)();
+				functor->~Functor();
+			};
+			job->Signal = counter;
+
+			if (counter)
+				counter->Add(1);
+			this->Submit(job);
+		}
+
+		// Splits [0, count) into ranges and calls function(begin, end) for each of them, returns once all ranges are done.
+		template<typename F>
+		ILINE auto Scheduler::ParallelFor(U32 count, F&& function, U32 grainSize) -> void {
+			if (count == 0)
+				return;
+
+			// Keeps a single call from using up the job ring, past which its ranges would run inline
+			auto const minGrain = (count + m_JobMask / 2) / (m_JobMask / 2 + 1);
+			auto const grain = (std::max)(grainSize > 0 ? grainSize : this->GrainSize(count), minGrain);
+			if (grain >= count) {
+				function(0u, count);
+				return;
+			}
+
+			auto counter = Counter{};
+			auto* pFunction = &function;
+			auto begin = 0u;
+			for (; count - begin > grain; begin += grain)
+				this->Run([pFunction, begin, grain]() { (*pFunction)(begin, begin + grain); }, &counter);
+
+			function(begin, count);
+			this->Wait(counter);
+		}
+
+		ILINE auto Scheduler::Wait(Counter const& counter) noexcept -> void {
+			if (!this->IsWorkerThread()) {
+				while (!counter.IsDone())
+					std::this_thread::yield();
+				return;
+			}
+
+			auto const index = this->WorkerIndex();
+			while (!counter.IsDone()) {
+				if (auto* job = this->FindJob(index))
+					this->Execute(job);
+				else
+					Thread::Pause();
+			}
+		}
+
+		[[nodiscard]] ILINE auto Scheduler::CountWorkers() const noexcept -> U32 {
+			return static_cast<U32>(m_Workers.size());
+		}
+
+		[[nodiscard]] ILINE auto Scheduler::WorkerIndex() const noexcept -> U32 {
+			assert(this->IsWorkerThread());
+			return Detail::t_Context.Index;
+		}
+
+		[[nodiscard]] ILINE auto Scheduler::IsWorkerThread() const noexcept -> bool {
+			return Detail::t_Context.Owner == this;
+		}
+
+		[[nodiscard]] ILINE auto Scheduler::GrainSize(U32 count) const noexcept -> U32 {
+			// A few ranges per worker leaves room for stealing to even out uneven ranges
+			return (std::max)(1u, count / (4 * this->CountWorkers()));
+		}
+
+		ILINE auto Scheduler::WorkerMain(U32 index) noexcept -> void {
+			Detail::t_Context = { this, index };
+
+			auto spins = 0u;
+			while (m_Running.load(std::memory_order_relaxed)) {
+				if (auto* job = this->FindJob(index)) {
+					this->Execute(job);
+					spins = 0;
+					continue;
+				}
+
+				if (++spins < 256) {
+					Thread::Pause();
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(m_Mutex);
+				m_CountSleeping.fetch_add(1, std::memory_order_seq_cst);
+				if (!this->HasWork() && m_Running.load(std::memory_order_relaxed))
+					m_WakeCondition.wait(lock);
+				m_CountSleeping.fetch_sub(1, std::memory_order_relaxed);
+				spins = 0;
+			}
+		}
+
+		// Job slots are recycled round-robin, skipping those still in flight; with all of them in flight there is
+		// no slot and the caller runs the job inline. Threads outside the pool take slots from a shared free list
+		// and wait for one when it runs dry.
+		ILINE auto Scheduler::AllocateJob() noexcept -> Job* {
+			if (!this->IsWorkerThread()) {
+				auto index = 0u;
+				while (!m_ExternalFree.TryPop(index))
+					std::this_thread::yield();
+				return &m_ExternalJobs[index];
+			}
+
+			auto& worker = *m_Workers[this->WorkerIndex()];
+			for (auto attempt = 0u; attempt <= m_JobMask; attempt++) {
+				auto& job = worker.Jobs[worker.JobIndex++ & m_JobMask];
+				if (!job.IsInFlight.load(std::memory_order_acquire)) {
+					job.IsInFlight.store(true, std::memory_order_relaxed);
+					return &job;
+				}
+			}
+			return nullptr;
+		}
+
+		ILINE auto Scheduler::Submit(Job* job) noexcept -> void {
+			if (!this->IsWorkerThread()) {
+				// Never fails: there are no more external slots than pending cells
+				m_ExternalPending.TryPush(job);
+				this->WakeWorker();
+				return;
+			}
+
+			auto& worker = *m_Workers[this->WorkerIndex()];
+			if (!worker.Queue.Push(job)) {
+				this->Execute(job);
+				return;
+			}
+
+			this->WakeWorker();
+		}
+
+		ILINE auto Scheduler::WakeWorker() noexcept -> void {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (m_CountSleeping.load(std::memory_order_relaxed) > 0) {
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				m_WakeCondition.notify_one();
+			}
+		}
+
+		ILINE auto Scheduler::FindJob(U32 index) noexcept -> Job* {
+			auto& worker = *m_Workers[index];
+			if (auto* job = worker.Queue.Pop())
+				return job;
+
+			auto* external = static_cast<Job*>(nullptr);
+			if (m_ExternalPending.TryPop(external))
+				return external;
+
+			auto const countWorkers = this->CountWorkers();
+			worker.Random ^= worker.Random << 13;
+			worker.Random ^= worker.Random >> 17;
+			worker.Random ^= worker.Random << 5;
+
+			auto const offset = worker.Random % countWorkers;
+			for (auto attempt = 0u; attempt < countWorkers; attempt++) {
+				auto const victim = (offset + attempt) % countWorkers;
+				if (victim == index)
+					continue;
+				if (auto* job = m_Workers[victim]->Queue.Steal())
+					return job;
+			}
+			return nullptr;
+		}
+
+		ILINE auto Scheduler::Execute(Job* job) noexcept -> void {
+			auto* signal = job->Signal;
+			job->Function(*job);
+			job->IsInFlight.store(false, std::memory_order_release);
+
+			// Worker slots live in other arrays, so ownership is tested on addresses rather than by pointer difference
+			auto const address = reinterpret_cast<std::uintptr_t>(job);
+			auto const first = reinterpret_cast<std::uintptr_t>(m_ExternalJobs.get());
+			if (address >= first && address - first < (size_t{ m_JobMask } + 1) * sizeof(Job))
+				m_ExternalFree.TryPush(static_cast<U32>((address - first) / sizeof(Job)));
+
+			if (signal)
+				signal->Decrement();
+		}
+
+		[[nodiscard]] ILINE auto Scheduler::HasWork() const noexcept -> bool {
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (!m_ExternalPending.IsEmpty())
+				return true;
+			for (auto const& e : m_Workers)
+				if (!e->Queue.IsEmpty())
+					return true;
+			return false;
+		}
+
+	}
+}
@@ -0,0 +1,750 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <cwchar>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "./Defines.hpp"
+#include "./NonCopyable.hpp"
+#include "./Singleton.hpp"
+#include "./Thread.hpp"
+#include "../Memory/Utility.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+//#include <Hawk/Common/Singleton.hpp>
+//#include <Hawk/Common/Thread.hpp>
+//#include <Hawk/Memory/Utility.hpp>
+
+#if !defined(HAWK_LOG_LEVEL)
+#if defined(_DEBUG)
+#define HAWK_LOG_LEVEL 0
+#else
+#define HAWK_LOG_LEVEL 2
+#endif
+#endif
+
+// Categories are empty types carrying a name and their own threshold, declared once per subsystem:
+//     HAWK_LOG_CATEGORY(Render, Info);
+//     HAWK_LOG_WARNING(Render, "Adapter {} has only {} MB", name, megabytes);
+// Calls below HAWK_LOG_LEVEL or the category threshold compile to nothing, arguments included.
+#define HAWK_LOG_CATEGORY(name, level) \
+	struct name { static constexpr char const* Name = #name; static constexpr ::Hawk::Log::Severity Level = ::Hawk::Log::Severity::level; }
+
+#define HAWK_LOG(category, severity, ...) \
+	do { \
+		if constexpr (::Hawk::Log::IsEnabled<category>(::Hawk::Log::Severity::severity)) { \
+			static constexpr ::Hawk::Log::Site hawkLogSite{ category::Name, __FILE__, __LINE__, ::Hawk::Log::Severity::severity }; \
+			::Hawk::Log::Write(hawkLogSite, __VA_ARGS__); \
+		} \
+	} while (false)
+
+#define HAWK_LOG_TRACE(category, ...)   HAWK_LOG(category, Trace, __VA_ARGS__)
+#define HAWK_LOG_DEBUG(category, ...)   HAWK_LOG(category, Debug, __VA_ARGS__)
+#define HAWK_LOG_INFO(category, ...)    HAWK_LOG(category, Info, __VA_ARGS__)
+#define HAWK_LOG_WARNING(category, ...) HAWK_LOG(category, Warning, __VA_ARGS__)
+#define HAWK_LOG_ERROR(category, ...)   HAWK_LOG(category, Error, __VA_ARGS__)
+#define HAWK_LOG_FATAL(category, ...)   HAWK_LOG(category, Fatal, __VA_ARGS__)
+
+namespace Hawk {
+	namespace Log {
+
+		enum class Severity : U8 {
+			Trace,
+			Debug,
+			Info,
+			Warning,
+			Error,
+			Fatal
+		};
+
+		constexpr auto MinSeverity = static_cast<Severity>(HAWK_LOG_LEVEL);
+
+		HAWK_LOG_CATEGORY(General, Trace);
+
+		// Everything about a call site that is known at compile time; one static instance per HAWK_LOG
+		struct Site {
+			char const* Category;
+			char const* File;
+			U32         Line;
+			Severity    Level;
+		};
+
+		struct Entry {
+			F64              Time;
+			U32              Thread;
+			Site const*      Where;
+			std::string_view Message;
+		};
+
+		class Sink {
+		public:
+			virtual ~Sink() = default;
+			virtual auto Write(Entry const& entry) -> void = 0;
+			virtual auto Flush() -> void {}
+		};
+
+		class ConsoleSink final : public Sink {
+		public:
+			auto Write(Entry const& entry) -> void override;
+			auto Flush() -> void override;
+		private:
+			std::string m_Line;
+		};
+
+		class FileSink final : public Sink {
+		public:
+			FileSink(std::string const& path);
+			auto Write(Entry const& entry) -> void override;
+			auto Flush() -> void override;
+		private:
+			std::ofstream m_Stream;
+			std::string   m_Line;
+		};
+
+		template<typename Category>
+		constexpr auto IsEnabled(Severity severity) noexcept -> bool;
+
+		auto ToString(Severity severity) noexcept -> char const*;
+		auto FormatLine(Entry const& entry, std::string& output) -> void;
+
+		template<typename... Args>
+		auto Write(Site const& site, char const* format, Args const&... args) noexcept -> void;
+
+		namespace Detail {
+
+			enum class ArgumentKind : U8 {
+				End,
+				Bool,
+				Char,
+				Signed,
+				Unsigned,
+				Float,
+				Pointer,
+				String,
+				WideString
+			};
+
+			struct RecordHeader {
+				I64                 Timestamp;
+				Site const*         Where;
+				char const*         Format;
+				ArgumentKind const* Kinds;
+			};
+
+			template<typename T>
+			constexpr auto KindOf() noexcept -> ArgumentKind;
+
+			template<typename... Args>
+			struct KindList {
+				static constexpr ArgumentKind Kinds[] = { KindOf<Args>()..., ArgumentKind::End };
+			};
+
+			template<typename T> auto EncodedSize(T const& value) noexcept -> size_t;
+			template<typename T> auto Encode(U8* cursor, T const& value) noexcept -> U8*;
+
+			auto FormatArguments(char const* format, ArgumentKind const* kinds, U8 const* arguments, std::string& output) -> void;
+			auto AppendUtf8(U8 const* units, U32 count, std::string& output) -> void;
+
+			// Single-producer single-consumer ring of variable-sized records, one per logging thread.
+			// The producer only ever touches its own ring, so a log call costs an encode and two relaxed stores.
+			class ThreadBuffer : NonCopyable {
+			public:
+				ThreadBuffer(U32 capacity, U32 thread);
+
+				auto Reserve(size_t size) noexcept -> U8*;
+				auto Commit() noexcept -> void;
+				auto Front() noexcept -> U8 const*;
+				auto Pop() noexcept -> void;
+				auto IsBacklogged() noexcept -> bool;
+
+				auto Close() noexcept -> void { m_IsClosed.store(true, std::memory_order_release); }
+				auto IsClosed() const noexcept -> bool { return m_IsClosed.load(std::memory_order_acquire); }
+				auto Thread() const noexcept -> U32 { return m_Thread; }
+
+				std::atomic<U64> CountDropped = 0;
+
+			private:
+				static constexpr U32 HeaderSize = 8;
+				static constexpr U32 WrapMarker = 0xFFFFFFFF;
+
+				alignas(HAWK_CACHE_LINE_SIZE) std::atomic<U64> m_Head;
+				U64 m_HeadPending;
+				U64 m_TailCached;
+				alignas(HAWK_CACHE_LINE_SIZE) std::atomic<U64> m_Tail;
+				U64 m_HeadCached;
+				U32 m_SizeFront;
+				alignas(HAWK_CACHE_LINE_SIZE) Memory::AlignedBuffer m_Memory;
+				U64                 m_Capacity;
+				U32                 m_Thread;
+				std::atomic<bool>   m_IsClosed;
+			};
+
+			auto LocalBuffer() -> ThreadBuffer&;
+
+		}
+
+		// Background half of the logger: drains every thread's ring, formats the records, orders them by
+		// timestamp within a pass and hands them to the sinks. Formatting never happens on the calling thread,
+		// and the worker only holds m_Mutex to pick up new rings and sinks, so registering a thread or
+		// requesting a flush never waits on sink I/O.
+		class Logger : public Singleton<Logger> {
+		public:
+			static constexpr U32 ThreadBufferSize = 256 << 10;
+
+			Logger(typename Singleton<Logger>::token);
+			~Logger();
+
+			auto AddSink(std::unique_ptr<Sink> sink) -> void;
+			auto Wake() noexcept -> void;
+			auto Flush() -> void;
+			auto Shutdown() -> void;
+
+		private:
+			friend auto Detail::LocalBuffer() -> Detail::ThreadBuffer&;
+
+			struct Pending {
+				I64         Timestamp;
+				U32         Thread;
+				Site const* Where;
+				size_t      Offset;
+				size_t      Length;
+			};
+
+			auto Register() -> std::shared_ptr<Detail::ThreadBuffer>;
+			auto WorkerMain() -> void;
+			auto Drain(std::vector<std::shared_ptr<Detail::ThreadBuffer>> const& buffers, std::vector<Sink*> const& sinks) -> size_t;
+
+			std::mutex                                         m_Mutex;
+			std::condition_variable                            m_Wake;
+			std::condition_variable                            m_Flushed;
+			std::vector<std::shared_ptr<Detail::ThreadBuffer>> m_Buffers;
+			std::vector<std::unique_ptr<Sink>>                 m_Sinks;
+			std::vector<Pending>                               m_Pending;
+			std::string                                        m_Text;
+			I64                                                m_TimeStart;
+			U64                                                m_FlushRequested;
+			U64                                                m_FlushCompleted;
+			U32                                                m_CountThreads;
+			bool                                               m_IsRunning;
+			std::thread                                        m_Thread;
+		};
+
+	}
+}
+
+namespace Hawk {
+	namespace Log {
+
+		template<typename Category>
+		[[nodiscard]] ILINE constexpr auto IsEnabled(Severity severity) noexcept -> bool {
+			return severity >= MinSeverity && severity >= Category::Level;
+		}
+
+		[[nodiscard]] ILINE auto ToString(Severity severity) noexcept -> char const* {
+			switch (severity) {
+			case Severity::Trace:   return "Trace";
+			case Severity::Debug:   return "Debug";
+			case Severity::Info:    return "Info";
+			case Severity::Warning: return "Warning";
+			case Severity::Error:   return "Error";
+			case Severity::Fatal:   return "Fatal";
+			}
+			return "Unknown";
+		}
+
+		ILINE auto FormatLine(Entry const& entry, std::string& output) -> void {
+			char prefix[128];
+			auto const length = std::snprintf(prefix, sizeof(prefix), "[%12.6f] [%02u] [%-7s] [%s] ", entry.Time, entry.Thread, ToString(entry.Where->Level), entry.Where->Category);
+			output.assign(prefix, (std::min)(static_cast<size_t>((std::max)(length, 0)), sizeof(prefix) - 1));
+			output.append(entry.Message);
+			output.push_back('\n');
+		}
+
+		ILINE auto ConsoleSink::Write(Entry const& entry) -> void {
+			FormatLine(entry, m_Line);
+			std::fwrite(m_Line.data(), 1, m_Line.size(), entry.Where->Level >= Severity::Warning ? stderr : stdout);
+		}
+
+		ILINE auto ConsoleSink::Flush() -> void {
+			std::fflush(stdout);
+			std::fflush(stderr);
+		}
+
+		ILINE FileSink::FileSink(std::string const& path) : m_Stream(path, std::ios::out | std::ios::trunc | std::ios::binary) {}
+
+		ILINE auto FileSink::Write(Entry const& entry) -> void {
+			FormatLine(entry, m_Line);
+			m_Stream.write(m_Line.data(), static_cast<std::streamsize>(m_Line.size()));
+		}
+
+		ILINE auto FileSink::Flush() -> void {
+			m_Stream.flush();
+		}
+
+		// Captures the arguments in binary and returns; format must outlive the logger, which string literals do.
+		// A thread's first call registers its ring, which allocates; if that fails the message is dropped and
+		// the next call tries again.
+		template<typename... Args>
+		ILINE auto Write(Site const& site, char const* format, Args const&... args) noexcept -> void {
+			try {
+				auto& buffer = Detail::LocalBuffer();
+				auto const size = sizeof(Detail::RecordHeader) + (size_t{ 0 } + ... + Detail::EncodedSize(args));
+				auto* cursor = buffer.Reserve(size);
+				if (cursor == nullptr) {
+					buffer.CountDropped.fetch_add(1, std::memory_order_relaxed);
+					return;
+				}
+
+				auto const header = Detail::RecordHeader{
+					std::chrono::steady_clock::now().time_since_epoch().count(),
+					&site,
+					format,
+					Detail::KindList<std::decay_t<Args const>...>::Kinds
+				};
+				std::memcpy(cursor, &header, sizeof(header));
+				cursor += sizeof(header);
+				((cursor = Detail::Encode(cursor, args)), ...);
+				buffer.Commit();
+
+				if (buffer.IsBacklogged())
+					Logger::Instance().Wake();
+				if (site.Level == Severity::Fatal)
+					Logger::Instance().Flush();
+			} catch (...) {}
+		}
+
+		namespace Detail {
+
+			template<typename T>
+			constexpr auto IsNarrowString = std::is_same_v<T, char const*> || std::is_same_v<T, char*> || std::is_same_v<T, std::string> || std::is_same_v<T, std::string_view>;
+
+			template<typename T>
+			constexpr auto IsWideString = std::is_same_v<T, wchar_t const*> || std::is_same_v<T, wchar_t*> || std::is_same_v<T, std::wstring> || std::is_same_v<T, std::wstring_view>;
+
+			template<typename T>
+			[[nodiscard]] ILINE constexpr auto KindOf() noexcept -> ArgumentKind {
+				if constexpr (std::is_same_v<T, bool>)
+					return ArgumentKind::Bool;
+				else if constexpr (std::is_same_v<T, char>)
+					return ArgumentKind::Char;
+				else if constexpr (std::is_enum_v<T>)
+					return std::is_signed_v<std::underlying_type_t<T>> ? ArgumentKind::Signed : ArgumentKind::Unsigned;
+				else if constexpr (std::is_integral_v<T>)
+					return std::is_signed_v<T> ? ArgumentKind::Signed : ArgumentKind::Unsigned;
+				else if constexpr (std::is_floating_point_v<T>)
+					return ArgumentKind::Float;
+				else if constexpr (IsNarrowString<T>)
+					return ArgumentKind::String;
+				else if constexpr (IsWideString<T>)
+					return ArgumentKind::WideString;
+				else if constexpr (std::is_pointer_v<T> || std::is_null_pointer_v<T>)
+					return ArgumentKind::Pointer;
+				else
+					static_assert(std::is_void_v<T>, "Type cannot be logged");
+			}
+
+			template<typename T>
+			[[nodiscard]] ILINE auto TextOf(T const& value) noexcept {
+				using Char = std::conditional_t<IsWideString<T>, wchar_t, char>;
+				if constexpr (std::is_pointer_v<T>)
+					return value != nullptr ? std::basic_string_view<Char>{ value } : std::basic_string_view<Char>{};
+				else
+					return std::basic_string_view<Char>{ value };
+			}
+
+			// Scalars take eight bytes; strings are copied as a 32-bit length followed by their code units
+			template<typename T>
+			[[nodiscard]] ILINE auto EncodedSize(T const& value) noexcept -> size_t {
+				using Type = std::decay_t<T const>;
+				if constexpr (IsNarrowString<Type> || IsWideString<Type>) {
+					auto const text = TextOf<Type>(value);
+					return sizeof(U32) + text.size() * sizeof(text[0]);
+				} else {
+					return sizeof(U64);
+				}
+			}
+
+			template<typename T>
+			ILINE auto Encode(U8* cursor, T const& value) noexcept -> U8* {
+				using Type = std::decay_t<T const>;
+				constexpr auto kind = KindOf<Type>();
+				if constexpr (kind == ArgumentKind::String || kind == ArgumentKind::WideString) {
+					auto const text = TextOf<Type>(value);
+					auto const length = static_cast<U32>(text.size());
+					std::memcpy(cursor, &length, sizeof(length));
+					if (length > 0)
+						std::memcpy(cursor + sizeof(length), text.data(), text.size() * sizeof(text[0]));
+					return cursor + sizeof(length) + text.size() * sizeof(text[0]);
+				} else {
+					auto bits = U64{ 0 };
+					if constexpr (kind == ArgumentKind::Float) {
+						auto const number = static_cast<F64>(value);
+						std::memcpy(&bits, &number, sizeof(number));
+					} else if constexpr (kind == ArgumentKind::Pointer) {
+						bits = reinterpret_cast<uintptr_t>(static_cast<void const*>(value));
+					} else if constexpr (kind == ArgumentKind::Signed) {
+						bits = static_cast<U64>(static_cast<I64>(value));
+					} else {
+						bits = static_cast<U64>(value);
+					}
+					std::memcpy(cursor, &bits, sizeof(bits));
+					return cursor + sizeof(bits);
+				}
+			}
+
+			ILINE auto AppendUtf8(U8 const* units, U32 count, std::string& output) -> void {
+				auto const append = [&](U32 code) {
+					if (code < 0x80) {
+						output.push_back(static_cast<char>(code));
+					} else if (code < 0x800) {
+						output.push_back(static_cast<char>(0xC0 | (code >> 6)));
+						output.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+					} else if (code < 0x10000) {
+						output.push_back(static_cast<char>(0xE0 | (code >> 12)));
+						output.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+						output.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+					} else {
+						output.push_back(static_cast<char>(0xF0 | (code >> 18)));
+						output.push_back(static_cast<char>(0x80 | ((code >> 12) & 0x3F)));
+						output.push_back(static_cast<char>(0x80 | ((code >> 6) & 0x3F)));
+						output.push_back(static_cast<char>(0x80 | (code & 0x3F)));
+					}
+				};
+
+				for (auto index = 0u; index < count; index++) {
+					auto unit = wchar_t{};
+					std::memcpy(&unit, units + index * sizeof(wchar_t), sizeof(wchar_t));
+					auto code = static_cast<U32>(unit);
+					// wchar_t is UTF-16 on Windows; join surrogate pairs and replace lone halves
+					if constexpr (sizeof(wchar_t) == 2) {
+						if (code >= 0xD800 && code < 0xDC00 && index + 1 < count) {
+							auto next = wchar_t{};
+							std::memcpy(&next, units + (index + 1) * sizeof(wchar_t), sizeof(wchar_t));
+							auto const low = static_cast<U32>(next);
+							if (low >= 0xDC00 && low < 0xE000) {
+								code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+								index++;
+							}
+						}
+					}
+					append((code >= 0xD800 && code < 0xE000) || code > 0x10FFFF ? 0xFFFD : code);
+				}
+			}
+
+			// Replaces each {} in order; {:x} and {:X} print integers in hex, {:.N} sets the float precision,
+			// and {{ or }} produce a literal brace
+			ILINE auto FormatArguments(char const* format, ArgumentKind const* kinds, U8 const* arguments, std::string& output) -> void {
+				auto const read = [&]() {
+					auto bits = U64{ 0 };
+					std::memcpy(&bits, arguments, sizeof(bits));
+					arguments += sizeof(bits);
+					return bits;
+				};
+
+				char number[64];
+				for (auto* cursor = format; *cursor != '\0'; cursor++) {
+					if (*cursor == '}' && cursor[1] == '}')
+						cursor++;
+					if (*cursor != '{' || cursor[1] == '{') {
+						output.push_back(*cursor);
+						cursor += *cursor == '{';
+						continue;
+					}
+
+					auto const* end = std::strchr(cursor, '}');
+					if (end == nullptr || *kinds == ArgumentKind::End) {
+						output.append(cursor);
+						return;
+					}
+					auto const spec = std::string_view{ cursor + 1, static_cast<size_t>(end - cursor - 1) };
+					auto const isHex = spec == ":x" || spec == ":X";
+					cursor = end;
+
+					auto length = 0;
+					switch (*kinds++) {
+					case ArgumentKind::Bool:
+						output.append(read() ? "true" : "false");
+						break;
+					case ArgumentKind::Char:
+						output.push_back(static_cast<char>(read()));
+						break;
+					case ArgumentKind::Signed: {
+						auto const value = read();
+						length = isHex ? std::snprintf(number, sizeof(number), spec[1] == 'x' ? "%llx" : "%llX", static_cast<unsigned long long>(value))
+						               : std::snprintf(number, sizeof(number), "%lld", static_cast<long long>(static_cast<I64>(value)));
+						break;
+					}
+					case ArgumentKind::Unsigned: {
+						auto const value = read();
+						length = isHex ? std::snprintf(number, sizeof(number), spec[1] == 'x' ? "%llx" : "%llX", static_cast<unsigned long long>(value))
+						               : std::snprintf(number, sizeof(number), "%llu", static_cast<unsigned long long>(value));
+						break;
+					}
+					case ArgumentKind::Float: {
+						auto const bits = read();
+						auto value = F64{};
+						std::memcpy(&value, &bits, sizeof(value));
+						length = spec.size() > 2 && spec[1] == '.'
+							? std::snprintf(number, sizeof(number), "%.*f", std::atoi(spec.data() + 2), value)
+							: std::snprintf(number, sizeof(number), "%g", value);
+						break;
+					}
+					case ArgumentKind::Pointer:
+						length = std::snprintf(number, sizeof(number), "0x%016llx", static_cast<unsigned long long>(read()));
+						break;
+					case ArgumentKind::String:
+					case ArgumentKind::WideString: {
+						auto count = U32{ 0 };
+						std::memcpy(&count, arguments, sizeof(count));
+						arguments += sizeof(count);
+						if (kinds[-1] == ArgumentKind::String) {
+							output.append(reinterpret_cast<char const*>(arguments), count);
+							arguments += count;
+						} else {
+							AppendUtf8(arguments, count, output);
+							arguments += count * sizeof(wchar_t);
+						}
+						break;
+					}
+					case ArgumentKind::End:
+						break;
+					}
+					output.append(number, (std::min)(static_cast<size_t>((std::max)(length, 0)), sizeof(number) - 1));
+				}
+			}
+
+			ILINE ThreadBuffer::ThreadBuffer(U32 capacity, U32 thread)
+				: m_Head(0)
+				, m_HeadPending(0)
+				, m_TailCached(0)
+				, m_Tail(0)
+				, m_HeadCached(0)
+				, m_SizeFront(0)
+				, m_Memory(Memory::AllocateAligned(capacity))
+				, m_Capacity(capacity)
+				, m_Thread(thread)
+				, m_IsClosed(false) {
+				assert(Memory::IsPowerOfTwo(capacity));
+			}
+
+			// Returns space for size bytes, or nullptr when the consumer has fallen too far behind.
+			// A record that would straddle the end of the ring leaves a wrap marker and starts over at offset zero.
+			[[nodiscard]] ILINE auto ThreadBuffer::Reserve(size_t size) noexcept -> U8* {
+				auto const sizeRecord = Memory::AlignUp(size + HeaderSize, HeaderSize);
+				if (sizeRecord > m_Capacity / 2)
+					return nullptr;
+
+				auto head = m_Head.load(std::memory_order_relaxed);
+				auto const offset = head & (m_Capacity - 1);
+				auto const sizeTail = m_Capacity - offset;
+				auto const sizeNeeded = sizeRecord <= sizeTail ? sizeRecord : sizeTail + sizeRecord;
+
+				if (head + sizeNeeded - m_TailCached > m_Capacity) {
+					m_TailCached = m_Tail.load(std::memory_order_acquire);
+					if (head + sizeNeeded - m_TailCached > m_Capacity)
+						return nullptr;
+				}
+
+				if (sizeRecord > sizeTail) {
+					std::memcpy(m_Memory.get() + offset, &WrapMarker, sizeof(WrapMarker));
+					head += sizeTail;
+				}
+
+				auto const length = static_cast<U32>(sizeRecord);
+				auto* record = m_Memory.get() + (head & (m_Capacity - 1));
+				std::memcpy(record, &length, sizeof(length));
+				m_HeadPending = head + sizeRecord;
+				return record + HeaderSize;
+			}
+
+			ILINE auto ThreadBuffer::Commit() noexcept -> void {
+				m_Head.store(m_HeadPending, std::memory_order_release);
+			}
+
+			[[nodiscard]] ILINE auto ThreadBuffer::Front() noexcept -> U8 const* {
+				auto tail = m_Tail.load(std::memory_order_relaxed);
+				for (;;) {
+					if (tail == m_HeadCached) {
+						m_HeadCached = m_Head.load(std::memory_order_acquire);
+						if (tail == m_HeadCached)
+							return nullptr;
+					}
+
+					auto const offset = tail & (m_Capacity - 1);
+					std::memcpy(&m_SizeFront, m_Memory.get() + offset, sizeof(m_SizeFront));
+					if (m_SizeFront != WrapMarker)
+						return m_Memory.get() + offset + HeaderSize;
+
+					tail += m_Capacity - offset;
+					m_Tail.store(tail, std::memory_order_release);
+				}
+			}
+
+			ILINE auto ThreadBuffer::Pop() noexcept -> void {
+				m_Tail.store(m_Tail.load(std::memory_order_relaxed) + m_SizeFront, std::memory_order_release);
+			}
+
+			// True while the ring is more than half full; only then is the consumer's index read again
+			[[nodiscard]] ILINE auto ThreadBuffer::IsBacklogged() noexcept -> bool {
+				if (m_HeadPending - m_TailCached <= m_Capacity / 2)
+					return false;
+				m_TailCached = m_Tail.load(std::memory_order_acquire);
+				return m_HeadPending - m_TailCached > m_Capacity / 2;
+			}
+
+			struct ThreadBufferHolder {
+				std::shared_ptr<ThreadBuffer> Buffer;
+				~ThreadBufferHolder() {
+					if (Buffer)
+						Buffer->Close();
+				}
+			};
+
+			[[nodiscard]] ILINE auto LocalBuffer() -> ThreadBuffer& {
+				thread_local ThreadBufferHolder holder;
+				if (!holder.Buffer)
+					holder.Buffer = Logger::Instance().Register();
+				return *holder.Buffer;
+			}
+
+		}
+
+		ILINE Logger::Logger(typename Singleton<Logger>::token)
+			: m_TimeStart(std::chrono::steady_clock::now().time_since_epoch().count())
+			, m_FlushRequested(0)
+			, m_FlushCompleted(0)
+			, m_CountThreads(0)
+			, m_IsRunning(true) {
+			m_Thread = std::thread{ [this]() { this->WorkerMain(); } };
+			Thread::SetName(m_Thread, "Hawk Log");
+		}
+
+		ILINE Logger::~Logger() {
+			this->Shutdown();
+		}
+
+		ILINE auto Logger::AddSink(std::unique_ptr<Sink> sink) -> void {
+			std::lock_guard<std::mutex> lock{ m_Mutex };
+			m_Sinks.push_back(std::move(sink));
+		}
+
+		// Cuts the worker's sleep short when a producer's ring is filling up
+		ILINE auto Logger::Wake() noexcept -> void {
+			m_Wake.notify_one();
+		}
+
+		// Blocks until everything logged before the call has reached the sinks and the sinks have flushed
+		ILINE auto Logger::Flush() -> void {
+			std::unique_lock<std::mutex> lock{ m_Mutex };
+			if (!m_IsRunning)
+				return;
+			auto const ticket = ++m_FlushRequested;
+			m_Wake.notify_one();
+			m_Flushed.wait(lock, [&]() { return m_FlushCompleted >= ticket || !m_IsRunning; });
+		}
+
+		ILINE auto Logger::Shutdown() -> void {
+			{
+				std::lock_guard<std::mutex> lock{ m_Mutex };
+				if (!m_IsRunning)
+					return;
+				m_IsRunning = false;
+			}
+			m_Wake.notify_one();
+			m_Thread.join();
+		}
+
+		ILINE auto Logger::Register() -> std::shared_ptr<Detail::ThreadBuffer> {
+			std::lock_guard<std::mutex> lock{ m_Mutex };
+			m_Buffers.push_back(std::make_shared<Detail::ThreadBuffer>(ThreadBufferSize, m_CountThreads++));
+			return m_Buffers.back();
+		}
+
+		// Sinks are only destroyed with the logger, so the worker can keep plain pointers to them between passes.
+		// m_FlushCompleted is only written here, under m_Mutex.
+		ILINE auto Logger::WorkerMain() -> void {
+			auto buffers = std::vector<std::shared_ptr<Detail::ThreadBuffer>>{};
+			auto sinks = std::vector<Sink*>{};
+			std::unique_lock<std::mutex> lock{ m_Mutex };
+			for (;;) {
+				auto const requested = m_FlushRequested;
+				auto const isStopping = !m_IsRunning;
+				auto const isFlushing = requested != m_FlushCompleted || isStopping;
+				buffers = m_Buffers;
+				sinks.clear();
+				for (auto const& sink : m_Sinks)
+					sinks.push_back(sink.get());
+				lock.unlock();
+
+				while (this->Drain(buffers, sinks) > 0) {}
+				if (isFlushing)
+					for (auto* sink : sinks)
+						sink->Flush();
+
+				lock.lock();
+				// A thread's ring is only dropped after it exited and everything it wrote has been read
+				m_Buffers.erase(std::remove_if(m_Buffers.begin(), m_Buffers.end(), [](auto const& buffer) {
+					return buffer->IsClosed() && buffer->Front() == nullptr;
+				}), m_Buffers.end());
+				if (isFlushing) {
+					m_FlushCompleted = requested;
+					m_Flushed.notify_all();
+				}
+				if (isStopping)
+					break;
+				m_Wake.wait_for(lock, std::chrono::milliseconds{ 2 }, [&]() { return !m_IsRunning || m_FlushRequested != m_FlushCompleted; });
+			}
+		}
+
+		// Runs on the worker without m_Mutex: it is the only consumer of every ring and the only user of the
+		// pending list and text
+		ILINE auto Logger::Drain(std::vector<std::shared_ptr<Detail::ThreadBuffer>> const& buffers, std::vector<Sink*> const& sinks) -> size_t {
+			static constexpr auto siteDropped = Site{ "Log", __FILE__, __LINE__, Severity::Warning };
+			static constexpr Detail::ArgumentKind kindsDropped[] = { Detail::ArgumentKind::Unsigned, Detail::ArgumentKind::End };
+
+			m_Pending.clear();
+			m_Text.clear();
+			for (auto const& buffer : buffers) {
+				while (auto const* record = buffer->Front()) {
+					auto header = Detail::RecordHeader{};
+					std::memcpy(&header, record, sizeof(header));
+					auto const offset = m_Text.size();
+					Detail::FormatArguments(header.Format, header.Kinds, record + sizeof(header), m_Text);
+					m_Pending.push_back(Pending{ header.Timestamp, buffer->Thread(), header.Where, offset, m_Text.size() - offset });
+					buffer->Pop();
+				}
+
+				if (auto const dropped = buffer->CountDropped.exchange(0, std::memory_order_relaxed); dropped > 0) {
+					auto const offset = m_Text.size();
+					Detail::FormatArguments("Dropped {} messages, the thread outpaced the logger", kindsDropped, reinterpret_cast<U8 const*>(&dropped), m_Text);
+					m_Pending.push_back(Pending{ std::chrono::steady_clock::now().time_since_epoch().count(), buffer->Thread(), &siteDropped, offset, m_Text.size() - offset });
+				}
+			}
+
+			std::stable_sort(m_Pending.begin(), m_Pending.end(), [](Pending const& lhs, Pending const& rhs) { return lhs.Timestamp < rhs.Timestamp; });
+
+			using Period = std::chrono::steady_clock::period;
+			for (auto const& pending : m_Pending) {
+				auto const time = static_cast<F64>(pending.Timestamp - m_TimeStart) * Period::num / Period::den;
+				auto const entry = Entry{ time, pending.Thread, pending.Where, std::string_view{ m_Text.data() + pending.Offset, pending.Length } };
+				for (auto* sink : sinks)
+					sink->Write(entry);
+			}
+			return m_Pending.size();
+		}
+
+	}
+}
\ No newline at end of file
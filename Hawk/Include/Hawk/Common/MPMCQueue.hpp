@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "./Defines.hpp"
+#include "./NonCopyable.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+
+namespace Hawk {
+
+	// Bounded multi-producer multi-consumer queue after Dmitry Vyukov. Every cell carries a sequence number
+	// that tells producers and consumers whether it is theirs for the current lap, so a claim is one CAS.
+	template<typename T>
+	class MPMCQueue : NonCopyable {
+	public:
+		MPMCQueue(U32 capacity);
+		~MPMCQueue();
+
+		template<typename... Args>
+		auto TryEmplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> bool;
+		auto TryPush(T const& value) noexcept(std::is_nothrow_copy_constructible_v<T>) -> bool;
+		auto TryPush(T&& value)      noexcept(std::is_nothrow_move_constructible_v<T>) -> bool;
+		auto TryPop(T& value)        noexcept(std::is_nothrow_move_assignable_v<T>) -> bool;
+
+		auto IsEmpty()  const noexcept -> bool;
+		auto Capacity() const noexcept -> U32;
+
+	private:
+		struct Cell {
+			std::atomic<U64> Sequence;
+			alignas(T) U8    Data[sizeof(T)];
+		};
+
+		alignas(HAWK_CACHE_LINE_SIZE) std::unique_ptr<Cell[]> m_Cells;
+		U64 m_Mask;
+		alignas(HAWK_CACHE_LINE_SIZE) std::atomic<U64> m_EnqueuePosition;
+		alignas(HAWK_CACHE_LINE_SIZE) std::atomic<U64> m_DequeuePosition;
+	};
+
+}
+
+namespace Hawk {
+
+	template<typename T>
+	ILINE MPMCQueue<T>::MPMCQueue(U32 capacity)
+		: m_Cells(std::make_unique<Cell[]>(capacity))
+		, m_Mask(capacity - 1)
+		, m_EnqueuePosition(0)
+		, m_DequeuePosition(0) {
+		assert(capacity > 1 && (capacity & (capacity - 1)) == 0);
+		for (auto index = 0u; index < capacity; index++)
+			m_Cells[index].Sequence.store(index, std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	ILINE MPMCQueue<T>::~MPMCQueue() {
+		auto const tail = m_EnqueuePosition.load(std::memory_order_relaxed);
+		for (auto index = m_DequeuePosition.load(std::memory_order_relaxed); index != tail; index++)
+			std::launder(reinterpret_cast<T*>(m_Cells[index & m_Mask].Data))->~T();
+	}
+
+	template<typename T>
+	template<typename... Args>
+	ILINE auto MPMCQueue<T>::TryEmplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> bool {
+		auto position = m_EnqueuePosition.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;) {
+			cell = &m_Cells[position & m_Mask];
+			auto const sequence = cell->Sequence.load(std::memory_order_acquire);
+			auto const difference = static_cast<I64>(sequence) - static_cast<I64>(position);
+			if (difference == 0) {
+				if (m_EnqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			} else if (difference < 0) {
+				return false;
+			} else {
+				position = m_EnqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		new (cell->Data) T(std::forward<Args>(args)...);
+		cell->Sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	ILINE auto MPMCQueue<T>::TryPush(T const& value) noexcept(std::is_nothrow_copy_constructible_v<T>) -> bool {
+		return this->TryEmplace(value);
+	}
+
+	template<typename T>
+	ILINE auto MPMCQueue<T>::TryPush(T&& value) noexcept(std::is_nothrow_move_constructible_v<T>) -> bool {
+		return this->TryEmplace(std::move(value));
+	}
+
+	template<typename T>
+	ILINE auto MPMCQueue<T>::TryPop(T& value) noexcept(std::is_nothrow_move_assignable_v<T>) -> bool {
+		auto position = m_DequeuePosition.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;) {
+			cell = &m_Cells[position & m_Mask];
+			auto const sequence = cell->Sequence.load(std::memory_order_acquire);
+			auto const difference = static_cast<I64>(sequence) - static_cast<I64>(position + 1);
+			if (difference == 0) {
+				if (m_DequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+					break;
+			} else if (difference < 0) {
+				return false;
+			} else {
+				position = m_DequeuePosition.load(std::memory_order_relaxed);
+			}
+		}
+
+		auto* element = std::launder(reinterpret_cast<T*>(cell->Data));
+		value = std::move(*element);
+		element->~T();
+		cell->Sequence.store(position + m_Mask + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto MPMCQueue<T>::IsEmpty() const noexcept -> bool {
+		auto const position = m_DequeuePosition.load(std::memory_order_relaxed);
+		auto const sequence = m_Cells[position & m_Mask].Sequence.load(std::memory_order_acquire);
+		return static_cast<I64>(sequence) - static_cast<I64>(position + 1) < 0;
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto MPMCQueue<T>::Capacity() const noexcept -> U32 {
+		return static_cast<U32>(m_Mask + 1);
+	}
+
+}
\ No newline at end of file
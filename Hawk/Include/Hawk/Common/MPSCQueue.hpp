@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+
+#include "./Defines.hpp"
+#include "./NonCopyable.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+
+namespace Hawk {
+
+	struct MPSCNode {
+		std::atomic<MPSCNode*> Next{ nullptr };
+	};
+
+	// Unbounded intrusive multi-producer single-consumer queue after Dmitry Vyukov. Elements derive from MPSCNode
+	// and stay owned by the caller; a push is one exchange, and the queue itself never allocates.
+	// Pop and IsEmpty belong to the single consumer thread.
+	template<typename T>
+	class MPSCQueue : NonCopyable {
+		static_assert(std::is_base_of_v<MPSCNode, T>, "MPSCQueue elements must derive from MPSCNode");
+	public:
+		MPSCQueue() noexcept;
+
+		auto Push(T* element) noexcept -> void;
+		auto Pop()            noexcept -> T*;
+		auto IsEmpty() const  noexcept -> bool;
+
+	private:
+		auto PushNode(MPSCNode* node) noexcept -> void;
+
+		alignas(HAWK_CACHE_LINE_SIZE) std::atomic<MPSCNode*> m_Head;
+		alignas(HAWK_CACHE_LINE_SIZE) MPSCNode* m_Tail;
+		MPSCNode m_Stub;
+	};
+
+}
+
+namespace Hawk {
+
+	template<typename T>
+	ILINE MPSCQueue<T>::MPSCQueue() noexcept
+		: m_Head(&m_Stub)
+		, m_Tail(&m_Stub) {}
+
+	template<typename T>
+	ILINE auto MPSCQueue<T>::Push(T* element) noexcept -> void {
+		this->PushNode(static_cast<MPSCNode*>(element));
+	}
+
+	// Returns nullptr when the queue is empty, or when a producer has swapped the head but not yet linked its node
+	template<typename T>
+	[[nodiscard]] ILINE auto MPSCQueue<T>::Pop() noexcept -> T* {
+		auto* tail = m_Tail;
+		auto* next = tail->Next.load(std::memory_order_acquire);
+
+		if (tail == &m_Stub) {
+			if (next == nullptr)
+				return nullptr;
+			m_Tail = next;
+			tail = next;
+			next = next->Next.load(std::memory_order_acquire);
+		}
+
+		if (next != nullptr) {
+			m_Tail = next;
+			return static_cast<T*>(tail);
+		}
+
+		if (tail != m_Head.load(std::memory_order_acquire))
+			return nullptr;
+
+		this->PushNode(&m_Stub);
+		next = tail->Next.load(std::memory_order_acquire);
+		if (next != nullptr) {
+			m_Tail = next;
+			return static_cast<T*>(tail);
+		}
+		return nullptr;
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto MPSCQueue<T>::IsEmpty() const noexcept -> bool {
+		return m_Tail == &m_Stub && m_Stub.Next.load(std::memory_order_acquire) == nullptr;
+	}
+
+	template<typename T>
+	ILINE auto MPSCQueue<T>::PushNode(MPSCNode* node) noexcept -> void {
+		node->Next.store(nullptr, std::memory_order_relaxed);
+		auto* previous = m_Head.exchange(node, std::memory_order_acq_rel);
+		previous->Next.store(node, std::memory_order_release);
+	}
+
+}
\ No newline at end of file
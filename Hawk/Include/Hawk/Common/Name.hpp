@@ -0,0 +1,231 @@
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "./Defines.hpp"
+#include "./Singleton.hpp"
+#include "../Containers/FlatHashMap.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/Singleton.hpp>
+//#include <Hawk/Containers/FlatHashMap.hpp>
+
+namespace Hawk {
+
+	namespace Path {
+
+		constexpr size_t MaxLength = 512;
+
+		// Writes the canonical form of a path into a caller-owned buffer and returns a view of it: separators
+		// become '/', runs of separators collapse, "." segments drop, ".." pops the previous segment and ASCII
+		// letters are lowered. Nothing is allocated, so the same routine runs for literals at compile time.
+		constexpr auto Normalize(std::string_view value, char* buffer, size_t capacity) -> std::string_view;
+
+	}
+
+	namespace Detail {
+
+		template<typename U> struct NameTraits;
+
+		template<> struct NameTraits<U32> {
+			static constexpr U32 Offset = 0x811C9DC5u;
+			static constexpr U32 Prime  = 0x01000193u;
+		};
+
+		template<> struct NameTraits<U64> {
+			static constexpr U64 Offset = 0xCBF29CE484222325ull;
+			static constexpr U64 Prime  = 0x00000100000001B3ull;
+		};
+
+	}
+
+	// Interned identifier for asset paths and other names. The ID is the FNV-1a hash of the normalized string,
+	// so names compare and hash as a single integer and "Sponza\\Dummy.DDS" equals "sponza/dummy.dds"_hn.
+	// Constructing from a string interns it in a global table so String() can recover the text; names built
+	// from literals are hashed at compile time and stay out of the table until the same text is interned.
+	template<typename U>
+	class BasicName {
+	public:
+		using ValueType = U;
+
+		constexpr BasicName() noexcept : m_Value(0) {}
+		explicit BasicName(std::string_view value);
+
+		static constexpr auto FromValue(U value) noexcept -> BasicName;
+		static constexpr auto Hash(std::string_view normalized) noexcept -> U;
+		static constexpr auto HashPath(std::string_view value) -> U;
+
+		constexpr auto Value()   const noexcept -> U { return m_Value; }
+		constexpr auto IsValid() const noexcept -> bool { return m_Value != 0; }
+		auto String() const -> std::string_view;
+
+		constexpr auto operator==(BasicName rhs) const noexcept -> bool { return m_Value == rhs.m_Value; }
+		constexpr auto operator!=(BasicName rhs) const noexcept -> bool { return m_Value != rhs.m_Value; }
+		constexpr auto operator<(BasicName rhs)  const noexcept -> bool { return m_Value < rhs.m_Value; }
+
+	private:
+		U m_Value;
+	};
+
+	using Name   = BasicName<U64>;
+	using Name32 = BasicName<U32>;
+
+	template<typename U>
+	class NameTable : public Singleton<NameTable<U>> {
+	public:
+		NameTable(typename Singleton<NameTable<U>>::token) {}
+
+		auto Intern(BasicName<U> name, std::string_view normalized) -> void;
+		auto Find(BasicName<U> name) const -> std::string_view;
+		auto Size() const -> size_t;
+
+	private:
+		mutable std::shared_mutex                    m_Mutex;
+		std::deque<std::string>                      m_Strings;
+		FlatHashMap<U, std::string_view, Hasher<U>>  m_Names;
+	};
+
+	inline namespace Literals {
+
+		constexpr auto operator""_hn(char const* value, size_t size) -> Name;
+		constexpr auto operator""_hn32(char const* value, size_t size) -> Name32;
+
+	}
+
+}
+
+namespace Hawk {
+
+	namespace Path {
+
+		[[nodiscard]] ILINE constexpr auto Normalize(std::string_view value, char* buffer, size_t capacity) -> std::string_view {
+			auto const isSeparator = [](char c) { return c == '/' || c == '\\'; };
+
+			auto size = size_t{ 0 };
+			auto root = size_t{ 0 };
+			if (!value.empty() && isSeparator(value[0])) {
+				if (capacity == 0)
+					throw std::length_error("Path is too long");
+				buffer[size++] = '/';
+				root = 1;
+			}
+
+			auto position = size_t{ 0 };
+			while (position < value.size()) {
+				while (position < value.size() && isSeparator(value[position]))
+					position++;
+				auto const begin = position;
+				while (position < value.size() && !isSeparator(value[position]))
+					position++;
+				auto const segment = value.substr(begin, position - begin);
+
+				if (segment.empty() || segment == ".")
+					continue;
+
+				if (segment == "..") {
+					auto const last = size > root ? std::string_view{ buffer + root, size - root } : std::string_view{};
+					auto const cut = last.rfind('/');
+					auto const tail = cut == std::string_view::npos ? last : last.substr(cut + 1);
+					if (!tail.empty() && tail != "..") {
+						size = cut == std::string_view::npos ? root : root + cut;
+						continue;
+					}
+					if (root > 0 && tail.empty())
+						continue;
+				}
+
+				if (size + (size > root ? 1 : 0) + segment.size() > capacity)
+					throw std::length_error("Path is too long");
+				if (size > root)
+					buffer[size++] = '/';
+				for (auto c : segment)
+					buffer[size++] = (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+			}
+			return std::string_view{ buffer, size };
+		}
+
+	}
+
+	template<typename U>
+	ILINE BasicName<U>::BasicName(std::string_view value) {
+		char buffer[Path::MaxLength];
+		auto const normalized = Path::Normalize(value, buffer, Path::MaxLength);
+		m_Value = Hash(normalized);
+		NameTable<U>::Instance().Intern(*this, normalized);
+	}
+
+	template<typename U>
+	[[nodiscard]] ILINE constexpr auto BasicName<U>::FromValue(U value) noexcept -> BasicName {
+		auto name = BasicName{};
+		name.m_Value = value;
+		return name;
+	}
+
+	template<typename U>
+	[[nodiscard]] ILINE constexpr auto BasicName<U>::Hash(std::string_view normalized) noexcept -> U {
+		auto hash = Detail::NameTraits<U>::Offset;
+		for (auto c : normalized)
+			hash = static_cast<U>((hash ^ static_cast<U8>(c)) * Detail::NameTraits<U>::Prime);
+		return hash;
+	}
+
+	template<typename U>
+	[[nodiscard]] ILINE constexpr auto BasicName<U>::HashPath(std::string_view value) -> U {
+		char buffer[Path::MaxLength] = {};
+		return Hash(Path::Normalize(value, buffer, Path::MaxLength));
+	}
+
+	template<typename U>
+	[[nodiscard]] ILINE auto BasicName<U>::String() const -> std::string_view {
+		return NameTable<U>::Instance().Find(*this);
+	}
+
+	template<typename U>
+	ILINE auto NameTable<U>::Intern(BasicName<U> name, std::string_view normalized) -> void {
+		{
+			std::shared_lock<std::shared_mutex> lock{ m_Mutex };
+			if (auto const* value = m_Names.Find(name.Value())) {
+				assert(*value == normalized && "Name hash collision");
+				return;
+			}
+		}
+
+		std::unique_lock<std::shared_mutex> lock{ m_Mutex };
+		if (m_Names.Contains(name.Value()))
+			return;
+		auto const& stored = m_Strings.emplace_back(normalized);
+		m_Names.TryEmplace(name.Value(), std::string_view{ stored });
+	}
+
+	template<typename U>
+	[[nodiscard]] ILINE auto NameTable<U>::Find(BasicName<U> name) const -> std::string_view {
+		std::shared_lock<std::shared_mutex> lock{ m_Mutex };
+		auto const* value = m_Names.Find(name.Value());
+		return value ? *value : std::string_view{};
+	}
+
+	template<typename U>
+	[[nodiscard]] ILINE auto NameTable<U>::Size() const -> size_t {
+		std::shared_lock<std::shared_mutex> lock{ m_Mutex };
+		return m_Names.Size();
+	}
+
+	inline namespace Literals {
+
+		[[nodiscard]] ILINE constexpr auto operator""_hn(char const* value, size_t size) -> Name {
+			return Name::FromValue(Name::HashPath(std::string_view{ value, size }));
+		}
+
+		[[nodiscard]] ILINE constexpr auto operator""_hn32(char const* value, size_t size) -> Name32 {
+			return Name32::FromValue(Name32::HashPath(std::string_view{ value, size }));
+		}
+
+	}
+
+}
\ No newline at end of file
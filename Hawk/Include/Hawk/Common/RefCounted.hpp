@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <type_traits>
+#include <utility>
+
+#include "./Defines.hpp"
+#include "./NonCopyable.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+
+namespace Hawk {
+
+	// Intrusive reference count with the same AddRef/Release contract as IUnknown, so RefPtr and the
+	// deletion queue treat engine objects and COM interfaces alike. A new object starts at zero references.
+	template<typename T>
+	class RefCounted : NonCopyable {
+	public:
+		auto AddRef()   const noexcept -> U32;
+		auto Release()  const noexcept -> U32;
+		auto RefCount() const noexcept -> U32;
+
+	protected:
+		RefCounted() noexcept = default;
+		~RefCounted() = default;
+
+	private:
+		mutable std::atomic<U32> m_RefCount = 0;
+	};
+
+	// Owning pointer for anything exposing AddRef/Release, in the spirit of Microsoft::WRL::ComPtr
+	template<typename T>
+	class RefPtr {
+	public:
+		RefPtr() noexcept = default;
+		RefPtr(std::nullptr_t) noexcept {}
+		RefPtr(T* pointer) noexcept;
+		RefPtr(RefPtr const& rhs) noexcept;
+		RefPtr(RefPtr&& rhs) noexcept;
+		template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+		RefPtr(RefPtr<U> const& rhs) noexcept;
+		template<typename U, typename = std::enable_if_t<std::is_convertible_v<U*, T*>>>
+		RefPtr(RefPtr<U>&& rhs) noexcept;
+		~RefPtr();
+
+		auto operator=(RefPtr rhs) noexcept -> RefPtr&;
+
+		auto Attach(T* pointer) noexcept -> void;
+		auto Detach() noexcept -> T*;
+		auto Reset() noexcept -> void;
+		auto Swap(RefPtr& rhs) noexcept -> void;
+
+		auto Get()        const noexcept -> T* { return m_Pointer; }
+		auto operator->() const noexcept -> T* { return m_Pointer; }
+		auto operator*()  const noexcept -> T& { return *m_Pointer; }
+		explicit operator bool() const noexcept { return m_Pointer != nullptr; }
+
+		auto operator==(RefPtr const& rhs) const noexcept -> bool { return m_Pointer == rhs.m_Pointer; }
+		auto operator!=(RefPtr const& rhs) const noexcept -> bool { return m_Pointer != rhs.m_Pointer; }
+
+	private:
+		template<typename U> friend class RefPtr;
+
+		T* m_Pointer = nullptr;
+	};
+
+	template<typename T, typename... Args>
+	auto MakeRef(Args&&... args) -> RefPtr<T>;
+
+}
+
+namespace Hawk {
+
+	template<typename T>
+	ILINE auto RefCounted<T>::AddRef() const noexcept -> U32 {
+		return m_RefCount.fetch_add(1, std::memory_order_relaxed) + 1;
+	}
+
+	template<typename T>
+	ILINE auto RefCounted<T>::Release() const noexcept -> U32 {
+		auto const count = m_RefCount.fetch_sub(1, std::memory_order_acq_rel) - 1;
+		if (count == 0)
+			delete static_cast<T const*>(this);
+		return count;
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto RefCounted<T>::RefCount() const noexcept -> U32 {
+		return m_RefCount.load(std::memory_order_relaxed);
+	}
+
+	template<typename T>
+	ILINE RefPtr<T>::RefPtr(T* pointer) noexcept : m_Pointer(pointer) {
+		if (m_Pointer)
+			m_Pointer->AddRef();
+	}
+
+	template<typename T>
+	ILINE RefPtr<T>::RefPtr(RefPtr const& rhs) noexcept : RefPtr(rhs.m_Pointer) {}
+
+	template<typename T>
+	ILINE RefPtr<T>::RefPtr(RefPtr&& rhs) noexcept : m_Pointer(std::exchange(rhs.m_Pointer, nullptr)) {}
+
+	template<typename T>
+	template<typename U, typename>
+	ILINE RefPtr<T>::RefPtr(RefPtr<U> const& rhs) noexcept : RefPtr(static_cast<T*>(rhs.m_Pointer)) {}
+
+	template<typename T>
+	template<typename U, typename>
+	ILINE RefPtr<T>::RefPtr(RefPtr<U>&& rhs) noexcept : m_Pointer(std::exchange(rhs.m_Pointer, nullptr)) {}
+
+	template<typename T>
+	ILINE RefPtr<T>::~RefPtr() {
+		this->Reset();
+	}
+
+	template<typename T>
+	ILINE auto RefPtr<T>::operator=(RefPtr rhs) noexcept -> RefPtr& {
+		this->Swap(rhs);
+		return *this;
+	}
+
+	// Takes over a reference the caller already owns
+	template<typename T>
+	ILINE auto RefPtr<T>::Attach(T* pointer) noexcept -> void {
+		this->Reset();
+		m_Pointer = pointer;
+	}
+
+	// Hands the reference back to the caller, who becomes responsible for releasing it
+	template<typename T>
+	[[nodiscard]] ILINE auto RefPtr<T>::Detach() noexcept -> T* {
+		return std::exchange(m_Pointer, nullptr);
+	}
+
+	template<typename T>
+	ILINE auto RefPtr<T>::Reset() noexcept -> void {
+		if (auto* pointer = std::exchange(m_Pointer, nullptr))
+			pointer->Release();
+	}
+
+	template<typename T>
+	ILINE auto RefPtr<T>::Swap(RefPtr& rhs) noexcept -> void {
+		std::swap(m_Pointer, rhs.m_Pointer);
+	}
+
+	template<typename T, typename... Args>
+	[[nodiscard]] ILINE auto MakeRef(Args&&... args) -> RefPtr<T> {
+		return RefPtr<T>{ new T(std::forward<Args>(args)...) };
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <utility>
+
+#include "./Defines.hpp"
+#include "./NonCopyable.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+
+namespace Hawk {
+
+	// Bounded single-producer single-consumer ring. Each side keeps a cached copy of the other side's index,
+	// so the shared cache line is only touched when the ring looks full or empty.
+	template<typename T>
+	class SPSCQueue : NonCopyable {
+	public:
+		SPSCQueue(U32 capacity);
+		~SPSCQueue();
+
+		template<typename... Args>
+		auto TryEmplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> bool;
+		auto TryPush(T const& value) noexcept(std::is_nothrow_copy_constructible_v<T>) -> bool;
+		auto TryPush(T&& value)      noexcept(std::is_nothrow_move_constructible_v<T>) -> bool;
+		auto TryPop(T& value)        noexcept(std::is_nothrow_move_assignable_v<T>) -> bool;
+
+		auto IsEmpty()  const noexcept -> bool;
+		auto Size()     const noexcept -> U32;
+		auto Capacity() const noexcept -> U32;
+
+	private:
+		struct Slot {
+			alignas(T) U8 Data[sizeof(T)];
+		};
+
+		alignas(HAWK_CACHE_LINE_SIZE) std::atomic<U64> m_Head;
+		U64 m_TailCached;
+		alignas(HAWK_CACHE_LINE_SIZE) std::atomic<U64> m_Tail;
+		U64 m_HeadCached;
+		alignas(HAWK_CACHE_LINE_SIZE) std::unique_ptr<Slot[]> m_Slots;
+		U64 m_Mask;
+	};
+
+}
+
+namespace Hawk {
+
+	template<typename T>
+	ILINE SPSCQueue<T>::SPSCQueue(U32 capacity)
+		: m_Head(0)
+		, m_TailCached(0)
+		, m_Tail(0)
+		, m_HeadCached(0)
+		, m_Slots(std::make_unique<Slot[]>(capacity))
+		, m_Mask(capacity - 1) {
+		assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+	}
+
+	template<typename T>
+	ILINE SPSCQueue<T>::~SPSCQueue() {
+		auto const tail = m_Tail.load(std::memory_order_relaxed);
+		for (auto index = m_Head.load(std::memory_order_relaxed); index != tail; index++)
+			std::launder(reinterpret_cast<T*>(m_Slots[index & m_Mask].Data))->~T();
+	}
+
+	template<typename T>
+	template<typename... Args>
+	ILINE auto SPSCQueue<T>::TryEmplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> bool {
+		auto const tail = m_Tail.load(std::memory_order_relaxed);
+		if (tail - m_HeadCached > m_Mask) {
+			m_HeadCached = m_Head.load(std::memory_order_acquire);
+			if (tail - m_HeadCached > m_Mask)
+				return false;
+		}
+
+		new (m_Slots[tail & m_Mask].Data) T(std::forward<Args>(args)...);
+		m_Tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	ILINE auto SPSCQueue<T>::TryPush(T const& value) noexcept(std::is_nothrow_copy_constructible_v<T>) -> bool {
+		return this->TryEmplace(value);
+	}
+
+	template<typename T>
+	ILINE auto SPSCQueue<T>::TryPush(T&& value) noexcept(std::is_nothrow_move_constructible_v<T>) -> bool {
+		return this->TryEmplace(std::move(value));
+	}
+
+	template<typename T>
+	ILINE auto SPSCQueue<T>::TryPop(T& value) noexcept(std::is_nothrow_move_assignable_v<T>) -> bool {
+		auto const head = m_Head.load(std::memory_order_relaxed);
+		if (head == m_TailCached) {
+			m_TailCached = m_Tail.load(std::memory_order_acquire);
+			if (head == m_TailCached)
+				return false;
+		}
+
+		auto* element = std::launder(reinterpret_cast<T*>(m_Slots[head & m_Mask].Data));
+		value = std::move(*element);
+		element->~T();
+		m_Head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto SPSCQueue<T>::IsEmpty() const noexcept -> bool {
+		return m_Head.load(std::memory_order_acquire) == m_Tail.load(std::memory_order_acquire);
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto SPSCQueue<T>::Size() const noexcept -> U32 {
+		auto const head = m_Head.load(std::memory_order_acquire);
+		return static_cast<U32>(m_Tail.load(std::memory_order_acquire) - head);
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto SPSCQueue<T>::Capacity() const noexcept -> U32 {
+		return static_cast<U32>(m_Mask + 1);
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,391 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "./Defines.hpp"
+#include "./Jobs.hpp"
+#include "./NonCopyable.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/Jobs.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+
+namespace Hawk {
+
+	template<typename T = void> class Task;
+
+	namespace Detail {
+
+		class TaskPromiseBase {
+		public:
+			struct FinalAwaiter {
+				auto await_ready() const noexcept -> bool { return false; }
+				auto await_resume() const noexcept -> void {}
+
+				// Symmetric transfer to whoever awaited the task, so long chains do not grow the stack
+				template<typename Promise>
+				auto await_suspend(std::coroutine_handle<Promise> handle) noexcept -> std::coroutine_handle<> {
+					auto const continuation = handle.promise().m_Continuation;
+					return continuation ? continuation : std::noop_coroutine();
+				}
+			};
+
+			auto initial_suspend() const noexcept -> std::suspend_always { return {}; }
+			auto final_suspend()   const noexcept -> FinalAwaiter { return {}; }
+			auto unhandled_exception()   noexcept -> void { m_Exception = std::current_exception(); }
+
+			auto SetContinuation(std::coroutine_handle<> continuation) noexcept -> void { m_Continuation = continuation; }
+
+		protected:
+			auto RethrowIfFailed() const -> void {
+				if (m_Exception)
+					std::rethrow_exception(m_Exception);
+			}
+
+			std::coroutine_handle<> m_Continuation;
+			std::exception_ptr      m_Exception;
+		};
+
+		template<typename T>
+		class TaskPromise : public TaskPromiseBase {
+		public:
+			auto get_return_object() noexcept -> Task<T>;
+
+			template<typename U>
+			auto return_value(U&& value) -> void { m_Value.emplace(std::forward<U>(value)); }
+
+			auto Result() -> T& {
+				this->RethrowIfFailed();
+				return *m_Value;
+			}
+
+		private:
+			std::optional<T> m_Value;
+		};
+
+		template<>
+		class TaskPromise<void> : public TaskPromiseBase {
+		public:
+			auto get_return_object() noexcept -> Task<void>;
+			auto return_void() noexcept -> void {}
+			auto Result() -> void { this->RethrowIfFailed(); }
+		};
+
+		// Fire-and-forget coroutine that waits for a task and signals a counter; the frame destroys itself on completion
+		class DetachedTask {
+		public:
+			struct promise_type {
+				struct FinalAwaiter {
+					auto await_ready() const noexcept -> bool { return false; }
+					auto await_resume() const noexcept -> void {}
+					auto await_suspend(std::coroutine_handle<promise_type> handle) noexcept -> std::coroutine_handle<> {
+						auto* const signal = handle.promise().Signal;
+						auto const continuation = handle.promise().Continuation;
+						handle.destroy();
+						if (signal->Decrement() && continuation)
+							return continuation;
+						return std::noop_coroutine();
+					}
+				};
+
+				auto get_return_object() noexcept -> DetachedTask { return DetachedTask{ std::coroutine_handle<promise_type>::from_promise(*this) }; }
+				auto initial_suspend() const noexcept -> std::suspend_always { return {}; }
+				auto final_suspend()   const noexcept -> FinalAwaiter { return {}; }
+				auto return_void()     const noexcept -> void {}
+				auto unhandled_exception() const noexcept -> void { std::terminate(); }
+
+				Jobs::Counter*          Signal = nullptr;
+				std::coroutine_handle<> Continuation;
+			};
+
+			auto Bind(Jobs::Counter& signal, std::coroutine_handle<> continuation = {}) noexcept -> std::coroutine_handle<> {
+				m_Handle.promise().Signal = &signal;
+				m_Handle.promise().Continuation = continuation;
+				return m_Handle;
+			}
+
+		private:
+			explicit DetachedTask(std::coroutine_handle<promise_type> handle) noexcept : m_Handle(handle) {}
+			std::coroutine_handle<promise_type> m_Handle;
+		};
+
+		// Takes the awaiter by value so the frame owns the handle and the Task object itself may move meanwhile
+		template<typename T>
+		auto MakeDetachedTask(typename Task<T>::ReadyAwaiter ready) -> DetachedTask {
+			co_await ready;
+		}
+
+		class ScheduleAwaiter {
+		public:
+			ScheduleAwaiter(Jobs::Scheduler& scheduler) noexcept : m_Scheduler(scheduler) {}
+			auto await_ready() const noexcept -> bool { return false; }
+			auto await_resume() const noexcept -> void {}
+			auto await_suspend(std::coroutine_handle<> handle) noexcept -> void { m_Scheduler.Run([handle]() { handle.resume(); }); }
+		private:
+			Jobs::Scheduler& m_Scheduler;
+		};
+
+		template<typename T>
+		class WhenAllAwaiter {
+		public:
+			WhenAllAwaiter(Jobs::Scheduler& scheduler, std::vector<Task<T>>& tasks) noexcept : m_Scheduler(scheduler), m_Tasks(tasks) {}
+			auto await_ready() const noexcept -> bool { return m_Tasks.empty(); }
+			auto await_resume() const noexcept -> void {}
+
+			auto await_suspend(std::coroutine_handle<> handle) -> bool {
+				// One extra reference keeps the continuation from firing before every task has been submitted
+				m_Signal.Add(static_cast<U32>(m_Tasks.size()) + 1);
+				for (auto& e : m_Tasks) {
+					auto const detached = MakeDetachedTask<T>(e.WhenReady()).Bind(m_Signal, handle);
+					m_Scheduler.Run([detached]() { detached.resume(); });
+				}
+				return !m_Signal.Decrement();
+			}
+
+		private:
+			Jobs::Scheduler&      m_Scheduler;
+			std::vector<Task<T>>& m_Tasks;
+			Jobs::Counter         m_Signal;
+		};
+
+	}
+
+	// Lazily started coroutine: the body runs when the task is first awaited, launched or waited on
+	template<typename T>
+	class Task {
+	public:
+		using promise_type = Detail::TaskPromise<T>;
+		using Handle = std::coroutine_handle<promise_type>;
+
+		template<bool IsMove>
+		class Awaiter {
+		public:
+			Awaiter(Handle handle) noexcept : m_Handle(handle) {}
+			auto await_ready() const noexcept -> bool { return !m_Handle || m_Handle.done(); }
+
+			auto await_suspend(std::coroutine_handle<> continuation) noexcept -> std::coroutine_handle<> {
+				m_Handle.promise().SetContinuation(continuation);
+				return m_Handle;
+			}
+
+			auto await_resume() -> std::conditional_t<IsMove, T, std::add_lvalue_reference_t<T>> {
+				if constexpr (IsMove && !std::is_void_v<T>)
+					return std::move(m_Handle.promise().Result());
+				else
+					return m_Handle.promise().Result();
+			}
+
+		private:
+			Handle m_Handle;
+		};
+
+		class ReadyAwaiter : public Awaiter<false> {
+		public:
+			using Awaiter<false>::Awaiter;
+			auto await_resume() const noexcept -> void {}
+		};
+
+		Task() noexcept = default;
+		explicit Task(Handle handle) noexcept;
+		Task(Task&& rhs) noexcept;
+		Task(Task const&) = delete;
+		~Task();
+
+		auto operator=(Task&& rhs) noexcept -> Task&;
+		auto operator=(Task const&) -> Task& = delete;
+
+		auto operator co_await() &  noexcept -> Awaiter<false>;
+		auto operator co_await() && noexcept -> Awaiter<true>;
+
+		auto WhenReady()       noexcept -> ReadyAwaiter;
+		auto IsReady()   const noexcept -> bool;
+		auto Result() -> decltype(auto);
+
+	private:
+		Handle m_Handle;
+	};
+
+	// Completion token in the spirit of ID3D12Fence: waiters resume on the thread that signals a value they wait for
+	class Fence : NonCopyable {
+	public:
+		class Awaiter {
+		public:
+			Awaiter(Fence& fence, U64 value) noexcept : m_Fence(fence), m_Value(value) {}
+			auto await_ready() const noexcept -> bool { return m_Fence.CompletedValue() >= m_Value; }
+			auto await_suspend(std::coroutine_handle<> handle) -> bool;
+			auto await_resume() const noexcept -> void {}
+		private:
+			Fence& m_Fence;
+			U64    m_Value;
+		};
+
+		Fence(U64 value = 0) noexcept;
+
+		auto Signal(U64 value) -> void;
+		auto Wait(U64 value) noexcept -> Awaiter;
+		auto CompletedValue() const noexcept -> U64;
+
+	private:
+		struct Waiter {
+			U64                     Value;
+			std::coroutine_handle<> Handle;
+		};
+
+		std::atomic<U64>    m_CompletedValue;
+		std::mutex          m_Mutex;
+		std::vector<Waiter> m_Waiters;
+	};
+
+	auto ScheduleOn(Jobs::Scheduler& scheduler) noexcept -> Detail::ScheduleAwaiter;
+
+	template<typename T> auto WhenAll(Jobs::Scheduler& scheduler, std::vector<Task<T>>& tasks) -> Task<void>;
+	template<typename T> auto Launch(Jobs::Scheduler& scheduler, Task<T>& task, Jobs::Counter& counter) -> void;
+	template<typename T> auto SyncWait(Jobs::Scheduler& scheduler, Task<T>& task) -> decltype(auto);
+	template<typename T> auto SyncWait(Jobs::Scheduler& scheduler, Task<T>&& task) -> T;
+
+}
+
+namespace Hawk {
+
+	namespace Detail {
+
+		template<typename T>
+		ILINE auto TaskPromise<T>::get_return_object() noexcept -> Task<T> {
+			return Task<T>{ std::coroutine_handle<TaskPromise<T>>::from_promise(*this) };
+		}
+
+		ILINE auto TaskPromise<void>::get_return_object() noexcept -> Task<void> {
+			return Task<void>{ std::coroutine_handle<TaskPromise<void>>::from_promise(*this) };
+		}
+
+	}
+
+	template<typename T>
+	ILINE Task<T>::Task(Handle handle) noexcept : m_Handle(handle) {}
+
+	template<typename T>
+	ILINE Task<T>::Task(Task&& rhs) noexcept : m_Handle(std::exchange(rhs.m_Handle, {})) {}
+
+	template<typename T>
+	ILINE Task<T>::~Task() {
+		if (m_Handle)
+			m_Handle.destroy();
+	}
+
+	template<typename T>
+	ILINE auto Task<T>::operator=(Task&& rhs) noexcept -> Task& {
+		if (this != &rhs) {
+			if (m_Handle)
+				m_Handle.destroy();
+			m_Handle = std::exchange(rhs.m_Handle, {});
+		}
+		return *this;
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto Task<T>::operator co_await() & noexcept -> Awaiter<false> {
+		return Awaiter<false>{ m_Handle };
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto Task<T>::operator co_await() && noexcept -> Awaiter<true> {
+		return Awaiter<true>{ m_Handle };
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto Task<T>::WhenReady() noexcept -> ReadyAwaiter {
+		return ReadyAwaiter{ m_Handle };
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto Task<T>::IsReady() const noexcept -> bool {
+		return m_Handle && m_Handle.done();
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto Task<T>::Result() -> decltype(auto) {
+		assert(this->IsReady());
+		return m_Handle.promise().Result();
+	}
+
+	ILINE Fence::Fence(U64 value) noexcept : m_CompletedValue(value) {}
+
+	ILINE auto Fence::Signal(U64 value) -> void {
+		auto ready = std::vector<std::coroutine_handle<>>{};
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			if (value <= m_CompletedValue.load(std::memory_order_relaxed))
+				return;
+			m_CompletedValue.store(value, std::memory_order_release);
+
+			auto const it = std::partition(m_Waiters.begin(), m_Waiters.end(), [value](Waiter const& e) { return e.Value > value; });
+			ready.reserve(std::distance(it, m_Waiters.end()));
+			for (auto e = it; e != m_Waiters.end(); e++)
+				ready.push_back(e->Handle);
+			m_Waiters.erase(it, m_Waiters.end());
+		}
+
+		for (auto& e : ready)
+			e.resume();
+	}
+
+	[[nodiscard]] ILINE auto Fence::Wait(U64 value) noexcept -> Awaiter {
+		return Awaiter{ *this, value };
+	}
+
+	[[nodiscard]] ILINE auto Fence::CompletedValue() const noexcept -> U64 {
+		return m_CompletedValue.load(std::memory_order_acquire);
+	}
+
+	ILINE auto Fence::Awaiter::await_suspend(std::coroutine_handle<> handle) -> bool {
+		std::lock_guard<std::mutex> lock(m_Fence.m_Mutex);
+		if (m_Fence.m_CompletedValue.load(std::memory_order_relaxed) >= m_Value)
+			return false;
+		m_Fence.m_Waiters.push_back({ m_Value, handle });
+		return true;
+	}
+
+	[[nodiscard]] ILINE auto ScheduleOn(Jobs::Scheduler& scheduler) noexcept -> Detail::ScheduleAwaiter {
+		return Detail::ScheduleAwaiter{ scheduler };
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto WhenAll(Jobs::Scheduler& scheduler, std::vector<Task<T>>& tasks) -> Task<void> {
+		co_await Detail::WhenAllAwaiter<T>{ scheduler, tasks };
+	}
+
+	template<typename T>
+	ILINE auto Launch(Jobs::Scheduler& scheduler, Task<T>& task, Jobs::Counter& counter) -> void {
+		counter.Add(1);
+		auto const detached = Detail::MakeDetachedTask<T>(task.WhenReady()).Bind(counter);
+		scheduler.Run([detached]() { detached.resume(); });
+	}
+
+	template<typename T>
+	ILINE auto SyncWait(Jobs::Scheduler& scheduler, Task<T>& task) -> decltype(auto) {
+		auto counter = Jobs::Counter{ 1 };
+		Detail::MakeDetachedTask<T>(task.WhenReady()).Bind(counter).resume();
+		scheduler.Wait(counter);
+		return task.Result();
+	}
+
+	template<typename T>
+	ILINE auto SyncWait(Jobs::Scheduler& scheduler, Task<T>&& task) -> T {
+		auto counter = Jobs::Counter{ 1 };
+		Detail::MakeDetachedTask<T>(task.WhenReady()).Bind(counter).resume();
+		scheduler.Wait(counter);
+		if constexpr (std::is_void_v<T>)
+			task.Result();
+		else
+			return std::move(task.Result());
+	}
+
+}
\ No newline at end of file
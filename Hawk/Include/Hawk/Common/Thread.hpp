@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <thread>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "./Defines.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+
+namespace Hawk {
+	namespace Thread {
+
+		auto SetName(std::thread& thread, std::string const& name) noexcept -> void;
+		auto SetAffinity(std::thread& thread, U32 core)            noexcept -> void;
+		auto CountHardwareThreads()                                noexcept -> U32;
+		auto Pause()                                               noexcept -> void;
+
+	}
+}
+
+namespace Hawk {
+	namespace Thread {
+
+		ILINE auto SetName(std::thread& thread, std::string const& name) noexcept -> void {
+#if defined(_WIN32)
+			::SetThreadDescription(thread.native_handle(), std::wstring(name.begin(), name.end()).c_str());
+#elif defined(__APPLE__)
+			(void)thread;
+			(void)name;
+#else
+			::pthread_setname_np(thread.native_handle(), name.substr(0, 15).c_str());
+#endif
+		}
+
+		ILINE auto SetAffinity(std::thread& thread, U32 core) noexcept -> void {
+#if defined(_WIN32)
+			// The mask covers the first processor group only
+			if (core >= 8 * sizeof(DWORD_PTR))
+				return;
+			::SetThreadAffinityMask(thread.native_handle(), DWORD_PTR{ 1 } << core);
+#elif defined(__APPLE__)
+			(void)thread;
+			(void)core;
+#else
+			if (core >= CPU_SETSIZE)
+				return;
+			cpu_set_t set;
+			CPU_ZERO(&set);
+			CPU_SET(core, &set);
+			::pthread_setaffinity_np(thread.native_handle(), sizeof(cpu_set_t), &set);
+#endif
+		}
+
+		[[nodiscard]] ILINE auto CountHardwareThreads() noexcept -> U32 {
+			auto const count = std::thread::hardware_concurrency();
+			return count > 0 ? count : 1;
+		}
+
+		ILINE auto Pause() noexcept -> void {
+#if defined(_M_X64) || defined(_M_IX86)
+			::YieldProcessor();
+#elif defined(__x86_64__) || defined(__i386__)
+			__builtin_ia32_pause();
+#else
+			std::this_thread::yield();
+#endif
+		}
+
+	}
+}
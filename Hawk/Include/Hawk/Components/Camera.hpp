@@ -44,6 +44,9 @@ namespace Hawk {
 			Math::Mat4x4 m_World;
 
 		};
+
+		constexpr auto Lerp(Camera const& c0, Camera const& c1, F32 t)  noexcept->Camera;
+		constexpr auto Slerp(Camera const& c0, Camera const& c1, F32 t) noexcept->Camera;
 	}
 }
 
@@ -132,5 +135,19 @@ namespace Hawk {
 			return Math::Rotate(m_Rotation, Camera::LocalUp);
 		}
 
+		[[nodiscard]] ILINE constexpr auto Lerp(Camera const& c0, Camera const& c1, F32 t) noexcept -> Camera {
+			auto result = Camera{};
+			result.SetTranslation(Math::Lerp(c0.Translation(), c1.Translation(), t));
+			result.SetRotation(Math::Nlerp(c0.Rotation(), c1.Rotation(), t));
+			return result;
+		}
+
+		[[nodiscard]] ILINE constexpr auto Slerp(Camera const& c0, Camera const& c1, F32 t) noexcept -> Camera {
+			auto result = Camera{};
+			result.SetTranslation(Math::Lerp(c0.Translation(), c1.Translation(), t));
+			result.SetRotation(Math::Slerp(c0.Rotation(), c1.Rotation(), t));
+			return result;
+		}
+
 	}
 }
\ No newline at end of file
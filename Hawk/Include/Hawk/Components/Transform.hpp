@@ -55,6 +55,9 @@ namespace Hawk {
 			Math::Mat4x4  m_Model;
 		};
 
+		constexpr auto Lerp(Transform const& t0, Transform const& t1, F32 t)  noexcept->Transform;
+		constexpr auto Slerp(Transform const& t0, Transform const& t1, F32 t) noexcept->Transform;
+
 	}
 }
 namespace Hawk {
@@ -187,5 +190,21 @@ namespace Hawk {
 			}
 			return m_Model;
 		}
+
+		[[nodiscard]] ILINE constexpr auto Lerp(Transform const& t0, Transform const& t1, F32 t) noexcept -> Transform {
+			auto result = Transform{};
+			result.SetTranslation(Math::Lerp(t0.Translation(), t1.Translation(), t));
+			result.SetScale(Math::Lerp(t0.Scale(), t1.Scale(), t));
+			result.SetRotation(Math::Nlerp(t0.Rotation(), t1.Rotation(), t));
+			return result;
+		}
+
+		[[nodiscard]] ILINE constexpr auto Slerp(Transform const& t0, Transform const& t1, F32 t) noexcept -> Transform {
+			auto result = Transform{};
+			result.SetTranslation(Math::Lerp(t0.Translation(), t1.Translation(), t));
+			result.SetScale(Math::Lerp(t0.Scale(), t1.Scale(), t));
+			result.SetRotation(Math::Slerp(t0.Rotation(), t1.Rotation(), t));
+			return result;
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "../Common/Defines.hpp"
+#include "../Memory/Utility.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Memory/Utility.hpp>
+
+namespace Hawk {
+
+	// Vector with inline storage for at most N elements and no heap fallback. Meant for short lists whose bound
+	// is known up front, such as input layouts and barrier batches; growing past N throws std::length_error.
+	template<typename T, size_t N>
+	class FixedVector {
+	public:
+		using Iterator      = T*;
+		using ConstIterator = T const*;
+
+		FixedVector() noexcept = default;
+		FixedVector(std::initializer_list<T> values);
+		FixedVector(FixedVector const& rhs);
+		FixedVector(FixedVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>);
+		~FixedVector();
+
+		auto operator=(FixedVector const& rhs) -> FixedVector&;
+		auto operator=(FixedVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) -> FixedVector&;
+
+		template<typename... Args>
+		auto EmplaceBack(Args&&... args) -> T&;
+		auto PushBack(T const& value) -> T&;
+		auto PushBack(T&& value) -> T&;
+		auto PopBack() noexcept -> void;
+		auto Resize(size_t count) -> void;
+		auto Clear() noexcept -> void;
+
+		auto operator[](size_t index)       noexcept -> T&;
+		auto operator[](size_t index) const noexcept -> T const&;
+
+		auto Data()           noexcept -> T*       { return reinterpret_cast<T*>(m_Storage); }
+		auto Data()     const noexcept -> T const* { return reinterpret_cast<T const*>(m_Storage); }
+		auto Size()     const noexcept -> size_t { return m_Size; }
+		auto IsEmpty()  const noexcept -> bool { return m_Size == 0; }
+		auto IsFull()   const noexcept -> bool { return m_Size == N; }
+		static constexpr auto Capacity() noexcept -> size_t { return N; }
+
+		auto begin()       noexcept -> Iterator { return this->Data(); }
+		auto end()         noexcept -> Iterator { return this->Data() + m_Size; }
+		auto begin() const noexcept -> ConstIterator { return this->Data(); }
+		auto end()   const noexcept -> ConstIterator { return this->Data() + m_Size; }
+
+	private:
+		alignas(T) U8 m_Storage[sizeof(T) * N];
+		size_t        m_Size = 0;
+	};
+
+	namespace Memory {
+
+		template<typename T, size_t N>
+		struct IsTriviallyRelocatable<FixedVector<T, N>> : IsTriviallyRelocatable<T> {};
+
+	}
+
+}
+
+namespace Hawk {
+
+	template<typename T, size_t N>
+	ILINE FixedVector<T, N>::FixedVector(std::initializer_list<T> values) {
+		if (values.size() > N)
+			throw std::length_error("FixedVector is full");
+		for (auto const& e : values)
+			this->EmplaceBack(e);
+	}
+
+	template<typename T, size_t N>
+	ILINE FixedVector<T, N>::FixedVector(FixedVector const& rhs) {
+		for (auto const& e : rhs)
+			this->EmplaceBack(e);
+	}
+
+	template<typename T, size_t N>
+	ILINE FixedVector<T, N>::FixedVector(FixedVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) {
+		for (auto& e : rhs)
+			this->EmplaceBack(std::move(e));
+		rhs.Clear();
+	}
+
+	template<typename T, size_t N>
+	ILINE FixedVector<T, N>::~FixedVector() {
+		this->Clear();
+	}
+
+	template<typename T, size_t N>
+	ILINE auto FixedVector<T, N>::operator=(FixedVector const& rhs) -> FixedVector& {
+		if (this != &rhs) {
+			this->Clear();
+			for (auto const& e : rhs)
+				this->EmplaceBack(e);
+		}
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	ILINE auto FixedVector<T, N>::operator=(FixedVector&& rhs) noexcept(std::is_nothrow_move_constructible_v<T>) -> FixedVector& {
+		if (this != &rhs) {
+			this->Clear();
+			for (auto& e : rhs)
+				this->EmplaceBack(std::move(e));
+			rhs.Clear();
+		}
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	template<typename... Args>
+	ILINE auto FixedVector<T, N>::EmplaceBack(Args&&... args) -> T& {
+		if (m_Size == N)
+			throw std::length_error("FixedVector is full");
+		auto* element = new (this->Data() + m_Size) T(std::forward<Args>(args)...);
+		m_Size++;
+		return *element;
+	}
+
+	template<typename T, size_t N>
+	ILINE auto FixedVector<T, N>::PushBack(T const& value) -> T& {
+		return this->EmplaceBack(value);
+	}
+
+	template<typename T, size_t N>
+	ILINE auto FixedVector<T, N>::PushBack(T&& value) -> T& {
+		return this->EmplaceBack(std::move(value));
+	}
+
+	template<typename T, size_t N>
+	ILINE auto FixedVector<T, N>::PopBack() noexcept -> void {
+		assert(m_Size > 0);
+		this->Data()[--m_Size].~T();
+	}
+
+	template<typename T, size_t N>
+	ILINE auto FixedVector<T, N>::Resize(size_t count) -> void {
+		if (count > N)
+			throw std::length_error("FixedVector is full");
+		while (m_Size < count)
+			this->EmplaceBack();
+		while (m_Size > count)
+			this->PopBack();
+	}
+
+	template<typename T, size_t N>
+	ILINE auto FixedVector<T, N>::Clear() noexcept -> void {
+		if constexpr (!std::is_trivially_destructible_v<T>)
+			for (auto index = size_t{ 0 }; index < m_Size; index++)
+				this->Data()[index].~T();
+		m_Size = 0;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] ILINE auto FixedVector<T, N>::operator[](size_t index) noexcept -> T& {
+		assert(index < m_Size);
+		return this->Data()[index];
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] ILINE auto FixedVector<T, N>::operator[](size_t index) const noexcept -> T const& {
+		assert(index < m_Size);
+		return this->Data()[index];
+	}
+
+}
\ No newline at end of file
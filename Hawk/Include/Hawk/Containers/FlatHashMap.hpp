@@ -0,0 +1,542 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <new>
+#include <tuple>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAWK_FLAT_HASH_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "../Common/Defines.hpp"
+#include "../Common/Hash.hpp"
+#include "../Memory/Utility.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/Hash.hpp>
+//#include <Hawk/Memory/Utility.hpp>
+
+namespace Hawk {
+
+	namespace Detail {
+
+		constexpr I8     ControlEmpty   = -128;
+		constexpr I8     ControlDeleted = -2;
+		constexpr size_t GroupWidth     = 16;
+
+		class GroupMask {
+		public:
+			explicit GroupMask(U32 mask) noexcept : m_Mask(mask) {}
+			explicit operator bool() const noexcept { return m_Mask != 0; }
+			auto Lowest() const noexcept -> U32;
+			auto Next() noexcept -> void { m_Mask &= m_Mask - 1; }
+		private:
+			U32 m_Mask;
+		};
+
+		// Sixteen control bytes examined at once: one compare finds every slot whose 7-bit tag matches
+		class Group {
+		public:
+			explicit Group(I8 const* control) noexcept;
+			auto Match(I8 tag)           const noexcept -> GroupMask;
+			auto MatchEmpty()            const noexcept -> GroupMask;
+			auto MatchEmptyOrDeleted()   const noexcept -> GroupMask;
+		private:
+#if defined(HAWK_FLAT_HASH_SSE2)
+			__m128i m_Control;
+#else
+			I8 m_Control[GroupWidth];
+#endif
+		};
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		class FlatHashTable {
+		public:
+			using Slot = TSlot;
+
+			template<typename TSlotRef, typename TTable>
+			class IteratorBase {
+			public:
+				IteratorBase(TTable* table, size_t index) noexcept : m_Table(table), m_Index(index) { this->SkipEmpty(); }
+				auto operator*()  const noexcept -> TSlotRef& { return m_Table->m_Slots[m_Index]; }
+				auto operator->() const noexcept -> TSlotRef* { return &m_Table->m_Slots[m_Index]; }
+				auto operator++() noexcept -> IteratorBase& { m_Index++; this->SkipEmpty(); return *this; }
+				auto operator==(IteratorBase const& rhs) const noexcept -> bool { return m_Index == rhs.m_Index; }
+				auto operator!=(IteratorBase const& rhs) const noexcept -> bool { return m_Index != rhs.m_Index; }
+			private:
+				auto SkipEmpty() noexcept -> void {
+					while (m_Index < m_Table->m_Capacity && m_Table->m_Control[m_Index] < 0)
+						m_Index++;
+				}
+				TTable* m_Table;
+				size_t  m_Index;
+			};
+
+			using Iterator      = IteratorBase<Slot, FlatHashTable>;
+			using ConstIterator = IteratorBase<Slot const, FlatHashTable const>;
+
+			FlatHashTable() noexcept = default;
+			FlatHashTable(FlatHashTable const& rhs);
+			FlatHashTable(FlatHashTable&& rhs) noexcept;
+			~FlatHashTable();
+
+			auto operator=(FlatHashTable const& rhs) -> FlatHashTable&;
+			auto operator=(FlatHashTable&& rhs) noexcept -> FlatHashTable&;
+
+			template<typename Q> auto Find(Q const& key)       noexcept -> Slot*;
+			template<typename Q> auto Find(Q const& key) const noexcept -> Slot const*;
+			template<typename Q, typename... Args> auto TryEmplace(Q&& key, Args&&... args) -> std::pair<Slot*, bool>;
+			template<typename Q> auto Erase(Q const& key) -> bool;
+
+			auto Clear()    noexcept -> void;
+			auto Reserve(size_t count) -> void;
+
+			auto Size()     const noexcept -> size_t { return m_Size; }
+			auto Capacity() const noexcept -> size_t { return m_Capacity; }
+			auto IsEmpty()  const noexcept -> bool { return m_Size == 0; }
+
+			auto begin()       noexcept -> Iterator { return Iterator{ this, 0 }; }
+			auto end()         noexcept -> Iterator { return Iterator{ this, m_Capacity }; }
+			auto begin() const noexcept -> ConstIterator { return ConstIterator{ this, 0 }; }
+			auto end()   const noexcept -> ConstIterator { return ConstIterator{ this, m_Capacity }; }
+
+		private:
+			static auto MaxLoad(size_t capacity) noexcept -> size_t { return capacity - capacity / 8; }
+
+			template<typename Q> auto Hash(Q const& key) const noexcept -> U64 { return static_cast<U64>(THash{}(key)); }
+			template<typename Q> auto FindIndex(Q const& key, U64 hash) const noexcept -> size_t;
+			auto FindInsertIndex(U64 hash) const noexcept -> size_t;
+			auto SetControl(size_t index, I8 value) noexcept -> void;
+			auto Rehash(size_t capacity) -> void;
+			auto Destroy() noexcept -> void;
+
+			Memory::AlignedBuffer m_Memory{ nullptr, Memory::AlignedDeleter{ 1 } };
+			I8*                   m_Control = nullptr;
+			Slot*                 m_Slots = nullptr;
+			size_t                m_Capacity = 0;
+			size_t                m_Size = 0;
+			size_t                m_GrowthLeft = 0;
+		};
+
+		template<typename K, typename V>
+		struct MapKeyOf {
+			static auto Get(std::pair<K, V> const& slot) noexcept -> K const& { return slot.first; }
+			template<typename Q, typename... Args>
+			static auto Construct(void* slot, Q&& key, Args&&... args) -> void {
+				new (slot) std::pair<K, V>(std::piecewise_construct, std::forward_as_tuple(std::forward<Q>(key)), std::forward_as_tuple(std::forward<Args>(args)...));
+			}
+		};
+
+		template<typename K>
+		struct SetKeyOf {
+			static auto Get(K const& slot) noexcept -> K const& { return slot; }
+			template<typename Q>
+			static auto Construct(void* slot, Q&& key) -> void { new (slot) K(std::forward<Q>(key)); }
+		};
+
+	}
+
+	// Swiss-table style open-addressing map. Control bytes hold a 7-bit tag of each key's hash and are probed
+	// sixteen at a time, so a lookup usually touches one control group and one slot. Keys and values live
+	// inline in a single allocation. Any key type accepted by a transparent hasher and equality can be used
+	// for lookup without building a K. Pointers into the map are invalidated by insertion.
+	template<typename K, typename V, typename THash = Hasher<K>, typename TEqual = std::equal_to<>>
+	class FlatHashMap {
+	public:
+		using Table         = Detail::FlatHashTable<std::pair<K, V>, Detail::MapKeyOf<K, V>, THash, TEqual>;
+		using Iterator      = typename Table::Iterator;
+		using ConstIterator = typename Table::ConstIterator;
+
+		template<typename Q> auto Find(Q const& key)       noexcept -> V*;
+		template<typename Q> auto Find(Q const& key) const noexcept -> V const*;
+		template<typename Q> auto Contains(Q const& key) const noexcept -> bool;
+
+		template<typename Q, typename... Args> auto TryEmplace(Q&& key, Args&&... args) -> std::pair<V*, bool>;
+		template<typename Q, typename U> auto InsertOrAssign(Q&& key, U&& value) -> std::pair<V*, bool>;
+		template<typename Q> auto operator[](Q&& key) -> V&;
+		template<typename Q> auto Erase(Q const& key) -> bool;
+
+		auto Clear() noexcept -> void { m_Table.Clear(); }
+		auto Reserve(size_t count) -> void { m_Table.Reserve(count); }
+		auto Size()     const noexcept -> size_t { return m_Table.Size(); }
+		auto Capacity() const noexcept -> size_t { return m_Table.Capacity(); }
+		auto IsEmpty()  const noexcept -> bool { return m_Table.IsEmpty(); }
+
+		auto begin()       noexcept -> Iterator { return m_Table.begin(); }
+		auto end()         noexcept -> Iterator { return m_Table.end(); }
+		auto begin() const noexcept -> ConstIterator { return m_Table.begin(); }
+		auto end()   const noexcept -> ConstIterator { return m_Table.end(); }
+
+	private:
+		Table m_Table;
+	};
+
+	template<typename K, typename THash = Hasher<K>, typename TEqual = std::equal_to<>>
+	class FlatHashSet {
+	public:
+		using Table         = Detail::FlatHashTable<K, Detail::SetKeyOf<K>, THash, TEqual>;
+		using Iterator      = typename Table::ConstIterator;
+		using ConstIterator = typename Table::ConstIterator;
+
+		template<typename Q> auto Contains(Q const& key) const noexcept -> bool;
+		template<typename Q> auto Insert(Q&& key) -> bool;
+		template<typename Q> auto Erase(Q const& key) -> bool;
+
+		auto Clear() noexcept -> void { m_Table.Clear(); }
+		auto Reserve(size_t count) -> void { m_Table.Reserve(count); }
+		auto Size()     const noexcept -> size_t { return m_Table.Size(); }
+		auto Capacity() const noexcept -> size_t { return m_Table.Capacity(); }
+		auto IsEmpty()  const noexcept -> bool { return m_Table.IsEmpty(); }
+
+		auto begin() const noexcept -> ConstIterator { return m_Table.begin(); }
+		auto end()   const noexcept -> ConstIterator { return m_Table.end(); }
+
+	private:
+		Table m_Table;
+	};
+
+}
+
+namespace Hawk {
+
+	namespace Detail {
+
+		[[nodiscard]] ILINE auto GroupMask::Lowest() const noexcept -> U32 {
+#if defined(_MSC_VER)
+			unsigned long index;
+			_BitScanForward(&index, m_Mask);
+			return static_cast<U32>(index);
+#else
+			return static_cast<U32>(__builtin_ctz(m_Mask));
+#endif
+		}
+
+#if defined(HAWK_FLAT_HASH_SSE2)
+
+		ILINE Group::Group(I8 const* control) noexcept
+			: m_Control(_mm_loadu_si128(reinterpret_cast<__m128i const*>(control))) {}
+
+		[[nodiscard]] ILINE auto Group::Match(I8 tag) const noexcept -> GroupMask {
+			return GroupMask{ static_cast<U32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(tag), m_Control))) };
+		}
+
+		[[nodiscard]] ILINE auto Group::MatchEmpty() const noexcept -> GroupMask {
+			return GroupMask{ static_cast<U32>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(ControlEmpty), m_Control))) };
+		}
+
+		// Empty and deleted bytes are the only ones with the sign bit set
+		[[nodiscard]] ILINE auto Group::MatchEmptyOrDeleted() const noexcept -> GroupMask {
+			return GroupMask{ static_cast<U32>(_mm_movemask_epi8(m_Control)) };
+		}
+
+#else
+
+		ILINE Group::Group(I8 const* control) noexcept {
+			std::memcpy(m_Control, control, GroupWidth);
+		}
+
+		[[nodiscard]] ILINE auto Group::Match(I8 tag) const noexcept -> GroupMask {
+			auto mask = 0u;
+			for (auto index = 0u; index < GroupWidth; index++)
+				mask |= static_cast<U32>(m_Control[index] == tag) << index;
+			return GroupMask{ mask };
+		}
+
+		[[nodiscard]] ILINE auto Group::MatchEmpty() const noexcept -> GroupMask {
+			return this->Match(ControlEmpty);
+		}
+
+		[[nodiscard]] ILINE auto Group::MatchEmptyOrDeleted() const noexcept -> GroupMask {
+			auto mask = 0u;
+			for (auto index = 0u; index < GroupWidth; index++)
+				mask |= static_cast<U32>(m_Control[index] < 0) << index;
+			return GroupMask{ mask };
+		}
+
+#endif
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		ILINE FlatHashTable<TSlot, TKeyOf, THash, TEqual>::FlatHashTable(FlatHashTable const& rhs) {
+			this->Reserve(rhs.m_Size);
+			for (auto const& e : rhs) {
+				auto const hash = this->Hash(TKeyOf::Get(e));
+				auto const index = this->FindInsertIndex(hash);
+				new (&m_Slots[index]) TSlot(e);
+				this->SetControl(index, static_cast<I8>(hash & 0x7F));
+				m_GrowthLeft--;
+				m_Size++;
+			}
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		ILINE FlatHashTable<TSlot, TKeyOf, THash, TEqual>::FlatHashTable(FlatHashTable&& rhs) noexcept
+			: m_Memory(std::move(rhs.m_Memory))
+			, m_Control(std::exchange(rhs.m_Control, nullptr))
+			, m_Slots(std::exchange(rhs.m_Slots, nullptr))
+			, m_Capacity(std::exchange(rhs.m_Capacity, 0))
+			, m_Size(std::exchange(rhs.m_Size, 0))
+			, m_GrowthLeft(std::exchange(rhs.m_GrowthLeft, 0)) {}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		ILINE FlatHashTable<TSlot, TKeyOf, THash, TEqual>::~FlatHashTable() {
+			this->Destroy();
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::operator=(FlatHashTable const& rhs) -> FlatHashTable& {
+			if (this != &rhs) {
+				auto copy = FlatHashTable{ rhs };
+				*this = std::move(copy);
+			}
+			return *this;
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::operator=(FlatHashTable&& rhs) noexcept -> FlatHashTable& {
+			if (this != &rhs) {
+				this->Destroy();
+				m_Memory = std::move(rhs.m_Memory);
+				m_Control = std::exchange(rhs.m_Control, nullptr);
+				m_Slots = std::exchange(rhs.m_Slots, nullptr);
+				m_Capacity = std::exchange(rhs.m_Capacity, 0);
+				m_Size = std::exchange(rhs.m_Size, 0);
+				m_GrowthLeft = std::exchange(rhs.m_GrowthLeft, 0);
+			}
+			return *this;
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		template<typename Q>
+		[[nodiscard]] ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::Find(Q const& key) noexcept -> Slot* {
+			auto const index = this->FindIndex(key, this->Hash(key));
+			return index != m_Capacity ? &m_Slots[index] : nullptr;
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		template<typename Q>
+		[[nodiscard]] ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::Find(Q const& key) const noexcept -> Slot const* {
+			auto const index = this->FindIndex(key, this->Hash(key));
+			return index != m_Capacity ? &m_Slots[index] : nullptr;
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		template<typename Q, typename... Args>
+		ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::TryEmplace(Q&& key, Args&&... args) -> std::pair<Slot*, bool> {
+			auto const hash = this->Hash(key);
+			auto index = this->FindIndex(key, hash);
+			if (index != m_Capacity)
+				return { &m_Slots[index], false };
+
+			index = this->FindInsertIndex(hash);
+			if (m_GrowthLeft == 0 && (m_Capacity == 0 || m_Control[index] == ControlEmpty)) {
+				// Tombstones are dropped by rehashing in place; the table only doubles when it is really full
+				this->Rehash(m_Size + 1 > MaxLoad(m_Capacity) / 2 ? (std::max)(m_Capacity * 2, GroupWidth) : m_Capacity);
+				index = this->FindInsertIndex(hash);
+			}
+
+			TKeyOf::Construct(&m_Slots[index], std::forward<Q>(key), std::forward<Args>(args)...);
+			if (m_Control[index] == ControlEmpty)
+				m_GrowthLeft--;
+			this->SetControl(index, static_cast<I8>(hash & 0x7F));
+			m_Size++;
+			return { &m_Slots[index], true };
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		template<typename Q>
+		ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::Erase(Q const& key) -> bool {
+			auto const index = this->FindIndex(key, this->Hash(key));
+			if (index == m_Capacity)
+				return false;
+
+			m_Slots[index].~TSlot();
+			this->SetControl(index, ControlDeleted);
+			m_Size--;
+			return true;
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::Clear() noexcept -> void {
+			for (auto index = size_t{ 0 }; index < m_Capacity; index++)
+				if (m_Control[index] >= 0)
+					m_Slots[index].~TSlot();
+			if (m_Capacity > 0)
+				std::memset(m_Control, ControlEmpty, m_Capacity + GroupWidth);
+			m_Size = 0;
+			m_GrowthLeft = MaxLoad(m_Capacity);
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::Reserve(size_t count) -> void {
+			auto capacity = GroupWidth;
+			while (MaxLoad(capacity) < count)
+				capacity *= 2;
+			if (capacity > m_Capacity)
+				this->Rehash(capacity);
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		template<typename Q>
+		[[nodiscard]] ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::FindIndex(Q const& key, U64 hash) const noexcept -> size_t {
+			if (m_Capacity == 0)
+				return m_Capacity;
+
+			auto const mask = m_Capacity - 1;
+			auto const tag = static_cast<I8>(hash & 0x7F);
+			auto position = static_cast<size_t>(hash >> 7) & mask;
+			for (auto stride = GroupWidth; ; stride += GroupWidth) {
+				auto const group = Group{ m_Control + position };
+				for (auto match = group.Match(tag); match; match.Next()) {
+					auto const index = (position + match.Lowest()) & mask;
+					if (TEqual{}(TKeyOf::Get(m_Slots[index]), key))
+						return index;
+				}
+				if (group.MatchEmpty())
+					return m_Capacity;
+				position = (position + stride) & mask;
+			}
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		[[nodiscard]] ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::FindInsertIndex(U64 hash) const noexcept -> size_t {
+			if (m_Capacity == 0)
+				return 0;
+
+			auto const mask = m_Capacity - 1;
+			auto position = static_cast<size_t>(hash >> 7) & mask;
+			for (auto stride = GroupWidth; ; stride += GroupWidth) {
+				auto const match = Group{ m_Control + position }.MatchEmptyOrDeleted();
+				if (match)
+					return (position + match.Lowest()) & mask;
+				position = (position + stride) & mask;
+			}
+		}
+
+		// The first GroupWidth control bytes are mirrored past the end, so a group can be loaded at any index
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::SetControl(size_t index, I8 value) noexcept -> void {
+			m_Control[index] = value;
+			if (index < GroupWidth)
+				m_Control[m_Capacity + index] = value;
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::Rehash(size_t capacity) -> void {
+			assert(Memory::IsPowerOfTwo(capacity) && capacity >= GroupWidth && MaxLoad(capacity) >= m_Size);
+
+			auto const alignment = (std::max)(alignof(TSlot), size_t{ HAWK_CACHE_LINE_SIZE });
+			auto const controlSize = Memory::AlignUp(capacity + GroupWidth, alignment);
+			auto memory = Memory::AllocateAligned(controlSize + capacity * sizeof(TSlot), alignment);
+
+			auto oldMemory = std::move(m_Memory);
+			auto* oldControl = m_Control;
+			auto* oldSlots = m_Slots;
+			auto const oldCapacity = m_Capacity;
+
+			m_Memory = std::move(memory);
+			m_Control = reinterpret_cast<I8*>(m_Memory.get());
+			m_Slots = reinterpret_cast<TSlot*>(m_Memory.get() + controlSize);
+			m_Capacity = capacity;
+			m_GrowthLeft = MaxLoad(capacity) - m_Size;
+			std::memset(m_Control, ControlEmpty, capacity + GroupWidth);
+
+			for (auto index = size_t{ 0 }; index < oldCapacity; index++) {
+				if (oldControl[index] < 0)
+					continue;
+				auto const hash = this->Hash(TKeyOf::Get(oldSlots[index]));
+				auto const target = this->FindInsertIndex(hash);
+				new (&m_Slots[target]) TSlot(std::move(oldSlots[index]));
+				oldSlots[index].~TSlot();
+				this->SetControl(target, static_cast<I8>(hash & 0x7F));
+			}
+		}
+
+		template<typename TSlot, typename TKeyOf, typename THash, typename TEqual>
+		ILINE auto FlatHashTable<TSlot, TKeyOf, THash, TEqual>::Destroy() noexcept -> void {
+			for (auto index = size_t{ 0 }; index < m_Capacity; index++)
+				if (m_Control[index] >= 0)
+					m_Slots[index].~TSlot();
+			m_Memory.reset();
+			m_Control = nullptr;
+			m_Slots = nullptr;
+			m_Capacity = 0;
+			m_Size = 0;
+			m_GrowthLeft = 0;
+		}
+
+	}
+
+	template<typename K, typename V, typename THash, typename TEqual>
+	template<typename Q>
+	[[nodiscard]] ILINE auto FlatHashMap<K, V, THash, TEqual>::Find(Q const& key) noexcept -> V* {
+		auto* slot = m_Table.Find(key);
+		return slot ? &slot->second : nullptr;
+	}
+
+	template<typename K, typename V, typename THash, typename TEqual>
+	template<typename Q>
+	[[nodiscard]] ILINE auto FlatHashMap<K, V, THash, TEqual>::Find(Q const& key) const noexcept -> V const* {
+		auto const* slot = m_Table.Find(key);
+		return slot ? &slot->second : nullptr;
+	}
+
+	template<typename K, typename V, typename THash, typename TEqual>
+	template<typename Q>
+	[[nodiscard]] ILINE auto FlatHashMap<K, V, THash, TEqual>::Contains(Q const& key) const noexcept -> bool {
+		return m_Table.Find(key) != nullptr;
+	}
+
+	template<typename K, typename V, typename THash, typename TEqual>
+	template<typename Q, typename... Args>
+	ILINE auto FlatHashMap<K, V, THash, TEqual>::TryEmplace(Q&& key, Args&&... args) -> std::pair<V*, bool> {
+		auto const [slot, isInserted] = m_Table.TryEmplace(std::forward<Q>(key), std::forward<Args>(args)...);
+		return { &slot->second, isInserted };
+	}
+
+	template<typename K, typename V, typename THash, typename TEqual>
+	template<typename Q, typename U>
+	ILINE auto FlatHashMap<K, V, THash, TEqual>::InsertOrAssign(Q&& key, U&& value) -> std::pair<V*, bool> {
+		auto result = this->TryEmplace(std::forward<Q>(key), std::forward<U>(value));
+		if (!result.second)
+			*result.first = std::forward<U>(value);
+		return result;
+	}
+
+	template<typename K, typename V, typename THash, typename TEqual>
+	template<typename Q>
+	ILINE auto FlatHashMap<K, V, THash, TEqual>::operator[](Q&& key) -> V& {
+		return *this->TryEmplace(std::forward<Q>(key)).first;
+	}
+
+	template<typename K, typename V, typename THash, typename TEqual>
+	template<typename Q>
+	ILINE auto FlatHashMap<K, V, THash, TEqual>::Erase(Q const& key) -> bool {
+		return m_Table.Erase(key);
+	}
+
+	template<typename K, typename THash, typename TEqual>
+	template<typename Q>
+	[[nodiscard]] ILINE auto FlatHashSet<K, THash, TEqual>::Contains(Q const& key) const noexcept -> bool {
+		return m_Table.Find(key) != nullptr;
+	}
+
+	template<typename K, typename THash, typename TEqual>
+	template<typename Q>
+	ILINE auto FlatHashSet<K, THash, TEqual>::Insert(Q&& key) -> bool {
+		return m_Table.TryEmplace(std::forward<Q>(key)).second;
+	}
+
+	template<typename K, typename THash, typename TEqual>
+	template<typename Q>
+	ILINE auto FlatHashSet<K, THash, TEqual>::Erase(Q const& key) -> bool {
+		return m_Table.Erase(key);
+	}
+
+}
\ No newline at end of file
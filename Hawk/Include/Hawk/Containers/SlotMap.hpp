@@ -0,0 +1,309 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+
+namespace Hawk {
+
+	// Packs a slot index and a generation into one integer. A handle whose generation no longer matches
+	// its slot refers to an erased element and is rejected by the owning SlotMap.
+	template<typename U, U32 IndexBits>
+	class GenerationalHandle {
+		static_assert(std::is_unsigned_v<U> && IndexBits > 0 && IndexBits < sizeof(U) * 8, "Invalid handle layout");
+	public:
+		using ValueType = U;
+
+		static constexpr U32 CountIndexBits      = IndexBits;
+		static constexpr U32 CountGenerationBits = sizeof(U) * 8 - IndexBits;
+		static constexpr U   MaxIndex            = (U{ 1 } << IndexBits) - 1;
+		static constexpr U   MaxGeneration       = (U{ 1 } << CountGenerationBits) - 1;
+
+		constexpr GenerationalHandle() noexcept;
+		constexpr GenerationalHandle(U index, U generation) noexcept;
+
+		constexpr auto Index()      const noexcept -> U;
+		constexpr auto Generation() const noexcept -> U;
+		constexpr auto Value()      const noexcept -> U;
+		constexpr auto IsValid()    const noexcept -> bool;
+
+		constexpr auto operator==(GenerationalHandle rhs) const noexcept -> bool;
+		constexpr auto operator!=(GenerationalHandle rhs) const noexcept -> bool;
+
+	private:
+		U m_Value;
+	};
+
+	using Handle32 = GenerationalHandle<U32, 20>;
+	using Handle64 = GenerationalHandle<U64, 32>;
+
+	// Dense storage addressed through generational handles: values are packed for iteration and moved on erase,
+	// while the handle keeps pointing at the same element through a slot indirection.
+	template<typename T, typename THandle = Handle32>
+	class SlotMap {
+	public:
+		using Handle   = THandle;
+		using Iterator = typename std::vector<T>::iterator;
+		using ConstIterator = typename std::vector<T>::const_iterator;
+
+		SlotMap() = default;
+
+		template<typename... Args>
+		auto Emplace(Args&&... args) -> Handle;
+		auto Insert(T const& value) -> Handle;
+		auto Insert(T&& value) -> Handle;
+		auto Erase(Handle handle) -> bool;
+		auto Clear() noexcept -> void;
+		auto Reserve(size_t capacity) -> void;
+
+		auto Get(Handle handle)       noexcept -> T*;
+		auto Get(Handle handle) const noexcept -> T const*;
+		auto Contains(Handle handle) const noexcept -> bool;
+
+		auto operator[](Handle handle)       noexcept -> T&;
+		auto operator[](Handle handle) const noexcept -> T const&;
+
+		auto HandleAt(size_t denseIndex) const noexcept -> Handle;
+		auto Data()       noexcept -> T*;
+		auto Data() const noexcept -> T const*;
+		auto Size()    const noexcept -> size_t;
+		auto IsEmpty() const noexcept -> bool;
+
+		auto begin()       noexcept -> Iterator;
+		auto end()         noexcept -> Iterator;
+		auto begin() const noexcept -> ConstIterator;
+		auto end()   const noexcept -> ConstIterator;
+
+	private:
+		using U = typename Handle::ValueType;
+
+		static constexpr U32 InvalidIndex = ~U32{ 0 };
+
+		struct Slot {
+			U32 DenseIndex;
+			U32 Generation;
+		};
+
+		auto AllocateSlot() -> U32;
+		auto FindDenseIndex(Handle handle) const noexcept -> U32;
+
+		std::vector<T>    m_Values;
+		std::vector<U32>  m_DenseToSlot;
+		std::vector<Slot> m_Slots;
+		U32               m_FreeHead = InvalidIndex;
+	};
+
+}
+
+namespace Hawk {
+
+	template<typename U, U32 IndexBits>
+	ILINE constexpr GenerationalHandle<U, IndexBits>::GenerationalHandle() noexcept
+		: m_Value(~U{ 0 }) {}
+
+	template<typename U, U32 IndexBits>
+	ILINE constexpr GenerationalHandle<U, IndexBits>::GenerationalHandle(U index, U generation) noexcept
+		: m_Value((generation << IndexBits) | (index & MaxIndex)) {}
+
+	template<typename U, U32 IndexBits>
+	[[nodiscard]] ILINE constexpr auto GenerationalHandle<U, IndexBits>::Index() const noexcept -> U {
+		return m_Value & MaxIndex;
+	}
+
+	template<typename U, U32 IndexBits>
+	[[nodiscard]] ILINE constexpr auto GenerationalHandle<U, IndexBits>::Generation() const noexcept -> U {
+		return m_Value >> IndexBits;
+	}
+
+	template<typename U, U32 IndexBits>
+	[[nodiscard]] ILINE constexpr auto GenerationalHandle<U, IndexBits>::Value() const noexcept -> U {
+		return m_Value;
+	}
+
+	template<typename U, U32 IndexBits>
+	[[nodiscard]] ILINE constexpr auto GenerationalHandle<U, IndexBits>::IsValid() const noexcept -> bool {
+		return m_Value != ~U{ 0 };
+	}
+
+	template<typename U, U32 IndexBits>
+	[[nodiscard]] ILINE constexpr auto GenerationalHandle<U, IndexBits>::operator==(GenerationalHandle rhs) const noexcept -> bool {
+		return m_Value == rhs.m_Value;
+	}
+
+	template<typename U, U32 IndexBits>
+	[[nodiscard]] ILINE constexpr auto GenerationalHandle<U, IndexBits>::operator!=(GenerationalHandle rhs) const noexcept -> bool {
+		return m_Value != rhs.m_Value;
+	}
+
+	template<typename T, typename THandle>
+	template<typename... Args>
+	ILINE auto SlotMap<T, THandle>::Emplace(Args&&... args) -> Handle {
+		auto const denseIndex = static_cast<U32>(m_Values.size());
+		m_Values.emplace_back(std::forward<Args>(args)...);
+
+		auto const slotIndex = this->AllocateSlot();
+		m_Slots[slotIndex].DenseIndex = denseIndex;
+		m_DenseToSlot.push_back(slotIndex);
+		return Handle{ static_cast<U>(slotIndex), static_cast<U>(m_Slots[slotIndex].Generation) };
+	}
+
+	template<typename T, typename THandle>
+	ILINE auto SlotMap<T, THandle>::Insert(T const& value) -> Handle {
+		return this->Emplace(value);
+	}
+
+	template<typename T, typename THandle>
+	ILINE auto SlotMap<T, THandle>::Insert(T&& value) -> Handle {
+		return this->Emplace(std::move(value));
+	}
+
+	template<typename T, typename THandle>
+	ILINE auto SlotMap<T, THandle>::Erase(Handle handle) -> bool {
+		auto const denseIndex = this->FindDenseIndex(handle);
+		if (denseIndex == InvalidIndex)
+			return false;
+
+		// Swap-remove keeps the values dense; the moved element's slot is redirected to its new position
+		auto const lastIndex = static_cast<U32>(m_Values.size() - 1);
+		if (denseIndex != lastIndex) {
+			m_Values[denseIndex] = std::move(m_Values[lastIndex]);
+			m_DenseToSlot[denseIndex] = m_DenseToSlot[lastIndex];
+			m_Slots[m_DenseToSlot[denseIndex]].DenseIndex = denseIndex;
+		}
+		m_Values.pop_back();
+		m_DenseToSlot.pop_back();
+
+		// A slot whose generation is exhausted is retired instead of recycled, so stale handles never alias.
+		// Free slots reuse DenseIndex as the link of the free list.
+		auto const slotIndex = static_cast<U32>(handle.Index());
+		auto& slot = m_Slots[slotIndex];
+		slot.Generation++;
+		slot.DenseIndex = InvalidIndex;
+		if (slot.Generation < static_cast<U32>(Handle::MaxGeneration)) {
+			slot.DenseIndex = m_FreeHead;
+			m_FreeHead = slotIndex;
+		}
+		return true;
+	}
+
+	template<typename T, typename THandle>
+	ILINE auto SlotMap<T, THandle>::Clear() noexcept -> void {
+		while (!m_Values.empty())
+			this->Erase(this->HandleAt(m_Values.size() - 1));
+	}
+
+	template<typename T, typename THandle>
+	ILINE auto SlotMap<T, THandle>::Reserve(size_t capacity) -> void {
+		m_Values.reserve(capacity);
+		m_DenseToSlot.reserve(capacity);
+		m_Slots.reserve(capacity);
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::Get(Handle handle) noexcept -> T* {
+		auto const denseIndex = this->FindDenseIndex(handle);
+		return denseIndex != InvalidIndex ? &m_Values[denseIndex] : nullptr;
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::Get(Handle handle) const noexcept -> T const* {
+		auto const denseIndex = this->FindDenseIndex(handle);
+		return denseIndex != InvalidIndex ? &m_Values[denseIndex] : nullptr;
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::Contains(Handle handle) const noexcept -> bool {
+		return this->FindDenseIndex(handle) != InvalidIndex;
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::operator[](Handle handle) noexcept -> T& {
+		auto const denseIndex = this->FindDenseIndex(handle);
+		assert(denseIndex != InvalidIndex && "Stale or invalid handle");
+		return m_Values[denseIndex];
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::operator[](Handle handle) const noexcept -> T const& {
+		auto const denseIndex = this->FindDenseIndex(handle);
+		assert(denseIndex != InvalidIndex && "Stale or invalid handle");
+		return m_Values[denseIndex];
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::HandleAt(size_t denseIndex) const noexcept -> Handle {
+		assert(denseIndex < m_Values.size());
+		auto const slotIndex = m_DenseToSlot[denseIndex];
+		return Handle{ static_cast<U>(slotIndex), static_cast<U>(m_Slots[slotIndex].Generation) };
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::Data() noexcept -> T* {
+		return m_Values.data();
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::Data() const noexcept -> T const* {
+		return m_Values.data();
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::Size() const noexcept -> size_t {
+		return m_Values.size();
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::IsEmpty() const noexcept -> bool {
+		return m_Values.empty();
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::begin() noexcept -> Iterator {
+		return m_Values.begin();
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::end() noexcept -> Iterator {
+		return m_Values.end();
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::begin() const noexcept -> ConstIterator {
+		return m_Values.begin();
+	}
+
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::end() const noexcept -> ConstIterator {
+		return m_Values.end();
+	}
+
+	template<typename T, typename THandle>
+	ILINE auto SlotMap<T, THandle>::AllocateSlot() -> U32 {
+		if (m_FreeHead != InvalidIndex) {
+			auto const slotIndex = m_FreeHead;
+			m_FreeHead = m_Slots[slotIndex].DenseIndex;
+			return slotIndex;
+		}
+
+		assert(m_Slots.size() <= static_cast<size_t>(Handle::MaxIndex) && "SlotMap is out of handle indices");
+		m_Slots.push_back(Slot{ InvalidIndex, 0 });
+		return static_cast<U32>(m_Slots.size() - 1);
+	}
+
+	// The dense-to-slot back reference also rejects handles that point at a free slot with a matching generation
+	template<typename T, typename THandle>
+	[[nodiscard]] ILINE auto SlotMap<T, THandle>::FindDenseIndex(Handle handle) const noexcept -> U32 {
+		auto const slotIndex = static_cast<size_t>(handle.Index());
+		if (!handle.IsValid() || slotIndex >= m_Slots.size())
+			return InvalidIndex;
+
+		auto const& slot = m_Slots[slotIndex];
+		if (slot.Generation != static_cast<U32>(handle.Generation()) || slot.DenseIndex >= m_DenseToSlot.size())
+			return InvalidIndex;
+		return m_DenseToSlot[slot.DenseIndex] == slotIndex ? slot.DenseIndex : InvalidIndex;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,236 @@
+#pragma once
+
+#include <algorithm>
+#include <initializer_list>
+#include <new>
+#include <utility>
+
+#include "../Common/Defines.hpp"
+#include "../Memory/Utility.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Memory/Utility.hpp>
+
+namespace Hawk {
+
+	// Vector that keeps up to N elements inline and spills to the heap beyond that. The inline buffer is addressed
+	// through the capacity rather than a self-pointer, so the container itself is trivially relocatable whenever
+	// T is, and growth relocates elements with memcpy in that case.
+	template<typename T, size_t N>
+	class SmallVector {
+		static_assert(N > 0, "SmallVector needs inline capacity");
+	public:
+		using Iterator      = T*;
+		using ConstIterator = T const*;
+
+		SmallVector() noexcept = default;
+		SmallVector(std::initializer_list<T> values);
+		SmallVector(SmallVector const& rhs);
+		SmallVector(SmallVector&& rhs) noexcept;
+		~SmallVector();
+
+		auto operator=(SmallVector const& rhs) -> SmallVector&;
+		auto operator=(SmallVector&& rhs) noexcept -> SmallVector&;
+
+		template<typename... Args>
+		auto EmplaceBack(Args&&... args) -> T&;
+		auto PushBack(T const& value) -> T&;
+		auto PushBack(T&& value) -> T&;
+		auto PopBack() noexcept -> void;
+		auto Resize(size_t count) -> void;
+		auto Reserve(size_t count) -> void;
+		auto Clear() noexcept -> void;
+
+		auto operator[](size_t index)       noexcept -> T&;
+		auto operator[](size_t index) const noexcept -> T const&;
+
+		auto Data()           noexcept -> T*;
+		auto Data()     const noexcept -> T const*;
+		auto Size()     const noexcept -> size_t { return m_Size; }
+		auto Capacity() const noexcept -> size_t { return m_Capacity; }
+		auto IsEmpty()  const noexcept -> bool { return m_Size == 0; }
+		auto IsInline() const noexcept -> bool { return m_Capacity == N; }
+
+		auto begin()       noexcept -> Iterator { return this->Data(); }
+		auto end()         noexcept -> Iterator { return this->Data() + m_Size; }
+		auto begin() const noexcept -> ConstIterator { return this->Data(); }
+		auto end()   const noexcept -> ConstIterator { return this->Data() + m_Size; }
+
+	private:
+		auto Grow(size_t count) -> void;
+		auto Release() noexcept -> void;
+
+		union {
+			T*            m_Heap;
+			alignas(T) U8 m_Inline[sizeof(T) * N];
+		};
+		size_t m_Size = 0;
+		size_t m_Capacity = N;
+	};
+
+	namespace Memory {
+
+		template<typename T, size_t N>
+		struct IsTriviallyRelocatable<SmallVector<T, N>> : IsTriviallyRelocatable<T> {};
+
+	}
+
+}
+
+namespace Hawk {
+
+	template<typename T, size_t N>
+	ILINE SmallVector<T, N>::SmallVector(std::initializer_list<T> values) {
+		this->Reserve(values.size());
+		for (auto const& e : values)
+			this->EmplaceBack(e);
+	}
+
+	template<typename T, size_t N>
+	ILINE SmallVector<T, N>::SmallVector(SmallVector const& rhs) {
+		this->Reserve(rhs.m_Size);
+		for (auto const& e : rhs)
+			this->EmplaceBack(e);
+	}
+
+	template<typename T, size_t N>
+	ILINE SmallVector<T, N>::SmallVector(SmallVector&& rhs) noexcept {
+		if (rhs.IsInline()) {
+			Memory::Relocate(this->Data(), rhs.Data(), rhs.m_Size);
+		} else {
+			m_Heap = rhs.m_Heap;
+			m_Capacity = rhs.m_Capacity;
+			rhs.m_Capacity = N;
+		}
+		m_Size = std::exchange(rhs.m_Size, 0);
+	}
+
+	template<typename T, size_t N>
+	ILINE SmallVector<T, N>::~SmallVector() {
+		this->Release();
+	}
+
+	template<typename T, size_t N>
+	ILINE auto SmallVector<T, N>::operator=(SmallVector const& rhs) -> SmallVector& {
+		if (this != &rhs) {
+			this->Clear();
+			this->Reserve(rhs.m_Size);
+			for (auto const& e : rhs)
+				this->EmplaceBack(e);
+		}
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	ILINE auto SmallVector<T, N>::operator=(SmallVector&& rhs) noexcept -> SmallVector& {
+		if (this != &rhs) {
+			this->Release();
+			if (rhs.IsInline()) {
+				Memory::Relocate(this->Data(), rhs.Data(), rhs.m_Size);
+			} else {
+				m_Heap = rhs.m_Heap;
+				m_Capacity = rhs.m_Capacity;
+				rhs.m_Capacity = N;
+			}
+			m_Size = std::exchange(rhs.m_Size, 0);
+		}
+		return *this;
+	}
+
+	template<typename T, size_t N>
+	template<typename... Args>
+	ILINE auto SmallVector<T, N>::EmplaceBack(Args&&... args) -> T& {
+		if (m_Size == m_Capacity) {
+			// The argument may alias an element, so build it before the buffer moves
+			auto value = T(std::forward<Args>(args)...);
+			this->Grow(m_Size + 1);
+			auto* element = new (this->Data() + m_Size) T(std::move(value));
+			m_Size++;
+			return *element;
+		}
+		auto* element = new (this->Data() + m_Size) T(std::forward<Args>(args)...);
+		m_Size++;
+		return *element;
+	}
+
+	template<typename T, size_t N>
+	ILINE auto SmallVector<T, N>::PushBack(T const& value) -> T& {
+		return this->EmplaceBack(value);
+	}
+
+	template<typename T, size_t N>
+	ILINE auto SmallVector<T, N>::PushBack(T&& value) -> T& {
+		return this->EmplaceBack(std::move(value));
+	}
+
+	template<typename T, size_t N>
+	ILINE auto SmallVector<T, N>::PopBack() noexcept -> void {
+		assert(m_Size > 0);
+		this->Data()[--m_Size].~T();
+	}
+
+	template<typename T, size_t N>
+	ILINE auto SmallVector<T, N>::Resize(size_t count) -> void {
+		this->Reserve(count);
+		while (m_Size < count)
+			this->EmplaceBack();
+		while (m_Size > count)
+			this->PopBack();
+	}
+
+	template<typename T, size_t N>
+	ILINE auto SmallVector<T, N>::Reserve(size_t count) -> void {
+		if (count > m_Capacity)
+			this->Grow(count);
+	}
+
+	template<typename T, size_t N>
+	ILINE auto SmallVector<T, N>::Clear() noexcept -> void {
+		if constexpr (!std::is_trivially_destructible_v<T>)
+			for (auto index = size_t{ 0 }; index < m_Size; index++)
+				this->Data()[index].~T();
+		m_Size = 0;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] ILINE auto SmallVector<T, N>::operator[](size_t index) noexcept -> T& {
+		assert(index < m_Size);
+		return this->Data()[index];
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] ILINE auto SmallVector<T, N>::operator[](size_t index) const noexcept -> T const& {
+		assert(index < m_Size);
+		return this->Data()[index];
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] ILINE auto SmallVector<T, N>::Data() noexcept -> T* {
+		return this->IsInline() ? reinterpret_cast<T*>(m_Inline) : m_Heap;
+	}
+
+	template<typename T, size_t N>
+	[[nodiscard]] ILINE auto SmallVector<T, N>::Data() const noexcept -> T const* {
+		return this->IsInline() ? reinterpret_cast<T const*>(m_Inline) : m_Heap;
+	}
+
+	template<typename T, size_t N>
+	ILINE auto SmallVector<T, N>::Grow(size_t count) -> void {
+		auto const capacity = (std::max)(count, m_Capacity * 2);
+		auto* elements = static_cast<T*>(::operator new(capacity * sizeof(T), std::align_val_t{ alignof(T) }));
+		Memory::Relocate(elements, this->Data(), m_Size);
+		if (!this->IsInline())
+			::operator delete(m_Heap, std::align_val_t{ alignof(T) });
+		m_Heap = elements;
+		m_Capacity = capacity;
+	}
+
+	template<typename T, size_t N>
+	ILINE auto SmallVector<T, N>::Release() noexcept -> void {
+		this->Clear();
+		if (!this->IsInline())
+			::operator delete(m_Heap, std::align_val_t{ alignof(T) });
+		m_Capacity = N;
+	}
+
+}
\ No newline at end of file
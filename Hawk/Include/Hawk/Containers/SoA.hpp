@@ -0,0 +1,304 @@
+#pragma once
+
+#include <algorithm>
+#include <new>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "../Common/Defines.hpp"
+#include "../Common/NonCopyable.hpp"
+#include "../Memory/Utility.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+//#include <Hawk/Memory/Utility.hpp>
+
+namespace Hawk {
+
+	// Struct-of-arrays storage: one cache-line aligned column per field, all living in a single allocation.
+	// Columns are exposed as spans for SIMD loops, and operator[] yields a tuple of references so a row can
+	// still be read and written AoS-style, including through structured bindings.
+	template<typename... Fields>
+	class SoA : NonCopyable {
+		static_assert(sizeof...(Fields) > 0, "SoA needs at least one field");
+	public:
+		static constexpr size_t CountFields     = sizeof...(Fields);
+		static constexpr size_t ColumnAlignment = HAWK_CACHE_LINE_SIZE;
+
+		template<size_t I>
+		using FieldType = std::tuple_element_t<I, std::tuple<Fields...>>;
+
+		using Row      = std::tuple<Fields&...>;
+		using ConstRow = std::tuple<Fields const&...>;
+
+		SoA() noexcept = default;
+		SoA(SoA&& rhs) noexcept;
+		~SoA();
+
+		auto operator=(SoA&& rhs) noexcept -> SoA&;
+
+		template<typename... Args> requires (sizeof...(Args) == sizeof...(Fields))
+		auto PushBack(Args&&... values) -> size_t;
+		auto PopBack() noexcept -> void;
+		auto EraseSwap(size_t index) noexcept -> void;
+		auto Resize(size_t count) -> void;
+		auto Reserve(size_t count) -> void;
+		auto Clear() noexcept -> void;
+
+		auto operator[](size_t index)       noexcept -> Row;
+		auto operator[](size_t index) const noexcept -> ConstRow;
+
+		template<size_t I> auto Column()       noexcept -> std::span<FieldType<I>>;
+		template<size_t I> auto Column() const noexcept -> std::span<FieldType<I> const>;
+		template<size_t I> auto Data()         noexcept -> FieldType<I>*;
+		template<size_t I> auto Data()   const noexcept -> FieldType<I> const*;
+
+		auto Size()     const noexcept -> size_t { return m_Size; }
+		auto Capacity() const noexcept -> size_t { return m_Capacity; }
+		auto IsEmpty()  const noexcept -> bool { return m_Size == 0; }
+
+	private:
+		using Indices = std::index_sequence_for<Fields...>;
+
+		template<size_t... I>
+		auto RowAt(size_t index, std::index_sequence<I...>) const noexcept -> Row;
+		template<size_t... I>
+		auto Destroy(size_t begin, size_t end, std::index_sequence<I...>) noexcept -> void;
+		template<size_t... I>
+		auto Grow(size_t capacity, std::index_sequence<I...>) -> void;
+
+		Memory::AlignedBuffer  m_Memory{ nullptr, Memory::AlignedDeleter{ ColumnAlignment } };
+		std::tuple<Fields*...> m_Columns{};
+		size_t                 m_Size = 0;
+		size_t                 m_Capacity = 0;
+	};
+
+	// Describes an AoS type by its members so it can be stored as SoA without repeating the field list:
+	//     template<> struct SoALayout<Vertex> : SoAMembers<&Vertex::Position, &Vertex::Normal> {};
+	//     SoAOf<Vertex> vertices;
+	//     vertices.PushBack(vertex);
+	template<typename T>
+	struct SoALayout;
+
+	namespace Detail {
+
+		template<typename M> struct MemberPointerTraits;
+
+		template<typename C, typename F>
+		struct MemberPointerTraits<F C::*> {
+			using Class = C;
+			using Field = F;
+		};
+
+	}
+
+	template<auto First, auto... Rest>
+	struct SoAMembers {
+		using Struct    = typename Detail::MemberPointerTraits<decltype(First)>::Class;
+		using Container = SoA<typename Detail::MemberPointerTraits<decltype(First)>::Field, typename Detail::MemberPointerTraits<decltype(Rest)>::Field...>;
+
+		static_assert((std::is_same_v<Struct, typename Detail::MemberPointerTraits<decltype(Rest)>::Class> && ...), "SoA members must belong to one type");
+
+		static auto Store(Container& container, Struct const& value) -> size_t;
+		static auto Load(Container const& container, size_t index) -> Struct;
+
+	private:
+		template<size_t... I>
+		static auto Load(Container const& container, size_t index, std::index_sequence<I...>) -> Struct;
+	};
+
+	template<typename T>
+	class SoAOf : public SoALayout<T>::Container {
+	public:
+		using Layout = SoALayout<T>;
+		using SoALayout<T>::Container::PushBack;
+
+		auto PushBack(T const& value) -> size_t { return Layout::Store(*this, value); }
+		auto Load(size_t index) const -> T { return Layout::Load(*this, index); }
+	};
+
+	namespace Memory {
+
+		template<typename... Fields>
+		struct IsTriviallyRelocatable<SoA<Fields...>> : std::true_type {};
+
+	}
+
+}
+
+namespace Hawk {
+
+	template<typename... Fields>
+	ILINE SoA<Fields...>::SoA(SoA&& rhs) noexcept
+		: m_Memory(std::move(rhs.m_Memory))
+		, m_Columns(std::exchange(rhs.m_Columns, {}))
+		, m_Size(std::exchange(rhs.m_Size, 0))
+		, m_Capacity(std::exchange(rhs.m_Capacity, 0)) {}
+
+	template<typename... Fields>
+	ILINE SoA<Fields...>::~SoA() {
+		this->Clear();
+	}
+
+	template<typename... Fields>
+	ILINE auto SoA<Fields...>::operator=(SoA&& rhs) noexcept -> SoA& {
+		if (this != &rhs) {
+			this->Clear();
+			m_Memory = std::move(rhs.m_Memory);
+			m_Columns = std::exchange(rhs.m_Columns, {});
+			m_Size = std::exchange(rhs.m_Size, 0);
+			m_Capacity = std::exchange(rhs.m_Capacity, 0);
+		}
+		return *this;
+	}
+
+	template<typename... Fields>
+	template<typename... Args> requires (sizeof...(Args) == sizeof...(Fields))
+	ILINE auto SoA<Fields...>::PushBack(Args&&... values) -> size_t {
+		if (m_Size == m_Capacity) {
+			// The values may alias a row, so build them before the columns move
+			auto row = std::tuple<Fields...>(std::forward<Args>(values)...);
+			this->Grow((std::max)(m_Capacity * 2, size_t{ 16 }), Indices{});
+			[&]<size_t... I>(std::index_sequence<I...>) {
+				(new (std::get<I>(m_Columns) + m_Size) Fields(std::move(std::get<I>(row))), ...);
+			}(Indices{});
+			return m_Size++;
+		}
+
+		[&]<size_t... I>(std::index_sequence<I...>) {
+			(new (std::get<I>(m_Columns) + m_Size) Fields(std::forward<Args>(values)), ...);
+		}(Indices{});
+		return m_Size++;
+	}
+
+	template<typename... Fields>
+	ILINE auto SoA<Fields...>::PopBack() noexcept -> void {
+		assert(m_Size > 0);
+		this->Destroy(m_Size - 1, m_Size, Indices{});
+		m_Size--;
+	}
+
+	// Moves the last row into the erased one; order is not preserved
+	template<typename... Fields>
+	ILINE auto SoA<Fields...>::EraseSwap(size_t index) noexcept -> void {
+		assert(index < m_Size);
+		if (index + 1 != m_Size) {
+			[&]<size_t... I>(std::index_sequence<I...>) {
+				((std::get<I>(m_Columns)[index] = std::move(std::get<I>(m_Columns)[m_Size - 1])), ...);
+			}(Indices{});
+		}
+		this->PopBack();
+	}
+
+	template<typename... Fields>
+	ILINE auto SoA<Fields...>::Resize(size_t count) -> void {
+		this->Reserve(count);
+		[&]<size_t... I>(std::index_sequence<I...>) {
+			for (auto index = m_Size; index < count; index++)
+				(new (std::get<I>(m_Columns) + index) Fields(), ...);
+		}(Indices{});
+		if (count < m_Size)
+			this->Destroy(count, m_Size, Indices{});
+		m_Size = count;
+	}
+
+	template<typename... Fields>
+	ILINE auto SoA<Fields...>::Reserve(size_t count) -> void {
+		if (count > m_Capacity)
+			this->Grow(count, Indices{});
+	}
+
+	template<typename... Fields>
+	ILINE auto SoA<Fields...>::Clear() noexcept -> void {
+		this->Destroy(0, m_Size, Indices{});
+		m_Size = 0;
+	}
+
+	template<typename... Fields>
+	[[nodiscard]] ILINE auto SoA<Fields...>::operator[](size_t index) noexcept -> Row {
+		assert(index < m_Size);
+		return this->RowAt(index, Indices{});
+	}
+
+	template<typename... Fields>
+	[[nodiscard]] ILINE auto SoA<Fields...>::operator[](size_t index) const noexcept -> ConstRow {
+		assert(index < m_Size);
+		return this->RowAt(index, Indices{});
+	}
+
+	template<typename... Fields>
+	template<size_t I>
+	[[nodiscard]] ILINE auto SoA<Fields...>::Column() noexcept -> std::span<FieldType<I>> {
+		return { std::get<I>(m_Columns), m_Size };
+	}
+
+	template<typename... Fields>
+	template<size_t I>
+	[[nodiscard]] ILINE auto SoA<Fields...>::Column() const noexcept -> std::span<FieldType<I> const> {
+		return { std::get<I>(m_Columns), m_Size };
+	}
+
+	template<typename... Fields>
+	template<size_t I>
+	[[nodiscard]] ILINE auto SoA<Fields...>::Data() noexcept -> FieldType<I>* {
+		return std::get<I>(m_Columns);
+	}
+
+	template<typename... Fields>
+	template<size_t I>
+	[[nodiscard]] ILINE auto SoA<Fields...>::Data() const noexcept -> FieldType<I> const* {
+		return std::get<I>(m_Columns);
+	}
+
+	template<typename... Fields>
+	template<size_t... I>
+	[[nodiscard]] ILINE auto SoA<Fields...>::RowAt(size_t index, std::index_sequence<I...>) const noexcept -> Row {
+		return Row{ std::get<I>(m_Columns)[index]... };
+	}
+
+	template<typename... Fields>
+	template<size_t... I>
+	ILINE auto SoA<Fields...>::Destroy(size_t begin, size_t end, std::index_sequence<I...>) noexcept -> void {
+		if constexpr (!(std::is_trivially_destructible_v<Fields> && ...))
+			for (auto index = begin; index < end; index++)
+				(std::get<I>(m_Columns)[index].~Fields(), ...);
+	}
+
+	template<typename... Fields>
+	template<size_t... I>
+	ILINE auto SoA<Fields...>::Grow(size_t capacity, std::index_sequence<I...>) -> void {
+		size_t offsets[CountFields] = {};
+		auto size = size_t{ 0 };
+		((offsets[I] = size, size = Memory::AlignUp(size + capacity * sizeof(Fields), ColumnAlignment)), ...);
+
+		auto memory = Memory::AllocateAligned(size, ColumnAlignment);
+		auto columns = std::tuple<Fields*...>{ reinterpret_cast<Fields*>(memory.get() + offsets[I])... };
+		(Memory::Relocate(std::get<I>(columns), std::get<I>(m_Columns), m_Size), ...);
+
+		m_Memory = std::move(memory);
+		m_Columns = columns;
+		m_Capacity = capacity;
+	}
+
+	template<auto First, auto... Rest>
+	ILINE auto SoAMembers<First, Rest...>::Store(Container& container, Struct const& value) -> size_t {
+		return container.PushBack(value.*First, value.*Rest...);
+	}
+
+	template<auto First, auto... Rest>
+	[[nodiscard]] ILINE auto SoAMembers<First, Rest...>::Load(Container const& container, size_t index) -> Struct {
+		return Load(container, index, std::make_index_sequence<1 + sizeof...(Rest)>{});
+	}
+
+	template<auto First, auto... Rest>
+	template<size_t... I>
+	[[nodiscard]] ILINE auto SoAMembers<First, Rest...>::Load(Container const& container, size_t index, std::index_sequence<I...>) -> Struct {
+		constexpr auto members = std::make_tuple(First, Rest...);
+		auto value = Struct{};
+		((value.*std::get<I>(members) = container.template Data<I>()[index]), ...);
+		return value;
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <string_view>
+
+#include "../Common/Defines.hpp"
+#include "../Memory/Utility.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Memory/Utility.hpp>
+
+namespace Hawk {
+
+	// Null-terminated string with inline storage for N characters. Appends past the capacity are truncated
+	// (and assert in debug builds), so building debug names or formatted paths never touches the heap.
+	template<size_t N>
+	class StaticString {
+	public:
+		constexpr StaticString() noexcept = default;
+		StaticString(std::string_view value) noexcept;
+
+		auto operator=(std::string_view value) noexcept -> StaticString&;
+		auto operator+=(std::string_view value) noexcept -> StaticString&;
+		auto operator+=(char value) noexcept -> StaticString&;
+
+		auto Append(std::string_view value) noexcept -> StaticString&;
+		auto Resize(size_t count, char value = '\0') noexcept -> void;
+		auto Clear() noexcept -> void;
+
+		auto Data()           noexcept -> char*       { return m_Data; }
+		auto Data()     const noexcept -> char const* { return m_Data; }
+		auto CStr()     const noexcept -> char const* { return m_Data; }
+		auto View()     const noexcept -> std::string_view { return { m_Data, m_Size }; }
+		auto Size()     const noexcept -> size_t { return m_Size; }
+		auto IsEmpty()  const noexcept -> bool { return m_Size == 0; }
+		static constexpr auto Capacity() noexcept -> size_t { return N; }
+
+		operator std::string_view() const noexcept { return this->View(); }
+
+		auto operator==(std::string_view rhs) const noexcept -> bool { return this->View() == rhs; }
+		auto operator!=(std::string_view rhs) const noexcept -> bool { return this->View() != rhs; }
+
+		auto begin() const noexcept -> char const* { return m_Data; }
+		auto end()   const noexcept -> char const* { return m_Data + m_Size; }
+
+	private:
+		char   m_Data[N + 1] = {};
+		size_t m_Size = 0;
+	};
+
+	namespace Memory {
+
+		template<size_t N>
+		struct IsTriviallyRelocatable<StaticString<N>> : std::true_type {};
+
+	}
+
+}
+
+namespace Hawk {
+
+	template<size_t N>
+	ILINE StaticString<N>::StaticString(std::string_view value) noexcept {
+		this->Append(value);
+	}
+
+	template<size_t N>
+	ILINE auto StaticString<N>::operator=(std::string_view value) noexcept -> StaticString& {
+		this->Clear();
+		return this->Append(value);
+	}
+
+	template<size_t N>
+	ILINE auto StaticString<N>::operator+=(std::string_view value) noexcept -> StaticString& {
+		return this->Append(value);
+	}
+
+	template<size_t N>
+	ILINE auto StaticString<N>::operator+=(char value) noexcept -> StaticString& {
+		return this->Append(std::string_view{ &value, 1 });
+	}
+
+	template<size_t N>
+	ILINE auto StaticString<N>::Append(std::string_view value) noexcept -> StaticString& {
+		assert(m_Size + value.size() <= N && "StaticString is truncated");
+		auto const count = (std::min)(value.size(), N - m_Size);
+		std::memmove(m_Data + m_Size, value.data(), count);
+		m_Size += count;
+		m_Data[m_Size] = '\0';
+		return *this;
+	}
+
+	template<size_t N>
+	ILINE auto StaticString<N>::Resize(size_t count, char value) noexcept -> void {
+		assert(count <= N && "StaticString is truncated");
+		count = (std::min)(count, N);
+		if (count > m_Size)
+			std::memset(m_Data + m_Size, value, count - m_Size);
+		m_Size = count;
+		m_Data[m_Size] = '\0';
+	}
+
+	template<size_t N>
+	ILINE auto StaticString<N>::Clear() noexcept -> void {
+		m_Size = 0;
+		m_Data[0] = '\0';
+	}
+
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../Common/Defines.hpp"
+#include "../Common/NonCopyable.hpp"
+#include "../Memory/Utility.hpp"
+#include "../Memory/VirtualMemory.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+//#include <Hawk/Memory/Utility.hpp>
+//#include <Hawk/Memory/VirtualMemory.hpp>
+
+namespace Hawk {
+
+	// Growable array over a reserved address range. Pages are committed as the array grows, so elements are
+	// never moved or copied and pointers into the array stay valid until they are erased. The upper bound is
+	// fixed at construction and only costs address space.
+	template<typename T>
+	class VirtualArray : NonCopyable {
+	public:
+		using Iterator      = T*;
+		using ConstIterator = T const*;
+
+		static constexpr size_t CommitGranularity = 64 << 10;
+
+		VirtualArray(size_t maxCount);
+		VirtualArray(VirtualArray&& rhs) noexcept;
+		~VirtualArray();
+
+		auto operator=(VirtualArray&& rhs) noexcept -> VirtualArray&;
+
+		template<typename... Args>
+		auto EmplaceBack(Args&&... args) -> T&;
+		auto PushBack(T const& value) -> T&;
+		auto PushBack(T&& value) -> T&;
+		auto PopBack() noexcept -> void;
+		auto Resize(size_t count) -> void;
+		auto Reserve(size_t count) -> void;
+		auto Clear() noexcept -> void;
+		auto ShrinkToFit() noexcept -> void;
+
+		auto operator[](size_t index)       noexcept -> T&;
+		auto operator[](size_t index) const noexcept -> T const&;
+
+		auto Data()           noexcept -> T*       { return m_Data; }
+		auto Data()     const noexcept -> T const* { return m_Data; }
+		auto Size()     const noexcept -> size_t { return m_Size; }
+		auto Capacity() const noexcept -> size_t { return m_SizeCommitted / sizeof(T); }
+		auto MaxSize()  const noexcept -> size_t { return m_SizeReserved / sizeof(T); }
+		auto IsEmpty()  const noexcept -> bool { return m_Size == 0; }
+
+		auto begin()       noexcept -> Iterator { return m_Data; }
+		auto end()         noexcept -> Iterator { return m_Data + m_Size; }
+		auto begin() const noexcept -> ConstIterator { return m_Data; }
+		auto end()   const noexcept -> ConstIterator { return m_Data + m_Size; }
+
+	private:
+		auto CommitFor(size_t count) -> void;
+
+		T*     m_Data;
+		size_t m_Size;
+		size_t m_SizeCommitted;
+		size_t m_SizeReserved;
+	};
+
+}
+
+namespace Hawk {
+
+	template<typename T>
+	ILINE VirtualArray<T>::VirtualArray(size_t maxCount)
+		: m_Data(nullptr)
+		, m_Size(0)
+		, m_SizeCommitted(0)
+		, m_SizeReserved(0) {
+		static_assert(alignof(T) <= CommitGranularity, "VirtualArray can't align past the commit granularity");
+		if (maxCount > ((std::numeric_limits<size_t>::max)() - CommitGranularity) / sizeof(T))
+			throw std::length_error("VirtualArray size exceeds the address space");
+
+		m_SizeReserved = Memory::AlignUp((std::max)(maxCount * sizeof(T), size_t{ 1 }), CommitGranularity);
+		m_Data = static_cast<T*>(Memory::Virtual::Reserve(m_SizeReserved));
+		if (m_Data == nullptr)
+			throw std::bad_alloc{};
+	}
+
+	template<typename T>
+	ILINE VirtualArray<T>::VirtualArray(VirtualArray&& rhs) noexcept
+		: m_Data(std::exchange(rhs.m_Data, nullptr))
+		, m_Size(std::exchange(rhs.m_Size, 0))
+		, m_SizeCommitted(std::exchange(rhs.m_SizeCommitted, 0))
+		, m_SizeReserved(std::exchange(rhs.m_SizeReserved, 0)) {}
+
+	template<typename T>
+	ILINE VirtualArray<T>::~VirtualArray() {
+		if (m_Data == nullptr)
+			return;
+		this->Clear();
+		Memory::Virtual::Release(m_Data, m_SizeReserved);
+	}
+
+	template<typename T>
+	ILINE auto VirtualArray<T>::operator=(VirtualArray&& rhs) noexcept -> VirtualArray& {
+		if (this != &rhs) {
+			std::swap(m_Data, rhs.m_Data);
+			std::swap(m_Size, rhs.m_Size);
+			std::swap(m_SizeCommitted, rhs.m_SizeCommitted);
+			std::swap(m_SizeReserved, rhs.m_SizeReserved);
+		}
+		return *this;
+	}
+
+	template<typename T>
+	template<typename... Args>
+	ILINE auto VirtualArray<T>::EmplaceBack(Args&&... args) -> T& {
+		if ((m_Size + 1) * sizeof(T) > m_SizeCommitted)
+			this->CommitFor(m_Size + 1);
+		auto* element = new (m_Data + m_Size) T(std::forward<Args>(args)...);
+		m_Size++;
+		return *element;
+	}
+
+	template<typename T>
+	ILINE auto VirtualArray<T>::PushBack(T const& value) -> T& {
+		return this->EmplaceBack(value);
+	}
+
+	template<typename T>
+	ILINE auto VirtualArray<T>::PushBack(T&& value) -> T& {
+		return this->EmplaceBack(std::move(value));
+	}
+
+	template<typename T>
+	ILINE auto VirtualArray<T>::PopBack() noexcept -> void {
+		assert(m_Size > 0);
+		m_Data[--m_Size].~T();
+	}
+
+	template<typename T>
+	ILINE auto VirtualArray<T>::Resize(size_t count) -> void {
+		if (count > m_Size) {
+			this->CommitFor(count);
+			for (; m_Size < count; m_Size++)
+				new (m_Data + m_Size) T();
+		} else {
+			while (m_Size > count)
+				this->PopBack();
+		}
+	}
+
+	template<typename T>
+	ILINE auto VirtualArray<T>::Reserve(size_t count) -> void {
+		if (count > this->Capacity())
+			this->CommitFor(count);
+	}
+
+	// Destroys the elements but keeps the pages committed for reuse; ShrinkToFit hands them back
+	template<typename T>
+	ILINE auto VirtualArray<T>::Clear() noexcept -> void {
+		if constexpr (!std::is_trivially_destructible_v<T>)
+			for (auto index = size_t{ 0 }; index < m_Size; index++)
+				m_Data[index].~T();
+		m_Size = 0;
+	}
+
+	template<typename T>
+	ILINE auto VirtualArray<T>::ShrinkToFit() noexcept -> void {
+		auto const sizeUsed = Memory::AlignUp(m_Size * sizeof(T), CommitGranularity);
+		if (sizeUsed < m_SizeCommitted) {
+			Memory::Virtual::Decommit(reinterpret_cast<U8*>(m_Data) + sizeUsed, m_SizeCommitted - sizeUsed);
+			m_SizeCommitted = sizeUsed;
+		}
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto VirtualArray<T>::operator[](size_t index) noexcept -> T& {
+		assert(index < m_Size);
+		return m_Data[index];
+	}
+
+	template<typename T>
+	[[nodiscard]] ILINE auto VirtualArray<T>::operator[](size_t index) const noexcept -> T const& {
+		assert(index < m_Size);
+		return m_Data[index];
+	}
+
+	// Commits at least the requested range, growing by half of what is already committed so that
+	// a long run of single pushes doesn't turn into one system call per page
+	template<typename T>
+	ILINE auto VirtualArray<T>::CommitFor(size_t count) -> void {
+		if (count > this->MaxSize())
+			throw std::bad_alloc{};
+		auto const sizeRequired = count * sizeof(T);
+		if (sizeRequired <= m_SizeCommitted)
+			return;
+
+		auto sizeTarget = Memory::AlignUp((std::max)(sizeRequired, m_SizeCommitted + m_SizeCommitted / 2), CommitGranularity);
+		sizeTarget = (std::min)(sizeTarget, m_SizeReserved);
+		if (!Memory::Virtual::Commit(reinterpret_cast<U8*>(m_Data) + m_SizeCommitted, sizeTarget - m_SizeCommitted))
+			throw std::bad_alloc{};
+		m_SizeCommitted = sizeTarget;
+	}
+
+}
\ No newline at end of file
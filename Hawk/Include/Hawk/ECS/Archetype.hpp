@@ -0,0 +1,181 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+#include "../Common/NonCopyable.hpp"
+#include "../Memory/Utility.hpp"
+#include "./Component.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+//#include <Hawk/Memory/Utility.hpp>
+//#include <Hawk/ECS/Component.hpp>
+
+namespace Hawk {
+	namespace ECS {
+
+		constexpr size_t ChunkSize      = 16 << 10;
+		constexpr U8     InvalidColumn  = 0xFF;
+
+		// Recycles chunk memory between archetypes so structural changes don't keep hitting the heap
+		class ChunkPool : NonCopyable {
+		public:
+			auto Acquire() -> Memory::AlignedBuffer;
+			auto Release(Memory::AlignedBuffer memory) -> void;
+		private:
+			std::vector<Memory::AlignedBuffer> m_Free;
+		};
+
+		struct Chunk {
+			Memory::AlignedBuffer Memory;
+			U32                   Count;
+		};
+
+		// All entities with exactly the same component set. Rows live in fixed-size chunks laid out as SoA:
+		// the entity column first, then one column per component in ascending id order, so a query walks
+		// contiguous arrays. Rows are kept dense by moving the archetype's last row into any hole.
+		class Archetype : NonCopyable {
+		public:
+			Archetype(ComponentMask mask, ChunkPool& pool);
+			~Archetype();
+
+			auto Allocate() -> std::pair<U32, U32>;
+			auto RemoveRow(U32 chunk, U32 row, bool isDestroy) noexcept -> Entity;
+
+			auto Mask()          const noexcept -> ComponentMask { return m_Mask; }
+			auto ChunkCapacity() const noexcept -> U32 { return m_ChunkCapacity; }
+			auto CountChunks()   const noexcept -> U32 { return static_cast<U32>(m_Chunks.size()); }
+			auto CountEntities() const noexcept -> size_t;
+			auto CountColumns()  const noexcept -> U32 { return static_cast<U32>(m_Components.size()); }
+
+			auto ChunkAt(U32 chunk)    const noexcept -> Chunk const& { return m_Chunks[chunk]; }
+			auto ComponentAt(U32 column) const noexcept -> U32 { return m_Components[column]; }
+			auto ColumnOf(U32 componentId) const noexcept -> U8 { return m_ColumnByComponent[componentId]; }
+
+			auto Entities(U32 chunk) const noexcept -> Entity*;
+			auto ColumnData(U32 chunk, U32 column) const noexcept -> U8*;
+			auto Component(U32 chunk, U32 column, U32 row) const noexcept -> void*;
+
+		private:
+			ComponentMask                       m_Mask;
+			ChunkPool&                          m_Pool;
+			std::vector<U32>                    m_Components;
+			std::vector<ComponentInfo>          m_Infos;
+			std::vector<U32>                    m_Offsets;
+			std::array<U8, MaxComponents>       m_ColumnByComponent;
+			std::vector<Chunk>                  m_Chunks;
+			U32                                 m_ChunkCapacity;
+		};
+
+	}
+}
+
+namespace Hawk {
+	namespace ECS {
+
+		[[nodiscard]] ILINE auto ChunkPool::Acquire() -> Memory::AlignedBuffer {
+			if (m_Free.empty())
+				return Memory::AllocateAligned(ChunkSize, HAWK_CACHE_LINE_SIZE);
+			auto memory = std::move(m_Free.back());
+			m_Free.pop_back();
+			return memory;
+		}
+
+		ILINE auto ChunkPool::Release(Memory::AlignedBuffer memory) -> void {
+			Memory::Poison(memory.get(), ChunkSize, Memory::PoisonReleased);
+			m_Free.push_back(std::move(memory));
+		}
+
+		ILINE Archetype::Archetype(ComponentMask mask, ChunkPool& pool)
+			: m_Mask(mask)
+			, m_Pool(pool)
+			, m_ChunkCapacity(0) {
+			m_ColumnByComponent.fill(InvalidColumn);
+
+			auto sizeRow = sizeof(Entity);
+			for (auto id = 0u; id < MaxComponents; id++) {
+				if ((mask & (ComponentMask{ 1 } << id)) == 0)
+					continue;
+				m_ColumnByComponent[id] = static_cast<U8>(m_Components.size());
+				m_Components.push_back(id);
+				m_Infos.push_back(GetComponentInfo(id));
+				sizeRow += m_Infos.back().Size;
+			}
+
+			// Start from the unpadded estimate and back off until the aligned columns fit in one chunk
+			m_Offsets.resize(m_Components.size());
+			for (auto capacity = ChunkSize / sizeRow; capacity > 0; capacity--) {
+				auto offset = capacity * sizeof(Entity);
+				for (auto column = size_t{ 0 }; column < m_Infos.size(); column++) {
+					offset = Memory::AlignUp(offset, m_Infos[column].Alignment);
+					m_Offsets[column] = static_cast<U32>(offset);
+					offset += capacity * m_Infos[column].Size;
+				}
+				if (offset <= ChunkSize) {
+					m_ChunkCapacity = static_cast<U32>(capacity);
+					break;
+				}
+			}
+			assert(m_ChunkCapacity > 0 && "Archetype row doesn't fit in a chunk");
+		}
+
+		ILINE Archetype::~Archetype() {
+			for (auto chunk = 0u; chunk < m_Chunks.size(); chunk++)
+				for (auto column = 0u; column < m_Components.size(); column++)
+					for (auto row = 0u; row < m_Chunks[chunk].Count; row++)
+						m_Infos[column].Destroy(this->Component(chunk, column, row));
+		}
+
+		// Reserves a row at the end of the archetype; the caller fills in the entity and every component
+		[[nodiscard]] ILINE auto Archetype::Allocate() -> std::pair<U32, U32> {
+			if (m_Chunks.empty() || m_Chunks.back().Count == m_ChunkCapacity)
+				m_Chunks.push_back(Chunk{ m_Pool.Acquire(), 0 });
+			auto& chunk = m_Chunks.back();
+			return { static_cast<U32>(m_Chunks.size() - 1), chunk.Count++ };
+		}
+
+		// Fills the hole with the archetype's last row and returns the entity that moved into it, if any.
+		// Without isDestroy the row's components must already have been relocated or destroyed by the caller.
+		ILINE auto Archetype::RemoveRow(U32 chunk, U32 row, bool isDestroy) noexcept -> Entity {
+			if (isDestroy)
+				for (auto column = 0u; column < m_Components.size(); column++)
+					m_Infos[column].Destroy(this->Component(chunk, column, row));
+
+			auto const chunkLast = static_cast<U32>(m_Chunks.size() - 1);
+			auto const rowLast = m_Chunks[chunkLast].Count - 1;
+
+			auto moved = Entity{};
+			if (chunk != chunkLast || row != rowLast) {
+				moved = this->Entities(chunkLast)[rowLast];
+				this->Entities(chunk)[row] = moved;
+				for (auto column = 0u; column < m_Components.size(); column++)
+					m_Infos[column].Relocate(this->Component(chunk, column, row), this->Component(chunkLast, column, rowLast));
+			}
+
+			if (--m_Chunks[chunkLast].Count == 0) {
+				m_Pool.Release(std::move(m_Chunks.back().Memory));
+				m_Chunks.pop_back();
+			}
+			return moved;
+		}
+
+		[[nodiscard]] ILINE auto Archetype::CountEntities() const noexcept -> size_t {
+			return m_Chunks.empty() ? 0 : (m_Chunks.size() - 1) * m_ChunkCapacity + m_Chunks.back().Count;
+		}
+
+		[[nodiscard]] ILINE auto Archetype::Entities(U32 chunk) const noexcept -> Entity* {
+			return reinterpret_cast<Entity*>(m_Chunks[chunk].Memory.get());
+		}
+
+		[[nodiscard]] ILINE auto Archetype::ColumnData(U32 chunk, U32 column) const noexcept -> U8* {
+			return m_Chunks[chunk].Memory.get() + m_Offsets[column];
+		}
+
+		[[nodiscard]] ILINE auto Archetype::Component(U32 chunk, U32 column, U32 row) const noexcept -> void* {
+			return this->ColumnData(chunk, column) + static_cast<size_t>(row) * m_Infos[column].Size;
+		}
+
+	}
+}
\ No newline at end of file
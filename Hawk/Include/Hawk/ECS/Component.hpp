@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "../Common/Defines.hpp"
+#include "../Containers/SlotMap.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Containers/SlotMap.hpp>
+
+namespace Hawk {
+	namespace ECS {
+
+		using Entity        = Handle64;
+		using ComponentMask = U64;
+
+		constexpr U32 MaxComponents = 64;
+
+		// Type-erased operations the registry needs to move rows between chunks without knowing the component type.
+		// Relocate move-constructs into the destination and destroys the source.
+		struct ComponentInfo {
+			U32  Size;
+			U32  Alignment;
+			void (*Relocate)(void* destination, void* source) noexcept;
+			void (*Destroy)(void* pointer) noexcept;
+		};
+
+		template<typename T> auto ComponentId() -> U32;
+		template<typename... Ts> auto MakeMask() -> ComponentMask;
+		auto GetComponentInfo(U32 id) noexcept -> ComponentInfo const&;
+
+		namespace Detail {
+
+			class ComponentTable {
+			public:
+				static auto Instance() noexcept -> ComponentTable&;
+				auto Register(ComponentInfo const& info) -> U32;
+				auto Get(U32 id) const noexcept -> ComponentInfo const&;
+			private:
+				std::array<ComponentInfo, MaxComponents> m_Infos = {};
+				std::atomic<U32>                         m_Count = 0;
+				std::mutex                               m_Mutex;
+			};
+
+			template<typename T>
+			auto MakeComponentInfo() noexcept -> ComponentInfo;
+
+		}
+
+	}
+}
+
+namespace Hawk {
+	namespace ECS {
+
+		namespace Detail {
+
+			[[nodiscard]] ILINE auto ComponentTable::Instance() noexcept -> ComponentTable& {
+				static ComponentTable table;
+				return table;
+			}
+
+			ILINE auto ComponentTable::Register(ComponentInfo const& info) -> U32 {
+				std::lock_guard<std::mutex> lock{ m_Mutex };
+				auto const id = m_Count.load(std::memory_order_relaxed);
+				if (id >= MaxComponents)
+					throw std::length_error("Too many component types");
+				m_Infos[id] = info;
+				m_Count.store(id + 1, std::memory_order_release);
+				return id;
+			}
+
+			[[nodiscard]] ILINE auto ComponentTable::Get(U32 id) const noexcept -> ComponentInfo const& {
+				assert(id < m_Count.load(std::memory_order_acquire));
+				return m_Infos[id];
+			}
+
+			template<typename T>
+			[[nodiscard]] ILINE auto MakeComponentInfo() noexcept -> ComponentInfo {
+				static_assert(std::is_nothrow_move_constructible_v<T>, "Components must be nothrow move constructible");
+				auto info = ComponentInfo{};
+				info.Size = static_cast<U32>(sizeof(T));
+				info.Alignment = static_cast<U32>(alignof(T));
+				info.Relocate = [](void* destination, void* source) noexcept {
+					new (destination) T(std::move(*static_cast<T*>(source)));
+					static_cast<T*>(source)->~T();
+				};
+				info.Destroy = [](void* pointer) noexcept {
+					static_cast<T*>(pointer)->~T();
+				};
+				return info;
+			}
+
+		}
+
+		// Ids are handed out on first use and are stable for the lifetime of the process. The first use of a
+		// type past MaxComponents throws, and so does every later one.
+		template<typename T>
+		[[nodiscard]] ILINE auto ComponentId() -> U32 {
+			static_assert(std::is_same_v<T, std::remove_cv_t<std::remove_reference_t<T>>>, "Component ids are taken on the plain type");
+			static U32 const id = Detail::ComponentTable::Instance().Register(Detail::MakeComponentInfo<T>());
+			return id;
+		}
+
+		template<typename... Ts>
+		[[nodiscard]] ILINE auto MakeMask() -> ComponentMask {
+			return (ComponentMask{ 0 } | ... | (ComponentMask{ 1 } << ComponentId<std::remove_const_t<Ts>>()));
+		}
+
+		[[nodiscard]] ILINE auto GetComponentInfo(U32 id) noexcept -> ComponentInfo const& {
+			return Detail::ComponentTable::Instance().Get(id);
+		}
+
+	}
+}
\ No newline at end of file
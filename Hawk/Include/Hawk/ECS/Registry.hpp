@@ -0,0 +1,472 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+#include "../Common/NonCopyable.hpp"
+#include "../Common/Jobs.hpp"
+#include "../Containers/FlatHashMap.hpp"
+#include "./Component.hpp"
+#include "./Archetype.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+//#include <Hawk/Common/Jobs.hpp>
+//#include <Hawk/Containers/FlatHashMap.hpp>
+//#include <Hawk/ECS/Component.hpp>
+//#include <Hawk/ECS/Archetype.hpp>
+
+namespace Hawk {
+	namespace ECS {
+
+		class Registry;
+
+		namespace Detail {
+
+			class QueryBase {
+			public:
+				virtual ~QueryBase() = default;
+			};
+
+			inline auto NextQueryId() noexcept -> U32 {
+				static std::atomic<U32> counter = 0;
+				return counter.fetch_add(1, std::memory_order_relaxed);
+			}
+
+			template<typename... Ts>
+			auto QueryId() noexcept -> U32 {
+				static U32 const id = NextQueryId();
+				return id;
+			}
+
+		}
+
+		// Structural changes recorded while queries are running and replayed by Registry::Apply at a sync point.
+		// A buffer is not thread-safe; give each worker its own and apply them one after another.
+		class CommandBuffer : NonCopyable {
+		public:
+			template<typename... Ts>
+			auto Create(Ts&&... components) -> void;
+			auto Destroy(Entity entity) -> void;
+			template<typename T>
+			auto Add(Entity entity, T&& component) -> void;
+			template<typename T>
+			auto Remove(Entity entity) -> void;
+
+			auto Size()    const noexcept -> size_t { return m_Commands.size(); }
+			auto IsEmpty() const noexcept -> bool { return m_Commands.empty(); }
+
+		private:
+			friend class Registry;
+
+			struct Command {
+				virtual ~Command() = default;
+				virtual auto Apply(Registry& registry) -> void = 0;
+			};
+
+			template<typename F>
+			struct CommandFunction final : Command {
+				CommandFunction(F&& function) : Function(std::move(function)) {}
+				auto Apply(Registry& registry) -> void override { Function(registry); }
+				F Function;
+			};
+
+			template<typename F>
+			auto Push(F&& function) -> void;
+
+			std::vector<std::unique_ptr<Command>> m_Commands;
+		};
+
+		// Cached set of archetypes holding every component in Ts. Archetypes are only ever appended, so a refresh
+		// scans just the ones created since the last run. Components listed as const are read-only by convention.
+		template<typename... Ts>
+		class Query : public Detail::QueryBase {
+		public:
+			Query(Registry& registry);
+
+			template<typename F> auto Each(F&& function) -> void;
+			template<typename F> auto EachChunk(F&& function) -> void;
+			template<typename F> auto ParallelEach(Jobs::Scheduler& scheduler, F&& function) -> void;
+
+			auto Count() -> size_t;
+
+		private:
+			struct Match {
+				Archetype*                     Owner;
+				std::array<U32, sizeof...(Ts)> Columns;
+			};
+
+			struct ChunkRef {
+				Match const* Source;
+				U32          Chunk;
+			};
+
+			auto Refresh() -> void;
+			template<typename F> auto RunChunk(Match const& match, U32 chunk, F& function) -> void;
+
+			Registry&             m_Registry;
+			ComponentMask         m_Mask;
+			std::vector<Match>    m_Matches;
+			std::vector<ChunkRef> m_Chunks;
+			size_t                m_CountScanned;
+		};
+
+		// Owns every entity and archetype. Structural changes (create, destroy, add, remove) move rows between
+		// archetypes and must not happen while a query iterates; record them in a CommandBuffer instead.
+		class Registry : NonCopyable {
+		public:
+			Registry() = default;
+			~Registry();
+
+			template<typename... Ts>
+			auto Create(Ts&&... components) -> Entity;
+			auto Destroy(Entity entity) -> void;
+			auto IsAlive(Entity entity) const noexcept -> bool;
+
+			template<typename T>
+			auto Add(Entity entity, T&& component) -> std::decay_t<T>&;
+			template<typename T>
+			auto Remove(Entity entity) -> void;
+			template<typename T>
+			auto Get(Entity entity) -> T*;
+			template<typename T>
+			auto Has(Entity entity) const -> bool;
+
+			template<typename... Ts>
+			auto GetQuery() -> Query<Ts...>&;
+			auto Apply(CommandBuffer& commands) -> void;
+
+			auto CountEntities()   const noexcept -> size_t { return m_CountEntities; }
+			auto CountArchetypes() const noexcept -> size_t { return m_Archetypes.size(); }
+
+		private:
+			template<typename...> friend class Query;
+
+			struct Record {
+				Archetype* Owner;
+				U32        Chunk;
+				U32        Row;
+				U32        Generation;
+			};
+
+			auto AllocateRecord() -> Entity;
+			auto FindRecord(Entity entity) noexcept -> Record*;
+			auto FindRecord(Entity entity) const noexcept -> Record const*;
+			auto FindOrCreateArchetype(ComponentMask mask) -> Archetype*;
+			auto MoveRecord(Entity entity, Record& record, Archetype* target) -> void;
+			auto FillHole(Archetype& archetype, U32 chunk, U32 row, bool isDestroy) noexcept -> void;
+
+			ChunkPool                                                m_ChunkPool;
+			std::vector<std::unique_ptr<Archetype>>                  m_Archetypes;
+			FlatHashMap<ComponentMask, Archetype*>                   m_ArchetypeByMask;
+			std::vector<Record>                                      m_Records;
+			std::vector<U32>                                         m_FreeRecords;
+			FlatHashMap<U32, std::unique_ptr<Detail::QueryBase>>     m_Queries;
+			size_t                                                   m_CountEntities = 0;
+			U32                                                      m_IterationDepth = 0;
+		};
+
+	}
+}
+
+namespace Hawk {
+	namespace ECS {
+
+		template<typename F>
+		ILINE auto CommandBuffer::Push(F&& function) -> void {
+			m_Commands.push_back(std::make_unique<CommandFunction<std::decay_t<F>>>(std::forward<F>(function)));
+		}
+
+		template<typename... Ts>
+		ILINE auto CommandBuffer::Create(Ts&&... components) -> void {
+			this->Push([values = std::make_tuple(std::forward<Ts>(components)...)](Registry& registry) mutable {
+				std::apply([&](auto&... e) { registry.Create(std::move(e)...); }, values);
+			});
+		}
+
+		ILINE auto CommandBuffer::Destroy(Entity entity) -> void {
+			this->Push([entity](Registry& registry) {
+				if (registry.IsAlive(entity))
+					registry.Destroy(entity);
+			});
+		}
+
+		template<typename T>
+		ILINE auto CommandBuffer::Add(Entity entity, T&& component) -> void {
+			this->Push([entity, value = std::decay_t<T>(std::forward<T>(component))](Registry& registry) mutable {
+				if (registry.IsAlive(entity))
+					registry.Add(entity, std::move(value));
+			});
+		}
+
+		template<typename T>
+		ILINE auto CommandBuffer::Remove(Entity entity) -> void {
+			this->Push([entity](Registry& registry) {
+				if (registry.IsAlive(entity))
+					registry.Remove<T>(entity);
+			});
+		}
+
+		template<typename... Ts>
+		ILINE Query<Ts...>::Query(Registry& registry)
+			: m_Registry(registry)
+			, m_Mask(MakeMask<Ts...>())
+			, m_CountScanned(0) {}
+
+		// function(Ts&...) or function(Entity, Ts&...) for every matching entity
+		template<typename... Ts>
+		template<typename F>
+		ILINE auto Query<Ts...>::Each(F&& function) -> void {
+			this->Refresh();
+			m_Registry.m_IterationDepth++;
+			for (auto const& match : m_Matches)
+				for (auto chunk = 0u; chunk < match.Owner->CountChunks(); chunk++)
+					this->RunChunk(match, chunk, function);
+			m_Registry.m_IterationDepth--;
+		}
+
+		// function(U32 count, Entity const*, Ts*...) once per chunk, for loops that want the raw columns
+		template<typename... Ts>
+		template<typename F>
+		ILINE auto Query<Ts...>::EachChunk(F&& function) -> void {
+			this->Refresh();
+			m_Registry.m_IterationDepth++;
+			for (auto const& match : m_Matches) {
+				for (auto chunk = 0u; chunk < match.Owner->CountChunks(); chunk++) {
+					[&]<size_t... I>(std::index_sequence<I...>) {
+						function(match.Owner->ChunkAt(chunk).Count, static_cast<Entity const*>(match.Owner->Entities(chunk)),
+							reinterpret_cast<Ts*>(match.Owner->ColumnData(chunk, match.Columns[I]))...);
+					}(std::index_sequence_for<Ts...>{});
+				}
+			}
+			m_Registry.m_IterationDepth--;
+		}
+
+		// Same contract as Each, with chunks spread over the worker pool; returns once every chunk is done
+		template<typename... Ts>
+		template<typename F>
+		ILINE auto Query<Ts...>::ParallelEach(Jobs::Scheduler& scheduler, F&& function) -> void {
+			this->Refresh();
+			m_Chunks.clear();
+			for (auto const& match : m_Matches)
+				for (auto chunk = 0u; chunk < match.Owner->CountChunks(); chunk++)
+					m_Chunks.push_back(ChunkRef{ &match, chunk });
+
+			m_Registry.m_IterationDepth++;
+			scheduler.ParallelFor(static_cast<U32>(m_Chunks.size()), [&](U32 begin, U32 end) {
+				for (auto index = begin; index < end; index++)
+					this->RunChunk(*m_Chunks[index].Source, m_Chunks[index].Chunk, function);
+			});
+			m_Registry.m_IterationDepth--;
+		}
+
+		template<typename... Ts>
+		[[nodiscard]] ILINE auto Query<Ts...>::Count() -> size_t {
+			this->Refresh();
+			auto count = size_t{ 0 };
+			for (auto const& match : m_Matches)
+				count += match.Owner->CountEntities();
+			return count;
+		}
+
+		template<typename... Ts>
+		ILINE auto Query<Ts...>::Refresh() -> void {
+			auto const& archetypes = m_Registry.m_Archetypes;
+			for (; m_CountScanned < archetypes.size(); m_CountScanned++) {
+				auto* archetype = archetypes[m_CountScanned].get();
+				if ((archetype->Mask() & m_Mask) == m_Mask)
+					m_Matches.push_back(Match{ archetype, { archetype->ColumnOf(ComponentId<std::remove_const_t<Ts>>())... } });
+			}
+		}
+
+		template<typename... Ts>
+		template<typename F>
+		ILINE auto Query<Ts...>::RunChunk(Match const& match, U32 chunk, F& function) -> void {
+			auto const count = match.Owner->ChunkAt(chunk).Count;
+			auto const* entities = match.Owner->Entities(chunk);
+			[&]<size_t... I>(std::index_sequence<I...>) {
+				auto const columns = std::make_tuple(reinterpret_cast<Ts*>(match.Owner->ColumnData(chunk, match.Columns[I]))...);
+				for (auto row = 0u; row < count; row++) {
+					if constexpr (std::is_invocable_v<F&, Entity, Ts&...>)
+						function(entities[row], std::get<I>(columns)[row]...);
+					else
+						function(std::get<I>(columns)[row]...);
+				}
+			}(std::index_sequence_for<Ts...>{});
+		}
+
+		ILINE Registry::~Registry() {
+			m_Queries.Clear();
+			m_Archetypes.clear();
+		}
+
+		template<typename... Ts>
+		ILINE auto Registry::Create(Ts&&... components) -> Entity {
+			assert(m_IterationDepth == 0 && "Structural change during iteration, use a CommandBuffer");
+			auto const mask = MakeMask<std::decay_t<Ts>...>();
+			assert(static_cast<size_t>(std::popcount(mask)) == sizeof...(Ts) && "Duplicate component type");
+
+			auto* archetype = this->FindOrCreateArchetype(mask);
+			auto const entity = this->AllocateRecord();
+			auto const [chunk, row] = archetype->Allocate();
+			archetype->Entities(chunk)[row] = entity;
+			(new (archetype->Component(chunk, archetype->ColumnOf(ComponentId<std::decay_t<Ts>>()), row)) std::decay_t<Ts>(std::forward<Ts>(components)), ...);
+
+			m_Records[entity.Index()] = Record{ archetype, chunk, row, static_cast<U32>(entity.Generation()) };
+			m_CountEntities++;
+			return entity;
+		}
+
+		ILINE auto Registry::Destroy(Entity entity) -> void {
+			assert(m_IterationDepth == 0 && "Structural change during iteration, use a CommandBuffer");
+			auto* record = this->FindRecord(entity);
+			assert(record && "Entity is not alive");
+			if (record == nullptr)
+				return;
+
+			this->FillHole(*record->Owner, record->Chunk, record->Row, true);
+			record->Owner = nullptr;
+			record->Generation++;
+			m_FreeRecords.push_back(static_cast<U32>(entity.Index()));
+			m_CountEntities--;
+		}
+
+		[[nodiscard]] ILINE auto Registry::IsAlive(Entity entity) const noexcept -> bool {
+			return this->FindRecord(entity) != nullptr;
+		}
+
+		template<typename T>
+		ILINE auto Registry::Add(Entity entity, T&& component) -> std::decay_t<T>& {
+			using C = std::decay_t<T>;
+			assert(m_IterationDepth == 0 && "Structural change during iteration, use a CommandBuffer");
+			auto* record = this->FindRecord(entity);
+			assert(record && "Entity is not alive");
+
+			auto const id = ComponentId<C>();
+			auto* source = record->Owner;
+			if (source->ColumnOf(id) != InvalidColumn) {
+				auto& value = *static_cast<C*>(source->Component(record->Chunk, source->ColumnOf(id), record->Row));
+				value = std::forward<T>(component);
+				return value;
+			}
+
+			auto* target = this->FindOrCreateArchetype(source->Mask() | (ComponentMask{ 1 } << id));
+			this->MoveRecord(entity, *record, target);
+			return *new (target->Component(record->Chunk, target->ColumnOf(id), record->Row)) C(std::forward<T>(component));
+		}
+
+		template<typename T>
+		ILINE auto Registry::Remove(Entity entity) -> void {
+			assert(m_IterationDepth == 0 && "Structural change during iteration, use a CommandBuffer");
+			auto* record = this->FindRecord(entity);
+			assert(record && "Entity is not alive");
+
+			auto const id = ComponentId<T>();
+			auto* source = record->Owner;
+			if (source->ColumnOf(id) == InvalidColumn)
+				return;
+			this->MoveRecord(entity, *record, this->FindOrCreateArchetype(source->Mask() & ~(ComponentMask{ 1 } << id)));
+		}
+
+		template<typename T>
+		[[nodiscard]] ILINE auto Registry::Get(Entity entity) -> T* {
+			auto* record = this->FindRecord(entity);
+			if (record == nullptr)
+				return nullptr;
+			auto const column = record->Owner->ColumnOf(ComponentId<T>());
+			return column != InvalidColumn ? static_cast<T*>(record->Owner->Component(record->Chunk, column, record->Row)) : nullptr;
+		}
+
+		template<typename T>
+		[[nodiscard]] ILINE auto Registry::Has(Entity entity) const -> bool {
+			auto const* record = this->FindRecord(entity);
+			return record != nullptr && record->Owner->ColumnOf(ComponentId<T>()) != InvalidColumn;
+		}
+
+		template<typename... Ts>
+		ILINE auto Registry::GetQuery() -> Query<Ts...>& {
+			auto [query, isInserted] = m_Queries.TryEmplace(Detail::QueryId<Ts...>());
+			if (isInserted)
+				*query = std::make_unique<Query<Ts...>>(*this);
+			return static_cast<Query<Ts...>&>(**query);
+		}
+
+		ILINE auto Registry::Apply(CommandBuffer& commands) -> void {
+			assert(m_IterationDepth == 0 && "Command buffers are applied at sync points, outside of queries");
+			for (auto& command : commands.m_Commands)
+				command->Apply(*this);
+			commands.m_Commands.clear();
+		}
+
+		ILINE auto Registry::AllocateRecord() -> Entity {
+			if (!m_FreeRecords.empty()) {
+				auto const index = m_FreeRecords.back();
+				m_FreeRecords.pop_back();
+				return Entity{ index, m_Records[index].Generation };
+			}
+			assert(m_Records.size() < Entity::MaxIndex);
+			m_Records.push_back(Record{ nullptr, 0, 0, 0 });
+			return Entity{ static_cast<U64>(m_Records.size() - 1), 0 };
+		}
+
+		[[nodiscard]] ILINE auto Registry::FindRecord(Entity entity) noexcept -> Record* {
+			auto const index = entity.Index();
+			if (!entity.IsValid() || index >= m_Records.size())
+				return nullptr;
+			auto& record = m_Records[index];
+			return record.Owner != nullptr && record.Generation == static_cast<U32>(entity.Generation()) ? &record : nullptr;
+		}
+
+		[[nodiscard]] ILINE auto Registry::FindRecord(Entity entity) const noexcept -> Record const* {
+			return const_cast<Registry*>(this)->FindRecord(entity);
+		}
+
+		ILINE auto Registry::FindOrCreateArchetype(ComponentMask mask) -> Archetype* {
+			auto [archetype, isInserted] = m_ArchetypeByMask.TryEmplace(mask, nullptr);
+			if (isInserted) {
+				m_Archetypes.push_back(std::make_unique<Archetype>(mask, m_ChunkPool));
+				*archetype = m_Archetypes.back().get();
+			}
+			return *archetype;
+		}
+
+		// Relocates the components both archetypes share and destroys the ones the target lacks;
+		// components only the target has are left for the caller to construct
+		ILINE auto Registry::MoveRecord(Entity entity, Record& record, Archetype* target) -> void {
+			auto& source = *record.Owner;
+			auto const [chunk, row] = target->Allocate();
+			target->Entities(chunk)[row] = entity;
+
+			for (auto column = 0u; column < source.CountColumns(); column++) {
+				auto const id = source.ComponentAt(column);
+				auto* pointer = source.Component(record.Chunk, column, record.Row);
+				auto const columnTarget = target->ColumnOf(id);
+				if (columnTarget != InvalidColumn)
+					GetComponentInfo(id).Relocate(target->Component(chunk, columnTarget, row), pointer);
+				else
+					GetComponentInfo(id).Destroy(pointer);
+			}
+
+			this->FillHole(source, record.Chunk, record.Row, false);
+			record.Owner = target;
+			record.Chunk = chunk;
+			record.Row = row;
+		}
+
+		ILINE auto Registry::FillHole(Archetype& archetype, U32 chunk, U32 row, bool isDestroy) noexcept -> void {
+			auto const moved = archetype.RemoveRow(chunk, row, isDestroy);
+			if (moved.IsValid()) {
+				auto& record = m_Records[moved.Index()];
+				record.Chunk = chunk;
+				record.Row = row;
+			}
+		}
+
+	}
+}
\ No newline at end of file
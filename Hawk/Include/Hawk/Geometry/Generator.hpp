@@ -1,12 +1,19 @@
 #pragma once
 
+#include <algorithm>
 #include <cinttypes>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <stdexcept>
 #include <vector>
 #include <type_traits>
 
 #include "../Math/Math.hpp"
+#include "../Containers/SoA.hpp"
 
 //#include <Hawk/Math/Math.hpp>
+//#include <Hawk/Containers/SoA.hpp>
 
 
 namespace Hawk {
@@ -29,253 +36,499 @@ namespace Hawk {
 			std::vector<IndexType>  Indices;
 		};
 
+		struct MeshSize {
+			U32 CountVertices;
+			U32 CountIndices;
+		};
+
+		// Closed-form primitives in the engine's left-handed convention: clockwise front faces seen from outside,
+		// texcoord v growing downwards, analytic normals and tangents (w holds the bitangent sign).
+		// *Size returns the exact output of a primitive; the span overloads write into storage of at least
+		// that size without allocating, and the Mesh overloads size the vectors once and fill them.
 		class Generator {
 		public:
+			static auto SphereSize(U32 tessellation)              -> MeshSize;
+			static auto IcosphereSize(U32 frequency)              -> MeshSize;
+			static auto QuadSize(U32 tessellation)                -> MeshSize;
+			static auto PlaneSize(U32 segmentsX, U32 segmentsZ)   -> MeshSize;
+			static auto BoxSize(U32 tessellation)                 -> MeshSize;
+			static auto CylinderSize(U32 tessellation)            -> MeshSize;
+			static auto ConeSize(U32 tessellation)                -> MeshSize;
+			static auto TorusSize(U32 tessellation)               -> MeshSize;
+
+			template<typename IndexType>
+			static auto GenerateSphere(std::span<Vertex> vertices, std::span<IndexType> indices, U32 tessellation, F32 radius = 1.0f) -> void;
+			template<typename IndexType>
+			static auto GenerateIcosphere(std::span<Vertex> vertices, std::span<IndexType> indices, U32 frequency, F32 radius = 1.0f) -> void;
+			template<typename IndexType>
+			static auto GenerateQuad(std::span<Vertex> vertices, std::span<IndexType> indices, U32 tessellation) -> void;
+			template<typename IndexType>
+			static auto GeneratePlane(std::span<Vertex> vertices, std::span<IndexType> indices, U32 segmentsX, U32 segmentsZ, F32 width = 1.0f, F32 depth = 1.0f) -> void;
+			template<typename IndexType>
+			static auto GenerateBox(std::span<Vertex> vertices, std::span<IndexType> indices, U32 tessellation, Math::Vec3 const& size = Math::Vec3{ 1.0f }) -> void;
+			template<typename IndexType>
+			static auto GenerateCylinder(std::span<Vertex> vertices, std::span<IndexType> indices, U32 tessellation, F32 height = 1.0f, F32 radius = 0.5f) -> void;
+			template<typename IndexType>
+			static auto GenerateCone(std::span<Vertex> vertices, std::span<IndexType> indices, U32 tessellation, F32 height = 1.0f, F32 radius = 0.5f) -> void;
+			template<typename IndexType>
+			static auto GenerateTorus(std::span<Vertex> vertices, std::span<IndexType> indices, U32 tessellation, F32 majorRadius = 0.5f, F32 minorRadius = 0.25f) -> void;
+
 			template<typename VertexType, typename IndexType>
-			auto GenerateSphere(uint32_t teselation) -> Mesh<VertexType, IndexType> {
-				static_assert(std::is_same<VertexType, Vertex>::value, "Undefined vertex type");
-				static_assert(std::is_same<IndexType, uint16_t>::value || std::is_same<IndexType, uint32_t>::value, "Undefined index type");
-			}
+			static auto GenerateSphere(U32 tessellation, F32 radius = 1.0f) -> Mesh<VertexType, IndexType>;
+			template<typename VertexType, typename IndexType>
+			static auto GenerateIcosphere(U32 frequency, F32 radius = 1.0f) -> Mesh<VertexType, IndexType>;
+			template<typename VertexType, typename IndexType>
+			static auto GenerateQuad(U32 tessellation) -> Mesh<VertexType, IndexType>;
+			template<typename VertexType, typename IndexType>
+			static auto GeneratePlane(U32 segmentsX, U32 segmentsZ, F32 width = 1.0f, F32 depth = 1.0f) -> Mesh<VertexType, IndexType>;
+			template<typename VertexType, typename IndexType>
+			static auto GenerateBox(U32 tessellation, Math::Vec3 const& size = Math::Vec3{ 1.0f }) -> Mesh<VertexType, IndexType>;
+			template<typename VertexType, typename IndexType>
+			static auto GenerateCylinder(U32 tessellation, F32 height = 1.0f, F32 radius = 0.5f) -> Mesh<VertexType, IndexType>;
+			template<typename VertexType, typename IndexType>
+			static auto GenerateCone(U32 tessellation, F32 height = 1.0f, F32 radius = 0.5f) -> Mesh<VertexType, IndexType>;
+			template<typename VertexType, typename IndexType>
+			static auto GenerateTorus(U32 tessellation, F32 majorRadius = 0.5f, F32 minorRadius = 0.25f) -> Mesh<VertexType, IndexType>;
 
+		private:
 			template<typename VertexType, typename IndexType>
-			auto GenerateQuad(uint32_t teselation) -> Mesh<VertexType, IndexType> {
-				static_assert(std::is_same<VertexType, Vertex>::value, "Undefined vertex type");
-				static_assert(std::is_same<IndexType, uint16_t>::value || std::is_same<IndexType, uint32_t>::value, "Undefined index type");
+			static auto Allocate(MeshSize size) -> Mesh<VertexType, IndexType>;
+			template<typename IndexType>
+			static auto Validate(MeshSize size, std::span<Vertex> vertices, std::span<IndexType> indices) -> void;
+			template<typename IndexType>
+			static auto WriteQuad(IndexType*& indices, U32 a, U32 b, U32 c, U32 d, bool isFlipped) noexcept -> void;
+			template<typename IndexType>
+			static auto WriteGrid(Vertex* vertices, IndexType*& indices, U32 base, Math::Vec3 const& corner, Math::Vec3 const& axisU, Math::Vec3 const& axisV, Math::Vec3 const& normal, U32 segmentsU, U32 segmentsV) noexcept -> void;
+			template<typename IndexType>
+			static auto WriteDisk(Vertex* vertices, IndexType*& indices, U32 base, F32 y, F32 radius, F32 side, U32 tessellation) noexcept -> void;
+		};
+
+
+
+
+		template<typename T>
+		[[nodiscard]] auto ComputeTexcoord(std::vector<Math::Vec3> const& position, std::vector<T> const& indices) -> std::vector<Math::Vec2> {
+			static_assert(std::is_same<T, uint16_t>::value || std::is_same<T, uint32_t>::value, "Failed indices type");
+
+
+			std::vector<Math::Vec2> texcoords;
+			texcoords.reserve(position.size());
+			for (auto index = 0; index < position.size(); index += 4) {		
+				texcoords.push_back(Math::Vec2(0.0f, 1.0f));
+				texcoords.push_back(Math::Vec2(0.0f, 0.0f));
+				texcoords.push_back(Math::Vec2(1.0f, 0.0f));
+				texcoords.push_back(Math::Vec2(1.0f, 1.0f));
 			}
 
+			return texcoords;
+		}
 
-			//template<>
-			//[[nodiscard]] auto GenerateSphere(uint32_t tessellation) -> Mesh<Vertex, uint16_t> {
-			//	if (tessellation < 3)
-			//		throw std::out_of_range("Tesselation parameter out of range");
-			//
-			//	Mesh<Vertex, uint16_t> model;
-			//	size_t verticalSegments = tessellation;
-			//	size_t horizontalSegments = tessellation * 2;
-			//
-			//	for (size_t i = 0; i <= verticalSegments; i++) {
-			//		auto v = 1.0f - float(i) / verticalSegments;
-			//		auto latitude = (i * 3.14159265f / verticalSegments) - 3.14159265f / 2.0f;
-			//
-			//		auto dy = Math::Sin(latitude);
-			//		auto dxz = Math::Cos(latitude);
-			//
-			//		for (size_t j = 0; j <= horizontalSegments; j++) {
-			//			auto u = float(j) / horizontalSegments;
-			//
-			//			auto longitude = j * 2.0f * 3.14159265f / horizontalSegments;
-			//
-			//			auto dx = Math::Sin(longitude);
-			//			auto dz = Math::Cos(longitude);
-			//
-			//			dx *= dxz;
-			//			dz *= dxz;
-			//
-			//			auto normal = Math::Vec3(dx, dy, dz);
-			//			auto uv = Math::Vec2(u, v);
-			//
-			//			model.Vertices.push_back({ normal, normal, Math::Vec3(0.0f, 0.0f, 0.0f), uv });
-			//		}
-			//	}
-			//
-			//	size_t stride = horizontalSegments + 1;
-			//
-			//	for (size_t i = 0; i < verticalSegments; i++) {
-			//		for (size_t j = 0; j <= horizontalSegments; j++) {
-			//
-			//			size_t nextI = i + 1;
-			//			size_t nextJ = (j + 1) % stride;
-			//
-			//			model.Indices.push_back(static_cast<uint16_t>(i * stride + j));
-			//			model.Indices.push_back(static_cast<uint16_t>(nextI * stride + j));
-			//			model.Indices.push_back(static_cast<uint16_t>(i * stride + nextJ));
-			//
-			//			model.Indices.push_back(static_cast<uint16_t>(i * stride + nextJ));
-			//			model.Indices.push_back(static_cast<uint16_t>(nextI * stride + j));
-			//			model.Indices.push_back(static_cast<uint16_t>(nextI * stride + nextJ));
-			//
-			//		}
-			//	}
-			//
-			//	for (int index = 0; index < model.Indices.size(); index += 3) {
-			//		auto const& v0 = model.Vertices[model.Indices[index + 0]].Position;
-			//		auto const& v1 = model.Vertices[model.Indices[index + 1]].Position;
-			//		auto const& v2 = model.Vertices[model.Indices[index + 2]].Position;
-			//
-			//		auto const& uv0 = model.Vertices[model.Indices[index + 0]].Texcoord;
-			//		auto const& uv1 = model.Vertices[model.Indices[index + 1]].Texcoord;
-			//		auto const& uv2 = model.Vertices[model.Indices[index + 2]].Texcoord;
-			//
-			//		auto deltaUV1 = uv1 - uv0;
-			//		auto deltaUV2 = uv2 - uv0;
-			//
-			//		auto deltaPos1 = v1 - v0;
-			//		auto deltaPos2 = v2 - v0;
-			//
-			//		auto f = 1.0f / (deltaUV1.x * deltaUV2.y - deltaUV1.y * deltaUV2.x);
-			//		auto t = Math::Normalize(f * (deltaPos1 * deltaUV2.y - deltaPos2 * deltaUV1.y));
-			//
-			//		model.Vertices[model.Indices[index + 0]].Tangent = t;
-			//		model.Vertices[model.Indices[index + 1]].Tangent = t;
-			//		model.Vertices[model.Indices[index + 2]].Tangent = t;
-			//	}
-			//	return model;
-			//}
-
-			//template<>
-			//[[nodiscard]] auto GenerateQuad(uint32_t teselation) -> Mesh<Vertex, uint16_t> {
-			//
-			//	Math::Vec3 pos1(-1.0f, 1.0f, 0.0f);
-			//	Math::Vec3 pos2(-1.0f, -1.0f, 0.0f);
-			//	Math::Vec3 pos3(1.0f, -1.0f, 0.0f);
-			//	Math::Vec3 pos4(1.0f, 1.0f, 0.0f);
-			//
-			//	Math::Vec2 uv1(0.0f, 1.0f);
-			//	Math::Vec2 uv2(0.0f, 0.0f);
-			//	Math::Vec2 uv3(1.0f, 0.0f);
-			//	Math::Vec2 uv4(1.0f, 1.0f);
-			//
-			//	Math::Vec3 nm(0.0f, 0.0f, 1.0f);
-			//
-			//	Math::Vec3 tangent1, bitangent1;
-			//	Math::Vec3 tangent2, bitangent2;
-			//
-			//	Math::Vec3 edge1 = pos2 - pos1;
-			//	Math::Vec3 edge2 = pos3 - pos1;
-			//	Math::Vec2 deltaUV1 = uv2 - uv1;
-			//	Math::Vec2 deltaUV2 = uv3 - uv1;
-			//
-			//	float f = 1.0f / (deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y);
-			//
-			//	tangent1.x = f * (deltaUV2.y * edge1.x - deltaUV1.y * edge2.x);
-			//	tangent1.y = f * (deltaUV2.y * edge1.y - deltaUV1.y * edge2.y);
-			//	tangent1.z = f * (deltaUV2.y * edge1.z - deltaUV1.y * edge2.z);
-			//	tangent1 = Math::Normalize(tangent1);
-			//
-			//	bitangent1.x = f * (-deltaUV2.x * edge1.x + deltaUV1.x * edge2.x);
-			//	bitangent1.y = f * (-deltaUV2.x * edge1.y + deltaUV1.x * edge2.y);
-			//	bitangent1.z = f * (-deltaUV2.x * edge1.z + deltaUV1.x * edge2.z);
-			//	bitangent1 = Math::Normalize(bitangent1);
-			//
-			//	// triangle 2
-			//	// ----------
-			//	edge1 = pos3 - pos1;
-			//	edge2 = pos4 - pos1;
-			//	deltaUV1 = uv3 - uv1;
-			//	deltaUV2 = uv4 - uv1;
-			//
-			//	f = 1.0f / (deltaUV1.x * deltaUV2.y - deltaUV2.x * deltaUV1.y);
-			//
-			//	tangent2.x = f * (deltaUV2.y * edge1.x - deltaUV1.y * edge2.x);
-			//	tangent2.y = f * (deltaUV2.y * edge1.y - deltaUV1.y * edge2.y);
-			//	tangent2.z = f * (deltaUV2.y * edge1.z - deltaUV1.y * edge2.z);
-			//	tangent2 = Math::Normalize(tangent2);
-			//
-			//
-			//	bitangent2.x = f * (-deltaUV2.x * edge1.x + deltaUV1.x * edge2.x);
-			//	bitangent2.y = f * (-deltaUV2.x * edge1.y + deltaUV1.x * edge2.y);
-			//	bitangent2.z = f * (-deltaUV2.x * edge1.z + deltaUV1.x * edge2.z);
-			//	bitangent2 = Math::Normalize(bitangent2);
-			//
-			//
-			//	Mesh<Vertex, uint16_t> mesh;
-			//	mesh.Vertices.push_back({ pos1, nm, tangent1, uv1 });
-			//	mesh.Vertices.push_back({ pos2, nm, tangent1, uv2 });
-			//	mesh.Vertices.push_back({ pos3, nm, tangent1, uv3 });
-			//
-			//	mesh.Vertices.push_back({ pos1, nm, tangent2, uv1 });
-			//	mesh.Vertices.push_back({ pos3, nm, tangent2, uv3 });
-			//	mesh.Vertices.push_back({ pos4, nm, tangent2, uv4 });
-			//
-			//
-			//	mesh.Indices.push_back(0);
-			//	mesh.Indices.push_back(1);
-			//	mesh.Indices.push_back(2);
-			//	mesh.Indices.push_back(3);
-			//	mesh.Indices.push_back(4);
-			//	mesh.Indices.push_back(5);
-			//	return mesh;
-			//
-			//}
+	};
+}
 
-		};
+namespace Hawk {
+	namespace Geometry {
 
+		[[nodiscard]] ILINE auto Generator::SphereSize(U32 tessellation) -> MeshSize {
+			// Rows touching a pole keep one triangle per quad, the other one would be degenerate
+			auto const rows = tessellation;
+			auto const columns = 2 * tessellation;
+			return { (rows + 1) * (columns + 1), 6 * columns * (rows - 1) };
+		}
 
+		[[nodiscard]] ILINE auto Generator::IcosphereSize(U32 frequency) -> MeshSize {
+			// Every face of the icosahedron is split into its own triangular grid, so texcoords never need to wrap
+			return { 20 * (frequency + 1) * (frequency + 2) / 2, 20 * 3 * frequency * frequency };
+		}
 
+		[[nodiscard]] ILINE auto Generator::QuadSize(U32 tessellation) -> MeshSize {
+			return PlaneSize(tessellation, tessellation);
+		}
 
-		template<typename T>
-		[[nodiscard]] auto ComputeNormal(std::vector<Math::Vec3> const& position, std::vector<T> const& indices) -> std::vector<Math::Vec3> {
-			static_assert(std::is_same<T, uint16_t>::value || std::is_same<T, uint32_t>::value, "Failed indices type");
+		[[nodiscard]] ILINE auto Generator::PlaneSize(U32 segmentsX, U32 segmentsZ) -> MeshSize {
+			return { (segmentsX + 1) * (segmentsZ + 1), 6 * segmentsX * segmentsZ };
+		}
 
-			std::vector<Math::Vec3> normals;
-			for (auto index = 0; index < indices.size(); index += 3) {
+		[[nodiscard]] ILINE auto Generator::BoxSize(U32 tessellation) -> MeshSize {
+			auto const face = QuadSize(tessellation);
+			return { 6 * face.CountVertices, 6 * face.CountIndices };
+		}
 
-				auto v0 = position[indices[index + 0]];
-				auto v1 = position[indices[index + 1]];
-				auto v2 = position[indices[index + 2]];
+		[[nodiscard]] ILINE auto Generator::CylinderSize(U32 tessellation) -> MeshSize {
+			return { 2 * (tessellation + 1) + 2 * (tessellation + 1), 6 * tessellation + 2 * 3 * tessellation };
+		}
 
-	
-				auto normal = Math::Cross(Math::Normalize(v1 - v0), Math::Normalize(v2 - v0));
+		[[nodiscard]] ILINE auto Generator::ConeSize(U32 tessellation) -> MeshSize {
+			return { tessellation + (tessellation + 1) + (tessellation + 1), 3 * tessellation + 3 * tessellation };
+		}
 
-				normals.push_back(normal);
-				normals.push_back(normal);
-				normals.push_back(normal);
+		[[nodiscard]] ILINE auto Generator::TorusSize(U32 tessellation) -> MeshSize {
+			return { (tessellation + 1) * (tessellation + 1), 6 * tessellation * tessellation };
+		}
+
+		template<typename IndexType>
+		ILINE auto Generator::GenerateSphere(std::span<Vertex> vertices, std::span<IndexType> indices, U32 tessellation, F32 radius) -> void {
+			if (tessellation < 3)
+				throw std::out_of_range("Tesselation parameter out of range");
+			Validate(SphereSize(tessellation), vertices, indices);
+
+			auto const rows = tessellation;
+			auto const columns = 2 * tessellation;
+			auto* vertex = vertices.data();
+			for (auto row = 0u; row <= rows; row++) {
+				auto const theta = Math::PI<F32> * static_cast<F32>(row) / static_cast<F32>(rows);
+				auto const y = Math::Cos(theta);
+				auto const ring = Math::Sin(theta);
+				for (auto column = 0u; column <= columns; column++) {
+					auto const lambda = 2.0f * Math::PI<F32> * static_cast<F32>(column) / static_cast<F32>(columns);
+					auto const normal = Math::Vec3{ ring * Math::Sin(lambda), y, ring * Math::Cos(lambda) };
+					*vertex++ = Vertex{ radius * normal, normal, Math::Vec4{ Math::Cos(lambda), 0.0f, -Math::Sin(lambda), -1.0f }, Math::Vec2{ static_cast<F32>(column) / static_cast<F32>(columns), static_cast<F32>(row) / static_cast<F32>(rows) } };
+				}
 			}
 
-			return normals;
+			auto* index = indices.data();
+			auto const stride = columns + 1;
+			for (auto row = 0u; row < rows; row++) {
+				for (auto column = 0u; column < columns; column++) {
+					auto const a = row * stride + column;
+					auto const b = a + stride;
+					if (row != 0) {
+						*index++ = static_cast<IndexType>(a);
+						*index++ = static_cast<IndexType>(b);
+						*index++ = static_cast<IndexType>(a + 1);
+					}
+					if (row != rows - 1) {
+						*index++ = static_cast<IndexType>(a + 1);
+						*index++ = static_cast<IndexType>(b);
+						*index++ = static_cast<IndexType>(b + 1);
+					}
+				}
+			}
 		}
 
+		template<typename IndexType>
+		ILINE auto Generator::GenerateIcosphere(std::span<Vertex> vertices, std::span<IndexType> indices, U32 frequency, F32 radius) -> void {
+			if (frequency < 1)
+				throw std::out_of_range("Frequency parameter out of range");
+			Validate(IcosphereSize(frequency), vertices, indices);
+
+			constexpr auto t = 1.61803398875f;
+			Math::Vec3 const corners[12] = {
+				{ -1.0f,  t, 0.0f }, { 1.0f,  t, 0.0f }, { -1.0f, -t, 0.0f }, { 1.0f, -t, 0.0f },
+				{ 0.0f, -1.0f,  t }, { 0.0f, 1.0f,  t }, { 0.0f, -1.0f, -t }, { 0.0f, 1.0f, -t },
+				{  t, 0.0f, -1.0f }, {  t, 0.0f, 1.0f }, { -t, 0.0f, -1.0f }, { -t, 0.0f, 1.0f }
+			};
+			U8 const faces[20][3] = {
+				{ 0, 11, 5 }, { 0, 5, 1 },  { 0, 1, 7 },   { 0, 7, 10 }, { 0, 10, 11 },
+				{ 1, 5, 9 },  { 5, 11, 4 }, { 11, 10, 2 }, { 10, 7, 6 }, { 7, 1, 8 },
+				{ 3, 9, 4 },  { 3, 4, 2 },  { 3, 2, 6 },   { 3, 6, 8 },  { 3, 8, 9 },
+				{ 4, 9, 5 },  { 2, 4, 11 }, { 6, 2, 10 },  { 8, 6, 7 },  { 9, 8, 1 }
+			};
 
-		template<typename T>
-		[[nodiscard]] auto ComputeTexcoord(std::vector<Math::Vec3> const& position, std::vector<T> const& indices) -> std::vector<Math::Vec2> {
-			static_assert(std::is_same<T, uint16_t>::value || std::is_same<T, uint32_t>::value, "Failed indices type");
-
+			// Spherical mapping, unwrapped relative to the face centre so no face straddles the seam
+			auto const makeVertex = [radius](Math::Vec3 const& direction, F32 uCenter) {
+				auto const normal = Math::Normalize(direction);
+				auto const isPole = Math::Abs(normal.x) < 1e-6f && Math::Abs(normal.z) < 1e-6f;
+				auto const lambda = isPole ? 2.0f * Math::PI<F32> * (uCenter - 0.5f) : std::atan2(normal.x, normal.z);
+				auto u = lambda / (2.0f * Math::PI<F32>) + 0.5f;
+				u += u - uCenter > 0.5f ? -1.0f : u - uCenter < -0.5f ? 1.0f : 0.0f;
+				auto const v = Math::Acos(Math::Clamp(normal.y, -1.0f, 1.0f)) / Math::PI<F32>;
+				return Vertex{ radius * normal, normal, Math::Vec4{ Math::Cos(lambda), 0.0f, -Math::Sin(lambda), -1.0f }, Math::Vec2{ u, v } };
+			};
 
-			std::vector<Math::Vec2> texcoords;
-			for (auto index = 0; index < position.size(); index += 4) {		
-				texcoords.push_back(Math::Vec2(0.0f, 1.0f));
-				texcoords.push_back(Math::Vec2(0.0f, 0.0f));
-				texcoords.push_back(Math::Vec2(1.0f, 0.0f));
-				texcoords.push_back(Math::Vec2(1.0f, 1.0f));
+			auto* vertex = vertices.data();
+			auto* index = indices.data();
+			auto base = 0u;
+			for (auto const& face : faces) {
+				auto a = corners[face[0]];
+				auto b = corners[face[1]];
+				auto c = corners[face[2]];
+				if (Math::Dot(Math::Cross(b - a, c - a), a + b + c) < 0.0f)
+					std::swap(b, c);
+
+				auto const center = Math::Normalize(a + b + c);
+				auto const uCenter = std::atan2(center.x, center.z) / (2.0f * Math::PI<F32>) + 0.5f;
+				for (auto i = 0u; i <= frequency; i++)
+					for (auto j = 0u; j <= frequency - i; j++)
+						*vertex++ = makeVertex(a + (b - a) * (static_cast<F32>(i) / frequency) + (c - a) * (static_cast<F32>(j) / frequency), uCenter);
+
+				auto const offset = [frequency, base](U32 i, U32 j) { return base + i * (frequency + 1) - i * (i - 1) / 2 + j; };
+				for (auto i = 0u; i < frequency; i++) {
+					for (auto j = 0u; j < frequency - i; j++) {
+						*index++ = static_cast<IndexType>(offset(i, j));
+						*index++ = static_cast<IndexType>(offset(i + 1, j));
+						*index++ = static_cast<IndexType>(offset(i, j + 1));
+						if (j + 1 < frequency - i) {
+							*index++ = static_cast<IndexType>(offset(i + 1, j));
+							*index++ = static_cast<IndexType>(offset(i + 1, j + 1));
+							*index++ = static_cast<IndexType>(offset(i, j + 1));
+						}
+					}
+				}
+				base += (frequency + 1) * (frequency + 2) / 2;
 			}
+		}
 
-			return texcoords;
+		template<typename IndexType>
+		ILINE auto Generator::GenerateQuad(std::span<Vertex> vertices, std::span<IndexType> indices, U32 tessellation) -> void {
+			if (tessellation < 1)
+				throw std::out_of_range("Tesselation parameter out of range");
+			Validate(QuadSize(tessellation), vertices, indices);
+
+			auto* index = indices.data();
+			WriteGrid(vertices.data(), index, 0, Math::Vec3{ -1.0f, 1.0f, 0.0f }, Math::Vec3{ 2.0f, 0.0f, 0.0f }, Math::Vec3{ 0.0f, -2.0f, 0.0f }, Math::Vec3{ 0.0f, 0.0f, 1.0f }, tessellation, tessellation);
 		}
 
+		template<typename IndexType>
+		ILINE auto Generator::GeneratePlane(std::span<Vertex> vertices, std::span<IndexType> indices, U32 segmentsX, U32 segmentsZ, F32 width, F32 depth) -> void {
+			if (segmentsX < 1 || segmentsZ < 1)
+				throw std::out_of_range("Segment count out of range");
+			Validate(PlaneSize(segmentsX, segmentsZ), vertices, indices);
 
-		template<typename T>
-		[[nodiscard]]  auto ComputeTangentSpace(std::vector<Math::Vec3> const& position, std::vector<Math::Vec3> const& normals, std::vector<Math::Vec2> const& texcoord, std::vector<T> const& indices) -> std::vector<Math::Vec4> {
-			static_assert(std::is_same<T, uint16_t>::value || std::is_same<T, uint32_t>::value , "Failed indices type");
-
-			std::vector<Math::Vec4> tangents;
-			auto computeTangent = [](auto const& p0, auto const& p1, auto const& uv0, auto const& uv1, auto const& n) {
-				auto det = 1.0f / (uv1.x * uv1.y - uv1.y * uv1.x);
-				auto t = Math::Normalize(det * (p0 * uv1.y - p1 * uv0.y));
-				auto b = Math::Normalize(det * (p1 * uv0.x - p1 * uv1.x));
-				return Math::Vec4(Math::Normalize(t - n * Math::Dot(n, t)), Math::Dot(Math::Cross(n, t), b) < 0.0f ? -1.0f : 1.0f);
+			auto* index = indices.data();
+			WriteGrid(vertices.data(), index, 0, Math::Vec3{ -0.5f * width, 0.0f, 0.5f * depth }, Math::Vec3{ width, 0.0f, 0.0f }, Math::Vec3{ 0.0f, 0.0f, -depth }, Math::Vec3{ 0.0f, 1.0f, 0.0f }, segmentsX, segmentsZ);
+		}
+
+		template<typename IndexType>
+		ILINE auto Generator::GenerateBox(std::span<Vertex> vertices, std::span<IndexType> indices, U32 tessellation, Math::Vec3 const& size) -> void {
+			if (tessellation < 1)
+				throw std::out_of_range("Tesselation parameter out of range");
+			Validate(BoxSize(tessellation), vertices, indices);
+
+			// Each face is seen from outside with u to the right and v down: +Y and -Y look along -Z and +Z for "up"
+			struct Face { Math::Vec3 Normal, Up; };
+			Face const faces[6] = {
+				{ {  1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.0f } }, { { -1.0f, 0.0f, 0.0f }, { 0.0f, 1.0f,  0.0f } },
+				{ { 0.0f,  1.0f, 0.0f }, { 0.0f, 0.0f, 1.0f } }, { { 0.0f, -1.0f, 0.0f }, { 0.0f, 0.0f, -1.0f } },
+				{ { 0.0f, 0.0f,  1.0f }, { 0.0f, 1.0f, 0.0f } }, { { 0.0f, 0.0f, -1.0f }, { 0.0f, 1.0f,  0.0f } }
 			};
 
-			for (auto index = 0; index < indices.size(); index += 3) {
-				auto v0 = position[indices[index + 0]];
-				auto v1 = position[indices[index + 1]];
-				auto v2 = position[indices[index + 2]];
+			auto const half = 0.5f * size;
+			auto* index = indices.data();
+			auto const countFace = QuadSize(tessellation).CountVertices;
+			for (auto face = 0u; face < 6; face++) {
+				auto const& [normal, up] = faces[face];
+				auto const axisU = Math::Cross(normal, up) * size;
+				auto const axisV = -up * size;
+				auto const corner = normal * half - 0.5f * axisU - 0.5f * axisV;
+				WriteGrid(vertices.data() + face * countFace, index, face * countFace, corner, axisU, axisV, normal, tessellation, tessellation);
+			}
+		}
+
+		template<typename IndexType>
+		ILINE auto Generator::GenerateCylinder(std::span<Vertex> vertices, std::span<IndexType> indices, U32 tessellation, F32 height, F32 radius) -> void {
+			if (tessellation < 3)
+				throw std::out_of_range("Tesselation parameter out of range");
+			Validate(CylinderSize(tessellation), vertices, indices);
+
+			auto* vertex = vertices.data();
+			for (auto row = 0u; row < 2; row++) {
+				for (auto column = 0u; column <= tessellation; column++) {
+					auto const lambda = 2.0f * Math::PI<F32> * static_cast<F32>(column) / static_cast<F32>(tessellation);
+					auto const normal = Math::Vec3{ Math::Sin(lambda), 0.0f, Math::Cos(lambda) };
+					auto const position = Math::Vec3{ radius * normal.x, row == 0 ? 0.5f * height : -0.5f * height, radius * normal.z };
+					*vertex++ = Vertex{ position, normal, Math::Vec4{ Math::Cos(lambda), 0.0f, -Math::Sin(lambda), -1.0f }, Math::Vec2{ static_cast<F32>(column) / static_cast<F32>(tessellation), static_cast<F32>(row) } };
+				}
+			}
+
+			auto* index = indices.data();
+			for (auto column = 0u; column < tessellation; column++)
+				WriteQuad(index, column, column + tessellation + 1, column + 1, column + tessellation + 2, false);
 
-				auto uv0 = texcoord[indices[index + 0]];
-				auto uv1 = texcoord[indices[index + 1]];
-				auto uv2 = texcoord[indices[index + 2]];
+			auto const base = 2 * (tessellation + 1);
+			WriteDisk(vertices.data() + base, index, base, 0.5f * height, radius, 1.0f, tessellation);
+			WriteDisk(vertices.data() + base + tessellation + 1, index, base + tessellation + 1, -0.5f * height, radius, -1.0f, tessellation);
+		}
 
-				auto t0 = computeTangent(v1 - v0, v2 - v0, uv1 - uv0, uv2 - uv0, normals[indices[index + 0]]);
-				auto t1 = computeTangent(v2 - v1, v0 - v1, uv2 - uv1, uv0 - uv1, normals[indices[index + 1]]);
-				auto t2 = computeTangent(v0 - v2, v1 - v2, uv0 - uv2, uv1 - uv2, normals[indices[index + 2]]);
+		template<typename IndexType>
+		ILINE auto Generator::GenerateCone(std::span<Vertex> vertices, std::span<IndexType> indices, U32 tessellation, F32 height, F32 radius) -> void {
+			if (tessellation < 3)
+				throw std::out_of_range("Tesselation parameter out of range");
+			Validate(ConeSize(tessellation), vertices, indices);
+
+			// The apex is split per slice so each one can carry the normal of its own slice centre
+			auto const slope = Math::Normalize(Math::Vec2{ height, radius });
+			auto const makeVertex = [&](F32 column, bool isApex) {
+				auto const lambda = 2.0f * Math::PI<F32> * column / static_cast<F32>(tessellation);
+				auto const normal = Math::Vec3{ slope.x * Math::Sin(lambda), slope.y, slope.x * Math::Cos(lambda) };
+				auto const position = isApex ? Math::Vec3{ 0.0f, 0.5f * height, 0.0f } : Math::Vec3{ radius * Math::Sin(lambda), -0.5f * height, radius * Math::Cos(lambda) };
+				return Vertex{ position, normal, Math::Vec4{ Math::Cos(lambda), 0.0f, -Math::Sin(lambda), -1.0f }, Math::Vec2{ column / static_cast<F32>(tessellation), isApex ? 0.0f : 1.0f } };
+			};
 
-				tangents.push_back(t0);
-				tangents.push_back(t1);
-				tangents.push_back(t2);
+			auto* vertex = vertices.data();
+			for (auto column = 0u; column < tessellation; column++)
+				*vertex++ = makeVertex(static_cast<F32>(column) + 0.5f, true);
+			for (auto column = 0u; column <= tessellation; column++)
+				*vertex++ = makeVertex(static_cast<F32>(column), false);
+
+			auto* index = indices.data();
+			for (auto column = 0u; column < tessellation; column++) {
+				*index++ = static_cast<IndexType>(column);
+				*index++ = static_cast<IndexType>(tessellation + column);
+				*index++ = static_cast<IndexType>(tessellation + column + 1);
 			}
-			return tangents;
+
+			auto const base = 2 * tessellation + 1;
+			WriteDisk(vertices.data() + base, index, base, -0.5f * height, radius, -1.0f, tessellation);
 		}
 
+		template<typename IndexType>
+		ILINE auto Generator::GenerateTorus(std::span<Vertex> vertices, std::span<IndexType> indices, U32 tessellation, F32 majorRadius, F32 minorRadius) -> void {
+			if (tessellation < 3)
+				throw std::out_of_range("Tesselation parameter out of range");
+			Validate(TorusSize(tessellation), vertices, indices);
+
+			auto* vertex = vertices.data();
+			for (auto i = 0u; i <= tessellation; i++) {
+				auto const lambda = 2.0f * Math::PI<F32> * static_cast<F32>(i) / static_cast<F32>(tessellation);
+				auto const tangent = Math::Vec3{ Math::Cos(lambda), 0.0f, -Math::Sin(lambda) };
+				for (auto j = 0u; j <= tessellation; j++) {
+					auto const psi = 2.0f * Math::PI<F32> * static_cast<F32>(j) / static_cast<F32>(tessellation);
+					auto const normal = Math::Vec3{ Math::Cos(psi) * Math::Sin(lambda), Math::Sin(psi), Math::Cos(psi) * Math::Cos(lambda) };
+					auto const center = Math::Vec3{ majorRadius * Math::Sin(lambda), 0.0f, majorRadius * Math::Cos(lambda) };
+					*vertex++ = Vertex{ center + minorRadius * normal, normal, Math::Vec4{ tangent, 1.0f }, Math::Vec2{ static_cast<F32>(i) / static_cast<F32>(tessellation), static_cast<F32>(j) / static_cast<F32>(tessellation) } };
+				}
+			}
 
-	};
+			auto* index = indices.data();
+			auto const stride = tessellation + 1;
+			for (auto i = 0u; i < tessellation; i++)
+				for (auto j = 0u; j < tessellation; j++)
+					WriteQuad(index, i * stride + j, (i + 1) * stride + j, i * stride + j + 1, (i + 1) * stride + j + 1, false);
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto Generator::GenerateSphere(U32 tessellation, F32 radius) -> Mesh<VertexType, IndexType> {
+			auto mesh = Allocate<VertexType, IndexType>(SphereSize(tessellation));
+			GenerateSphere<IndexType>(mesh.Vertices, mesh.Indices, tessellation, radius);
+			return mesh;
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto Generator::GenerateIcosphere(U32 frequency, F32 radius) -> Mesh<VertexType, IndexType> {
+			auto mesh = Allocate<VertexType, IndexType>(IcosphereSize(frequency));
+			GenerateIcosphere<IndexType>(mesh.Vertices, mesh.Indices, frequency, radius);
+			return mesh;
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto Generator::GenerateQuad(U32 tessellation) -> Mesh<VertexType, IndexType> {
+			auto mesh = Allocate<VertexType, IndexType>(QuadSize(tessellation));
+			GenerateQuad<IndexType>(mesh.Vertices, mesh.Indices, tessellation);
+			return mesh;
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto Generator::GeneratePlane(U32 segmentsX, U32 segmentsZ, F32 width, F32 depth) -> Mesh<VertexType, IndexType> {
+			auto mesh = Allocate<VertexType, IndexType>(PlaneSize(segmentsX, segmentsZ));
+			GeneratePlane<IndexType>(mesh.Vertices, mesh.Indices, segmentsX, segmentsZ, width, depth);
+			return mesh;
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto Generator::GenerateBox(U32 tessellation, Math::Vec3 const& size) -> Mesh<VertexType, IndexType> {
+			auto mesh = Allocate<VertexType, IndexType>(BoxSize(tessellation));
+			GenerateBox<IndexType>(mesh.Vertices, mesh.Indices, tessellation, size);
+			return mesh;
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto Generator::GenerateCylinder(U32 tessellation, F32 height, F32 radius) -> Mesh<VertexType, IndexType> {
+			auto mesh = Allocate<VertexType, IndexType>(CylinderSize(tessellation));
+			GenerateCylinder<IndexType>(mesh.Vertices, mesh.Indices, tessellation, height, radius);
+			return mesh;
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto Generator::GenerateCone(U32 tessellation, F32 height, F32 radius) -> Mesh<VertexType, IndexType> {
+			auto mesh = Allocate<VertexType, IndexType>(ConeSize(tessellation));
+			GenerateCone<IndexType>(mesh.Vertices, mesh.Indices, tessellation, height, radius);
+			return mesh;
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto Generator::GenerateTorus(U32 tessellation, F32 majorRadius, F32 minorRadius) -> Mesh<VertexType, IndexType> {
+			auto mesh = Allocate<VertexType, IndexType>(TorusSize(tessellation));
+			GenerateTorus<IndexType>(mesh.Vertices, mesh.Indices, tessellation, majorRadius, minorRadius);
+			return mesh;
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto Generator::Allocate(MeshSize size) -> Mesh<VertexType, IndexType> {
+			static_assert(std::is_same<VertexType, Vertex>::value, "Undefined vertex type");
+			static_assert(std::is_same<IndexType, uint16_t>::value || std::is_same<IndexType, uint32_t>::value, "Undefined index type");
+			auto mesh = Mesh<VertexType, IndexType>{};
+			mesh.Vertices.resize(size.CountVertices);
+			mesh.Indices.resize(size.CountIndices);
+			return mesh;
+		}
+
+		template<typename IndexType>
+		ILINE auto Generator::Validate(MeshSize size, std::span<Vertex> vertices, std::span<IndexType> indices) -> void {
+			static_assert(std::is_same<IndexType, uint16_t>::value || std::is_same<IndexType, uint32_t>::value, "Undefined index type");
+			if (size.CountVertices - 1 > (std::numeric_limits<IndexType>::max)())
+				throw std::out_of_range("Primitive has more vertices than the index type can address");
+			if (vertices.size() < size.CountVertices || indices.size() < size.CountIndices)
+				throw std::length_error("Output spans are smaller than the primitive");
+		}
+
+		// Emits the two triangles of the quad a-b-c-d, where a-b runs along v and a-c along u
+		template<typename IndexType>
+		ILINE auto Generator::WriteQuad(IndexType*& indices, U32 a, U32 b, U32 c, U32 d, bool isFlipped) noexcept -> void {
+			IndexType const quad[6] = {
+				static_cast<IndexType>(a), static_cast<IndexType>(isFlipped ? c : b), static_cast<IndexType>(isFlipped ? b : c),
+				static_cast<IndexType>(c), static_cast<IndexType>(isFlipped ? d : b), static_cast<IndexType>(isFlipped ? b : d)
+			};
+			std::copy(std::begin(quad), std::end(quad), indices);
+			indices += 6;
+		}
+
+		template<typename IndexType>
+		ILINE auto Generator::WriteGrid(Vertex* vertices, IndexType*& indices, U32 base, Math::Vec3 const& corner, Math::Vec3 const& axisU, Math::Vec3 const& axisV, Math::Vec3 const& normal, U32 segmentsU, U32 segmentsV) noexcept -> void {
+			auto const tangent = Math::Normalize(axisU);
+			auto const sign = Math::Dot(Math::Cross(normal, tangent), axisV) < 0.0f ? -1.0f : 1.0f;
+			for (auto row = 0u; row <= segmentsV; row++) {
+				auto const v = static_cast<F32>(row) / static_cast<F32>(segmentsV);
+				for (auto column = 0u; column <= segmentsU; column++) {
+					auto const u = static_cast<F32>(column) / static_cast<F32>(segmentsU);
+					*vertices++ = Vertex{ corner + u * axisU + v * axisV, normal, Math::Vec4{ tangent, sign }, Math::Vec2{ u, v } };
+				}
+			}
+
+			auto const isFlipped = Math::Dot(Math::Cross(axisV, axisU), normal) < 0.0f;
+			auto const stride = segmentsU + 1;
+			for (auto row = 0u; row < segmentsV; row++)
+				for (auto column = 0u; column < segmentsU; column++)
+					WriteQuad(indices, base + row * stride + column, base + (row + 1) * stride + column, base + row * stride + column + 1, base + (row + 1) * stride + column + 1, isFlipped);
+		}
+
+		// Cap of a cylinder or cone: a centre vertex and a ring facing side (+1 up, -1 down), mapped like the box's Y faces
+		template<typename IndexType>
+		ILINE auto Generator::WriteDisk(Vertex* vertices, IndexType*& indices, U32 base, F32 y, F32 radius, F32 side, U32 tessellation) noexcept -> void {
+			auto const normal = Math::Vec3{ 0.0f, side, 0.0f };
+			auto const tangent = Math::Vec4{ 1.0f, 0.0f, 0.0f, 1.0f };
+			*vertices++ = Vertex{ Math::Vec3{ 0.0f, y, 0.0f }, normal, tangent, Math::Vec2{ 0.5f, 0.5f } };
+			for (auto column = 0u; column < tessellation; column++) {
+				auto const lambda = 2.0f * Math::PI<F32> * static_cast<F32>(column) / static_cast<F32>(tessellation);
+				auto const x = Math::Sin(lambda);
+				auto const z = Math::Cos(lambda);
+				*vertices++ = Vertex{ Math::Vec3{ radius * x, y, radius * z }, normal, tangent, Math::Vec2{ 0.5f + 0.5f * x, 0.5f - 0.5f * side * z } };
+			}
+
+			for (auto column = 0u; column < tessellation; column++) {
+				auto const next = (column + 1) % tessellation;
+				*indices++ = static_cast<IndexType>(base);
+				*indices++ = static_cast<IndexType>(base + 1 + (side > 0.0f ? column : next));
+				*indices++ = static_cast<IndexType>(base + 1 + (side > 0.0f ? next : column));
+			}
+		}
+
+	}
 }
 
+namespace Hawk {
+
+	template<>
+	struct SoALayout<Geometry::Vertex> : SoAMembers<&Geometry::Vertex::Position, &Geometry::Vertex::Normal, &Geometry::Vertex::Tangent, &Geometry::Vertex::Texcoord> {};
+
+}
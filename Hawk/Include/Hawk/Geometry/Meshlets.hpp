@@ -0,0 +1,359 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+#include "../Common/Jobs.hpp"
+#include "../Math/Math.hpp"
+#include "./Generator.hpp"
+#include "./Normals.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/Jobs.hpp>
+//#include <Hawk/Math/Math.hpp>
+//#include <Hawk/Geometry/Generator.hpp>
+//#include <Hawk/Geometry/Normals.hpp>
+
+namespace Hawk {
+	namespace Geometry {
+
+		// Local indices are bytes, so a meshlet references at most 256 vertices; triangles are capped at 512
+		struct MeshletLimits {
+			U32 MaxVertices  = 64;
+			U32 MaxTriangles = 124;
+		};
+
+		// VertexOffset indexes MeshletSet::Vertices, TriangleOffset the triangles of MeshletSet::Triangles
+		struct Meshlet {
+			U32 VertexOffset;
+			U32 TriangleOffset;
+			U32 CountVertices;
+			U32 CountTriangles;
+		};
+
+		// The meshlet faces away from every viewer with dot(normalize(ConeApex - viewer), ConeAxis) >= ConeCutoff.
+		// A meshlet whose normals spread too far for a useful cone gets a zero axis and a cutoff of one.
+		struct MeshletBounds {
+			Math::Vec3 Center;
+			F32        Radius;
+			Math::Vec3 ConeApex;
+			F32        ConeCutoff;
+			Math::Vec3 ConeAxis;
+		};
+
+		struct MeshletSet {
+			std::vector<Meshlet>       Meshlets;
+			std::vector<MeshletBounds> Bounds;
+			std::vector<U32>           Vertices;
+			std::vector<U8>            Triangles;
+		};
+
+		// Planes as (a, b, c, d) with unit normals pointing inwards; a point is inside when a*x + b*y + c*z + d >= 0
+		struct Frustum {
+			F32 Planes[6][4];
+		};
+
+		// Grows every meshlet from the triangles next to the ones it already holds, preferring triangles that add
+		// the fewest vertices and then those whose vertices have the fewest triangles left outside. Every input
+		// triangle lands in exactly one meshlet, degenerate ones included.
+		template<typename IndexType>
+		auto BuildMeshlets(std::span<Vertex const> vertices, std::span<IndexType const> indices, MeshletLimits const& limits = {}, Jobs::Scheduler* pScheduler = nullptr) -> MeshletSet;
+
+		auto ComputeMeshletBounds(std::span<Vertex const> vertices, MeshletSet const& set, Meshlet const& meshlet) noexcept -> MeshletBounds;
+
+		// Extracted from a clip-from-space matrix (column vectors, depth in [0, w]), so the planes live in the
+		// space the matrix transforms from: pass the world-view-projection to cull in model space
+		auto ExtractFrustum(Math::Mat4x4 const& clipFromSpace) noexcept -> Frustum;
+
+		auto IsSphereVisible(Frustum const& frustum, Math::Vec3 const& center, F32 radius) noexcept -> bool;
+		auto IsConeBackfacing(MeshletBounds const& bounds, Math::Vec3 const& viewPosition) noexcept -> bool;
+		auto IsMeshletVisible(MeshletBounds const& bounds, Frustum const& frustum, Math::Vec3 const& viewPosition) noexcept -> bool;
+
+		// Writes the ids of the meshlets that survive frustum and cone culling to the front of visible, which
+		// must hold one entry per meshlet, and returns how many there are
+		auto CullMeshlets(std::span<MeshletBounds const> bounds, Frustum const& frustum, Math::Vec3 const& viewPosition, std::span<U32> visible) -> size_t;
+
+		namespace Detail {
+
+			constexpr U32 MeshletMaxVertices = 256;
+			constexpr U32 MeshletMaxTriangles = 512;
+
+			// A minimum dot product below this leaves a cone wider than ~170 degrees, which culls next to nothing
+			constexpr F32 MeshletConeMinimumDot = 0.1f;
+
+			template<typename IndexType>
+			auto PartitionMeshlets(std::span<IndexType const> indices, size_t countVertices, MeshletLimits const& limits, MeshletSet& set) -> void;
+
+		}
+	}
+}
+
+namespace Hawk {
+	namespace Geometry {
+
+		template<typename IndexType>
+		[[nodiscard]] ILINE auto BuildMeshlets(std::span<Vertex const> vertices, std::span<IndexType const> indices, MeshletLimits const& limits, Jobs::Scheduler* pScheduler) -> MeshletSet {
+			if (indices.size() % 3 != 0)
+				throw std::length_error("Index count is not a multiple of three");
+			if (limits.MaxVertices < 3 || limits.MaxVertices > Detail::MeshletMaxVertices || limits.MaxTriangles < 1 || limits.MaxTriangles > Detail::MeshletMaxTriangles)
+				throw std::out_of_range("Meshlet limits out of range");
+
+			auto set = MeshletSet{};
+			Detail::PartitionMeshlets(indices, vertices.size(), limits, set);
+
+			set.Bounds.resize(set.Meshlets.size());
+			Detail::ParallelRange(pScheduler, static_cast<U32>(set.Meshlets.size()), [&](U32 begin, U32 end) {
+				for (auto index = begin; index < end; index++)
+					set.Bounds[index] = ComputeMeshletBounds(vertices, set, set.Meshlets[index]);
+			});
+			return set;
+		}
+
+		// Ritter's sphere around the vertices; the cone apex sits on the axis far enough behind the meshlet to
+		// lie below the plane of every triangle, so the test holds for viewers anywhere, not just far away
+		[[nodiscard]] ILINE auto ComputeMeshletBounds(std::span<Vertex const> vertices, MeshletSet const& set, Meshlet const& meshlet) noexcept -> MeshletBounds {
+			auto const position = [&](U32 local) -> Math::Vec3 const& { return vertices[set.Vertices[meshlet.VertexOffset + local]].Position; };
+			auto const distanceSquared = [](Math::Vec3 const& a, Math::Vec3 const& b) {
+				auto const x = a.x - b.x, y = a.y - b.y, z = a.z - b.z;
+				return x * x + y * y + z * z;
+			};
+
+			auto result = MeshletBounds{};
+			if (meshlet.CountVertices == 0)
+				return result;
+
+			U32 extremes[3][2] = {};
+			for (auto local = U32{ 0 }; local < meshlet.CountVertices; local++) {
+				auto const& p = position(local);
+				for (auto axis = 0u; axis < 3; axis++) {
+					if (p[axis] < position(extremes[axis][0])[axis])
+						extremes[axis][0] = local;
+					if (p[axis] > position(extremes[axis][1])[axis])
+						extremes[axis][1] = local;
+				}
+			}
+			auto widest = 0u;
+			for (auto axis = 1u; axis < 3; axis++)
+				if (distanceSquared(position(extremes[axis][0]), position(extremes[axis][1])) > distanceSquared(position(extremes[widest][0]), position(extremes[widest][1])))
+					widest = axis;
+
+			auto const& a = position(extremes[widest][0]);
+			auto const& b = position(extremes[widest][1]);
+			auto cx = 0.5f * (a.x + b.x), cy = 0.5f * (a.y + b.y), cz = 0.5f * (a.z + b.z);
+			auto radius = 0.5f * Math::Sqrt(distanceSquared(a, b));
+			for (auto local = U32{ 0 }; local < meshlet.CountVertices; local++) {
+				auto const& p = position(local);
+				auto const dx = p.x - cx, dy = p.y - cy, dz = p.z - cz;
+				auto const distance = Math::Sqrt(dx * dx + dy * dy + dz * dz);
+				if (distance > radius) {
+					auto const shift = 0.5f * (distance - radius) / distance;
+					cx += dx * shift;
+					cy += dy * shift;
+					cz += dz * shift;
+					radius = 0.5f * (radius + distance);
+				}
+			}
+			result.Center = Math::Vec3{ cx, cy, cz };
+			result.Radius = radius;
+			result.ConeApex = result.Center;
+			result.ConeCutoff = 1.0f;
+			result.ConeAxis = Math::Vec3{ 0.0f, 0.0f, 0.0f };
+
+			// Unit triangle normals; degenerate triangles face nowhere and are left out of the cone
+			auto normals = std::array<F32, 3 * Detail::MeshletMaxTriangles>{};
+			auto const countTriangles = (std::min)(meshlet.CountTriangles, Detail::MeshletMaxTriangles);
+			auto ax = 0.0f, ay = 0.0f, az = 0.0f;
+			for (auto triangle = U32{ 0 }; triangle < countTriangles; triangle++) {
+				auto const* local = &set.Triangles[3 * (static_cast<size_t>(meshlet.TriangleOffset) + triangle)];
+				auto const& p0 = position(local[0]);
+				auto const& p1 = position(local[1]);
+				auto const& p2 = position(local[2]);
+				auto const e1x = p1.x - p0.x, e1y = p1.y - p0.y, e1z = p1.z - p0.z;
+				auto const e2x = p2.x - p0.x, e2y = p2.y - p0.y, e2z = p2.z - p0.z;
+				auto nx = e1y * e2z - e1z * e2y, ny = e1z * e2x - e1x * e2z, nz = e1x * e2y - e1y * e2x;
+				auto const length = Math::Sqrt(nx * nx + ny * ny + nz * nz);
+				auto const scale = length > 0.0f ? 1.0f / length : 0.0f;
+				nx *= scale; ny *= scale; nz *= scale;
+				normals[3 * triangle + 0] = nx;
+				normals[3 * triangle + 1] = ny;
+				normals[3 * triangle + 2] = nz;
+				ax += nx; ay += ny; az += nz;
+			}
+
+			auto const axisLength = Math::Sqrt(ax * ax + ay * ay + az * az);
+			if (axisLength <= 0.0f)
+				return result;
+			ax /= axisLength; ay /= axisLength; az /= axisLength;
+
+			auto minimumDot = 1.0f;
+			for (auto triangle = U32{ 0 }; triangle < countTriangles; triangle++) {
+				auto const* n = &normals[3 * triangle];
+				if (n[0] != 0.0f || n[1] != 0.0f || n[2] != 0.0f)
+					minimumDot = (std::min)(minimumDot, n[0] * ax + n[1] * ay + n[2] * az);
+			}
+			if (minimumDot < Detail::MeshletConeMinimumDot)
+				return result;
+
+			auto maximumT = 0.0f;
+			for (auto triangle = U32{ 0 }; triangle < countTriangles; triangle++) {
+				auto const* n = &normals[3 * triangle];
+				if (n[0] == 0.0f && n[1] == 0.0f && n[2] == 0.0f)
+					continue;
+				auto const& p0 = position(set.Triangles[3 * (static_cast<size_t>(meshlet.TriangleOffset) + triangle)]);
+				auto const dc = (cx - p0.x) * n[0] + (cy - p0.y) * n[1] + (cz - p0.z) * n[2];
+				auto const dn = ax * n[0] + ay * n[1] + az * n[2];
+				maximumT = (std::max)(maximumT, dc / dn);
+			}
+
+			result.ConeApex = Math::Vec3{ cx - ax * maximumT, cy - ay * maximumT, cz - az * maximumT };
+			result.ConeAxis = Math::Vec3{ ax, ay, az };
+			result.ConeCutoff = Math::Sqrt(1.0f - minimumDot * minimumDot);
+			return result;
+		}
+
+		[[nodiscard]] ILINE auto ExtractFrustum(Math::Mat4x4 const& clipFromSpace) noexcept -> Frustum {
+			auto const& m = clipFromSpace;
+			auto result = Frustum{};
+			for (auto column = 0u; column < 4; column++) {
+				result.Planes[0][column] = m(3, column) + m(0, column);
+				result.Planes[1][column] = m(3, column) - m(0, column);
+				result.Planes[2][column] = m(3, column) + m(1, column);
+				result.Planes[3][column] = m(3, column) - m(1, column);
+				result.Planes[4][column] = m(2, column);
+				result.Planes[5][column] = m(3, column) - m(2, column);
+			}
+			for (auto& plane : result.Planes) {
+				auto const length = Math::Sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+				auto const scale = length > 0.0f ? 1.0f / length : 0.0f;
+				for (auto& value : plane)
+					value *= scale;
+			}
+			return result;
+		}
+
+		[[nodiscard]] ILINE auto IsSphereVisible(Frustum const& frustum, Math::Vec3 const& center, F32 radius) noexcept -> bool {
+			for (auto const& plane : frustum.Planes)
+				if (plane[0] * center.x + plane[1] * center.y + plane[2] * center.z + plane[3] < -radius)
+					return false;
+			return true;
+		}
+
+		[[nodiscard]] ILINE auto IsConeBackfacing(MeshletBounds const& bounds, Math::Vec3 const& viewPosition) noexcept -> bool {
+			auto const dx = bounds.ConeApex.x - viewPosition.x, dy = bounds.ConeApex.y - viewPosition.y, dz = bounds.ConeApex.z - viewPosition.z;
+			auto const dot = dx * bounds.ConeAxis.x + dy * bounds.ConeAxis.y + dz * bounds.ConeAxis.z;
+			return dot >= bounds.ConeCutoff * Math::Sqrt(dx * dx + dy * dy + dz * dz);
+		}
+
+		[[nodiscard]] ILINE auto IsMeshletVisible(MeshletBounds const& bounds, Frustum const& frustum, Math::Vec3 const& viewPosition) noexcept -> bool {
+			return IsSphereVisible(frustum, bounds.Center, bounds.Radius) && !IsConeBackfacing(bounds, viewPosition);
+		}
+
+		[[nodiscard]] ILINE auto CullMeshlets(std::span<MeshletBounds const> bounds, Frustum const& frustum, Math::Vec3 const& viewPosition, std::span<U32> visible) -> size_t {
+			if (visible.size() < bounds.size())
+				throw std::length_error("Visible list is shorter than the meshlet list");
+
+			auto count = size_t{ 0 };
+			for (auto index = U32{ 0 }; index < bounds.size(); index++) {
+				visible[count] = index;
+				count += IsMeshletVisible(bounds[index], frustum, viewPosition);
+			}
+			return count;
+		}
+
+		namespace Detail {
+
+			// Live triangle lists per vertex shrink as triangles are emitted, so vertices fully inside the meshlet
+			// cost nothing to scan. When no neighbour is left the next meshlet is seeded from the first unused
+			// triangle in index order, which after a cache pass is close to the last one.
+			template<typename IndexType>
+			ILINE auto PartitionMeshlets(std::span<IndexType const> indices, size_t countVertices, MeshletLimits const& limits, MeshletSet& set) -> void {
+				constexpr auto Invalid = (std::numeric_limits<U32>::max)();
+
+				auto const countTriangles = static_cast<U32>(indices.size() / 3);
+				auto adjacency = ComputeVertexCorners(indices, countVertices);
+				for (auto& corner : adjacency.Corners)
+					corner /= 3;
+
+				auto live = std::vector<U32>(countVertices);
+				for (auto vertex = size_t{ 0 }; vertex < countVertices; vertex++)
+					live[vertex] = adjacency.Offsets[vertex + 1] - adjacency.Offsets[vertex];
+
+				auto emitted = std::vector<U8>(countTriangles, 0);
+				auto local = std::vector<U32>(countVertices, Invalid);
+				auto cursor = U32{ 0 };
+
+				set.Meshlets.reserve(countTriangles / limits.MaxTriangles + 1);
+				set.Triangles.reserve(indices.size());
+				auto meshlet = Meshlet{ 0, 0, 0, 0 };
+
+				auto const countNew = [&](U32 triangle) {
+					auto const a = static_cast<U32>(indices[3 * triangle + 0]);
+					auto const b = static_cast<U32>(indices[3 * triangle + 1]);
+					auto const c = static_cast<U32>(indices[3 * triangle + 2]);
+					return U32{ local[a] == Invalid } + U32{ local[b] == Invalid && b != a } + U32{ local[c] == Invalid && c != a && c != b };
+				};
+				auto const close = [&]() {
+					for (auto index = meshlet.VertexOffset; index < meshlet.VertexOffset + meshlet.CountVertices; index++)
+						local[set.Vertices[index]] = Invalid;
+					set.Meshlets.push_back(meshlet);
+					meshlet = Meshlet{ static_cast<U32>(set.Vertices.size()), static_cast<U32>(set.Triangles.size() / 3), 0, 0 };
+				};
+
+				for (auto countEmitted = U32{ 0 }; countEmitted < countTriangles;) {
+					auto best = Invalid;
+					auto bestNew = U32{ 4 };
+					auto bestLive = Invalid;
+					for (auto index = meshlet.VertexOffset; index < meshlet.VertexOffset + meshlet.CountVertices && bestNew > 0; index++) {
+						auto const vertex = set.Vertices[index];
+						for (auto offset = adjacency.Offsets[vertex]; offset < adjacency.Offsets[vertex] + live[vertex]; offset++) {
+							auto const triangle = adjacency.Corners[offset];
+							auto const added = countNew(triangle);
+							auto const remaining = live[indices[3 * triangle + 0]] + live[indices[3 * triangle + 1]] + live[indices[3 * triangle + 2]];
+							if (added < bestNew || (added == bestNew && remaining < bestLive)) {
+								best = triangle;
+								bestNew = added;
+								bestLive = remaining;
+							}
+						}
+					}
+					if (best == Invalid) {
+						while (emitted[cursor])
+							cursor++;
+						best = cursor;
+						bestNew = countNew(best);
+					}
+
+					if (meshlet.CountVertices + bestNew > limits.MaxVertices || meshlet.CountTriangles + 1 > limits.MaxTriangles) {
+						close();
+						continue;
+					}
+
+					for (auto corner = 3 * best; corner < 3 * best + 3; corner++) {
+						auto const vertex = static_cast<U32>(indices[corner]);
+						if (local[vertex] == Invalid) {
+							local[vertex] = meshlet.CountVertices++;
+							set.Vertices.push_back(vertex);
+						}
+						set.Triangles.push_back(static_cast<U8>(local[vertex]));
+
+						// A degenerate triangle sits in a vertex's list once per corner, so each corner drops one entry
+						auto const first = adjacency.Offsets[vertex];
+						auto const last = first + --live[vertex];
+						std::swap(*std::find(adjacency.Corners.begin() + first, adjacency.Corners.begin() + last + 1, best), adjacency.Corners[last]);
+					}
+					emitted[best] = 1;
+					meshlet.CountTriangles++;
+					countEmitted++;
+				}
+				if (meshlet.CountTriangles > 0)
+					close();
+			}
+
+		}
+	}
+}
\ No newline at end of file
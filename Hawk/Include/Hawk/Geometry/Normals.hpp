@@ -0,0 +1,392 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAWK_GEOMETRY_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include "../Common/Defines.hpp"
+#include "../Common/Jobs.hpp"
+#include "../Containers/SmallVector.hpp"
+#include "../Math/Math.hpp"
+#include "./Generator.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/Jobs.hpp>
+//#include <Hawk/Containers/SmallVector.hpp>
+//#include <Hawk/Math/Math.hpp>
+//#include <Hawk/Geometry/Generator.hpp>
+
+namespace Hawk {
+	namespace Geometry {
+
+		enum class NormalWeighting : U8 {
+			Uniform,
+			Area,
+			Angle
+		};
+
+		// Output of a crease split: Remap[i] is the source vertex the i-th output vertex was copied from
+		struct NormalSplit {
+			std::vector<Math::Vec3> Normals;
+			std::vector<U32>        Remap;
+		};
+
+		// Smooth normals: each vertex gets the weighted average of the faces referencing it. Face normals follow
+		// the engine's winding, Cross(b - a, c - a) points out of the front face. Vertices referenced only by
+		// degenerate triangles get a zero normal. Passing a scheduler spreads both passes over its workers.
+		template<typename IndexType>
+		auto ComputeNormals(std::span<Math::Vec3 const> positions, std::span<IndexType const> indices, std::span<Math::Vec3> normals, NormalWeighting weighting = NormalWeighting::Angle, Jobs::Scheduler* pScheduler = nullptr) -> void;
+
+		// Faces only smooth across a vertex while their normals are within creaseAngle (radians) of each other,
+		// anything sharper gets its own copy of the vertex. Indices are rewritten in place to the output vertices,
+		// which keep the order of their sources; vertices no triangle references are dropped.
+		template<typename IndexType>
+		auto ComputeNormals(std::span<Math::Vec3 const> positions, std::span<IndexType> indices, F32 creaseAngle, NormalWeighting weighting = NormalWeighting::Angle, Jobs::Scheduler* pScheduler = nullptr) -> NormalSplit;
+
+		template<typename IndexType>
+		auto ComputeNormals(Mesh<Vertex, IndexType>& mesh, F32 creaseAngle = Math::PI<F32>, NormalWeighting weighting = NormalWeighting::Angle, Jobs::Scheduler* pScheduler = nullptr) -> void;
+
+		namespace Detail {
+
+			template<typename T>
+			struct Strided {
+				using Byte = std::conditional_t<std::is_const_v<T>, U8 const, U8>;
+
+				Byte*  Data;
+				size_t Stride;
+
+				auto operator[](size_t index) const noexcept -> T& { return *reinterpret_cast<T*>(Data + index * Stride); }
+			};
+
+			// Unit face normal and per-corner weights of one triangle, kept together so a corner costs one cache line
+			struct FaceNormal {
+				Math::Vec3 Normal;
+				F32        Weights[3];
+			};
+
+			// Corners grouped by the vertex they reference, so a vertex is reduced by exactly one job and the
+			// scatter of face normals into vertices needs no atomics
+			struct VertexCorners {
+				std::vector<U32> Offsets;
+				std::vector<U32> Corners;
+			};
+
+			template<typename F>
+			auto ParallelRange(Jobs::Scheduler* pScheduler, U32 count, F&& function) -> void;
+
+			auto NormalizeOrZero(Math::Vec3 const& v) noexcept -> Math::Vec3;
+			auto AcosApproximate(F32 x) noexcept -> F32;
+
+			template<typename F>
+			auto AccumulateCorners(std::vector<FaceNormal> const& faces, VertexCorners const& adjacency, U32 vertex, F&& filter) noexcept -> Math::Vec3;
+
+			template<typename IndexType>
+			auto ComputeVertexCorners(std::span<IndexType const> indices, size_t countVertices) -> VertexCorners;
+			template<typename IndexType>
+			auto ComputeFaceNormals(Strided<Math::Vec3 const> positions, std::span<IndexType const> indices, NormalWeighting weighting, Jobs::Scheduler* pScheduler) -> std::vector<FaceNormal>;
+			template<typename IndexType>
+			auto ComputeSmoothNormals(Strided<Math::Vec3 const> positions, size_t countVertices, std::span<IndexType const> indices, Strided<Math::Vec3> normals, NormalWeighting weighting, Jobs::Scheduler* pScheduler) -> void;
+			template<typename IndexType>
+			auto ComputeCreaseNormals(Strided<Math::Vec3 const> positions, size_t countVertices, std::span<IndexType> indices, F32 creaseAngle, NormalWeighting weighting, Jobs::Scheduler* pScheduler) -> NormalSplit;
+
+		}
+	}
+}
+
+namespace Hawk {
+	namespace Geometry {
+
+		template<typename IndexType>
+		ILINE auto ComputeNormals(std::span<Math::Vec3 const> positions, std::span<IndexType const> indices, std::span<Math::Vec3> normals, NormalWeighting weighting, Jobs::Scheduler* pScheduler) -> void {
+			if (normals.size() < positions.size())
+				throw std::length_error("Normal span is smaller than the position span");
+			Detail::ComputeSmoothNormals(Detail::Strided<Math::Vec3 const>{ reinterpret_cast<U8 const*>(positions.data()), sizeof(Math::Vec3) }, positions.size(), indices,
+				Detail::Strided<Math::Vec3>{ reinterpret_cast<U8*>(normals.data()), sizeof(Math::Vec3) }, weighting, pScheduler);
+		}
+
+		template<typename IndexType>
+		[[nodiscard]] ILINE auto ComputeNormals(std::span<Math::Vec3 const> positions, std::span<IndexType> indices, F32 creaseAngle, NormalWeighting weighting, Jobs::Scheduler* pScheduler) -> NormalSplit {
+			return Detail::ComputeCreaseNormals(Detail::Strided<Math::Vec3 const>{ reinterpret_cast<U8 const*>(positions.data()), sizeof(Math::Vec3) }, positions.size(), indices, creaseAngle, weighting, pScheduler);
+		}
+
+		template<typename IndexType>
+		ILINE auto ComputeNormals(Mesh<Vertex, IndexType>& mesh, F32 creaseAngle, NormalWeighting weighting, Jobs::Scheduler* pScheduler) -> void {
+			auto const positions = Detail::Strided<Math::Vec3 const>{ reinterpret_cast<U8 const*>(mesh.Vertices.data()) + offsetof(Vertex, Position), sizeof(Vertex) };
+			if (creaseAngle >= Math::PI<F32>) {
+				auto const normals = Detail::Strided<Math::Vec3>{ reinterpret_cast<U8*>(mesh.Vertices.data()) + offsetof(Vertex, Normal), sizeof(Vertex) };
+				Detail::ComputeSmoothNormals(positions, mesh.Vertices.size(), std::span<IndexType const>{ mesh.Indices }, normals, weighting, pScheduler);
+				return;
+			}
+
+			auto const split = Detail::ComputeCreaseNormals(positions, mesh.Vertices.size(), std::span<IndexType>{ mesh.Indices }, creaseAngle, weighting, pScheduler);
+			auto vertices = std::vector<Vertex>(split.Remap.size());
+			for (auto index = size_t{ 0 }; index < vertices.size(); index++) {
+				vertices[index] = mesh.Vertices[split.Remap[index]];
+				vertices[index].Normal = split.Normals[index];
+			}
+			mesh.Vertices = std::move(vertices);
+		}
+
+		namespace Detail {
+
+			template<typename F>
+			ILINE auto ParallelRange(Jobs::Scheduler* pScheduler, U32 count, F&& function) -> void {
+				if (pScheduler != nullptr)
+					pScheduler->ParallelFor(count, std::forward<F>(function));
+				else
+					function(0u, count);
+			}
+
+			[[nodiscard]] ILINE auto NormalizeOrZero(Math::Vec3 const& v) noexcept -> Math::Vec3 {
+				auto const lengthSquared = Math::Dot(v, v);
+				return lengthSquared > 0.0f ? v * (1.0f / Math::Sqrt(lengthSquared)) : Math::Vec3{ 0.0f };
+			}
+
+			// Abramowitz & Stegun 4.4.45, absolute error below 7e-5 which is plenty for a weight
+			[[nodiscard]] ILINE auto AcosApproximate(F32 x) noexcept -> F32 {
+				auto const a = Math::Abs(x);
+				auto const r = Math::Sqrt(1.0f - a) * (1.5707288f + a * (-0.2121144f + a * (0.0742610f + a * -0.0187293f)));
+				return x < 0.0f ? Math::PI<F32> - r : r;
+			}
+
+#if defined(HAWK_GEOMETRY_SSE2)
+			ILINE auto AcosApproximate(__m128 x) noexcept -> __m128 {
+				auto const a = _mm_andnot_ps(_mm_set1_ps(-0.0f), x);
+				auto poly = _mm_set1_ps(-0.0187293f);
+				poly = _mm_add_ps(_mm_mul_ps(poly, a), _mm_set1_ps(0.0742610f));
+				poly = _mm_add_ps(_mm_mul_ps(poly, a), _mm_set1_ps(-0.2121144f));
+				poly = _mm_add_ps(_mm_mul_ps(poly, a), _mm_set1_ps(1.5707288f));
+				auto const r = _mm_mul_ps(poly, _mm_sqrt_ps(_mm_sub_ps(_mm_set1_ps(1.0f), a)));
+				auto const isNegative = _mm_cmplt_ps(x, _mm_setzero_ps());
+				return _mm_or_ps(_mm_and_ps(isNegative, _mm_sub_ps(_mm_set1_ps(Math::PI<F32>), r)), _mm_andnot_ps(isNegative, r));
+			}
+
+			// 1 / sqrt(x), or zero where x is zero so degenerate lanes fall out of every later product
+			ILINE auto InverseLengthOrZero(__m128 lengthSquared) noexcept -> __m128 {
+				auto const isValid = _mm_cmpgt_ps(lengthSquared, _mm_setzero_ps());
+				return _mm_and_ps(isValid, _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(lengthSquared)));
+			}
+
+			ILINE auto Dot(__m128 const (&a)[3], __m128 const (&b)[3]) noexcept -> __m128 {
+				return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a[0], b[0]), _mm_mul_ps(a[1], b[1])), _mm_mul_ps(a[2], b[2]));
+			}
+#endif
+
+			// Plain floats rather than vector operators keep this loop, which dominates the whole pass, in registers
+			template<typename F>
+			[[nodiscard]] ILINE auto AccumulateCorners(std::vector<FaceNormal> const& faces, VertexCorners const& adjacency, U32 vertex, F&& filter) noexcept -> Math::Vec3 {
+				auto x = 0.0f;
+				auto y = 0.0f;
+				auto z = 0.0f;
+				for (auto index = adjacency.Offsets[vertex]; index < adjacency.Offsets[vertex + 1]; index++) {
+					auto const corner = adjacency.Corners[index];
+					auto const& face = faces[corner / 3];
+					if (!filter(face.Normal))
+						continue;
+					auto const weight = face.Weights[corner % 3];
+					x += weight * face.Normal.x;
+					y += weight * face.Normal.y;
+					z += weight * face.Normal.z;
+				}
+				auto const lengthSquared = x * x + y * y + z * z;
+				auto const scale = lengthSquared > 0.0f ? 1.0f / Math::Sqrt(lengthSquared) : 0.0f;
+				return Math::Vec3{ x * scale, y * scale, z * scale };
+			}
+
+			template<typename IndexType>
+			[[nodiscard]] ILINE auto ComputeVertexCorners(std::span<IndexType const> indices, size_t countVertices) -> VertexCorners {
+				if (indices.size() % 3 != 0)
+					throw std::length_error("Index count is not a multiple of three");
+				if (indices.size() > (std::numeric_limits<U32>::max)() || countVertices >= (std::numeric_limits<U32>::max)())
+					throw std::length_error("Mesh is too large for 32-bit corner ids");
+
+				// Counting sort: counts land two slots ahead so the fill pass leaves Offsets[v] at the start of v
+				auto result = VertexCorners{};
+				result.Offsets.assign(countVertices + 2, 0);
+				for (auto const index : indices) {
+					if (index >= countVertices)
+						throw std::out_of_range("Index references a vertex past the end of the vertex buffer");
+					result.Offsets[static_cast<size_t>(index) + 2]++;
+				}
+				for (auto vertex = size_t{ 2 }; vertex < result.Offsets.size(); vertex++)
+					result.Offsets[vertex] += result.Offsets[vertex - 1];
+
+				result.Corners.resize(indices.size());
+				for (auto corner = 0u; corner < indices.size(); corner++)
+					result.Corners[result.Offsets[static_cast<size_t>(indices[corner]) + 1]++] = corner;
+				result.Offsets.pop_back();
+				return result;
+			}
+
+			template<typename IndexType>
+			[[nodiscard]] ILINE auto ComputeFaceNormals(Strided<Math::Vec3 const> positions, std::span<IndexType const> indices, NormalWeighting weighting, Jobs::Scheduler* pScheduler) -> std::vector<FaceNormal> {
+				auto const countFaces = static_cast<U32>(indices.size() / 3);
+				auto faces = std::vector<FaceNormal>(countFaces);
+
+				// Four triangles per step, transposed into lanes and back; a partial last group repeats its final triangle
+				ParallelRange(pScheduler, (countFaces + 3) / 4, [&](U32 begin, U32 end) {
+					for (auto group = begin; group < end; group++) {
+						auto const first = 4 * group;
+						alignas(16) F32 p[3][3][4];
+						alignas(16) F32 result[6][4];
+						for (auto lane = 0u; lane < 4; lane++) {
+							auto const face = (std::min)(first + lane, countFaces - 1);
+							for (auto corner = 0u; corner < 3; corner++) {
+								auto const& position = positions[indices[3 * face + corner]];
+								p[corner][0][lane] = position.x;
+								p[corner][1][lane] = position.y;
+								p[corner][2][lane] = position.z;
+							}
+						}
+
+#if defined(HAWK_GEOMETRY_SSE2)
+						__m128 v[3][3];
+						for (auto corner = 0u; corner < 3; corner++)
+							for (auto axis = 0u; axis < 3; axis++)
+								v[corner][axis] = _mm_load_ps(p[corner][axis]);
+
+						__m128 const e01[3] = { _mm_sub_ps(v[1][0], v[0][0]), _mm_sub_ps(v[1][1], v[0][1]), _mm_sub_ps(v[1][2], v[0][2]) };
+						__m128 const e02[3] = { _mm_sub_ps(v[2][0], v[0][0]), _mm_sub_ps(v[2][1], v[0][1]), _mm_sub_ps(v[2][2], v[0][2]) };
+						__m128 const cross[3] = {
+							_mm_sub_ps(_mm_mul_ps(e01[1], e02[2]), _mm_mul_ps(e01[2], e02[1])),
+							_mm_sub_ps(_mm_mul_ps(e01[2], e02[0]), _mm_mul_ps(e01[0], e02[2])),
+							_mm_sub_ps(_mm_mul_ps(e01[0], e02[1]), _mm_mul_ps(e01[1], e02[0]))
+						};
+						auto const lengthSquared = Dot(cross, cross);
+						auto const inverseLength = InverseLengthOrZero(lengthSquared);
+						for (auto axis = 0u; axis < 3; axis++)
+							_mm_store_ps(result[axis], _mm_mul_ps(cross[axis], inverseLength));
+
+						__m128 weights[3];
+						if (weighting == NormalWeighting::Angle) {
+							__m128 const e12[3] = { _mm_sub_ps(v[2][0], v[1][0]), _mm_sub_ps(v[2][1], v[1][1]), _mm_sub_ps(v[2][2], v[1][2]) };
+							auto const inverse01 = InverseLengthOrZero(Dot(e01, e01));
+							auto const inverse02 = InverseLengthOrZero(Dot(e02, e02));
+							auto const inverse12 = InverseLengthOrZero(Dot(e12, e12));
+							auto const clamp = [](__m128 x) { return _mm_max_ps(_mm_set1_ps(-1.0f), _mm_min_ps(_mm_set1_ps(1.0f), x)); };
+							weights[0] = AcosApproximate(clamp(_mm_mul_ps(Dot(e01, e02), _mm_mul_ps(inverse01, inverse02))));
+							weights[1] = AcosApproximate(clamp(_mm_mul_ps(_mm_sub_ps(_mm_setzero_ps(), Dot(e01, e12)), _mm_mul_ps(inverse01, inverse12))));
+							weights[2] = AcosApproximate(clamp(_mm_mul_ps(Dot(e02, e12), _mm_mul_ps(inverse02, inverse12))));
+						} else {
+							auto const weight = weighting == NormalWeighting::Area ? _mm_mul_ps(_mm_set1_ps(0.5f), _mm_sqrt_ps(lengthSquared)) : _mm_set1_ps(1.0f);
+							weights[0] = weights[1] = weights[2] = weight;
+						}
+						for (auto corner = 0u; corner < 3; corner++)
+							_mm_store_ps(result[3 + corner], weights[corner]);
+#else
+						for (auto lane = 0u; lane < 4; lane++) {
+							auto const a = Math::Vec3{ p[0][0][lane], p[0][1][lane], p[0][2][lane] };
+							auto const b = Math::Vec3{ p[1][0][lane], p[1][1][lane], p[1][2][lane] };
+							auto const c = Math::Vec3{ p[2][0][lane], p[2][1][lane], p[2][2][lane] };
+							auto const cross = Math::Cross(b - a, c - a);
+							auto const normal = NormalizeOrZero(cross);
+							result[0][lane] = normal.x;
+							result[1][lane] = normal.y;
+							result[2][lane] = normal.z;
+
+							F32 weights[3] = { 1.0f, 1.0f, 1.0f };
+							if (weighting == NormalWeighting::Angle) {
+								auto const e01 = NormalizeOrZero(b - a);
+								auto const e02 = NormalizeOrZero(c - a);
+								auto const e12 = NormalizeOrZero(c - b);
+								weights[0] = AcosApproximate(Math::Clamp(Math::Dot(e01, e02), -1.0f, 1.0f));
+								weights[1] = AcosApproximate(Math::Clamp(-Math::Dot(e01, e12), -1.0f, 1.0f));
+								weights[2] = AcosApproximate(Math::Clamp(Math::Dot(e02, e12), -1.0f, 1.0f));
+							} else if (weighting == NormalWeighting::Area) {
+								weights[0] = weights[1] = weights[2] = 0.5f * Math::Length(cross);
+							}
+							for (auto corner = 0u; corner < 3; corner++)
+								result[3 + corner][lane] = weights[corner];
+						}
+#endif
+						for (auto lane = 0u; lane < 4 && first + lane < countFaces; lane++)
+							faces[first + lane] = FaceNormal{ Math::Vec3{ result[0][lane], result[1][lane], result[2][lane] }, { result[3][lane], result[4][lane], result[5][lane] } };
+					}
+				});
+				return faces;
+			}
+
+			template<typename IndexType>
+			ILINE auto ComputeSmoothNormals(Strided<Math::Vec3 const> positions, size_t countVertices, std::span<IndexType const> indices, Strided<Math::Vec3> normals, NormalWeighting weighting, Jobs::Scheduler* pScheduler) -> void {
+				auto const adjacency = ComputeVertexCorners(indices, countVertices);
+				auto const faces = ComputeFaceNormals(positions, indices, weighting, pScheduler);
+
+				ParallelRange(pScheduler, static_cast<U32>(countVertices), [&](U32 begin, U32 end) {
+					for (auto vertex = begin; vertex < end; vertex++) {
+						normals[vertex] = AccumulateCorners(faces, adjacency, vertex, [](Math::Vec3 const&) { return true; });
+					}
+				});
+			}
+
+			template<typename IndexType>
+			[[nodiscard]] ILINE auto ComputeCreaseNormals(Strided<Math::Vec3 const> positions, size_t countVertices, std::span<IndexType> indices, F32 creaseAngle, NormalWeighting weighting, Jobs::Scheduler* pScheduler) -> NormalSplit {
+				auto const adjacency = ComputeVertexCorners(std::span<IndexType const>{ indices }, countVertices);
+				auto const faces = ComputeFaceNormals(positions, std::span<IndexType const>{ indices }, weighting, pScheduler);
+				auto const cosCrease = Math::Cos(Math::Clamp(creaseAngle, 0.0f, Math::PI<F32>));
+
+				// A corner averages every face at its vertex within the crease angle of its own face. Corners whose
+				// sums come out bit-identical share an output vertex; the first pass numbers those groups per vertex
+				// and the second only has to rebuild one normal per group.
+				auto const cornerNormal = [&](U32 vertex, U32 slot) {
+					auto const normal = faces[adjacency.Corners[slot] / 3].Normal;
+					auto const isDegenerate = normal.x == 0.0f && normal.y == 0.0f && normal.z == 0.0f;
+					return AccumulateCorners(faces, adjacency, vertex, [&](Math::Vec3 const& other) {
+						return isDegenerate || normal.x * other.x + normal.y * other.y + normal.z * other.z >= cosCrease;
+					});
+				};
+
+				auto groupOf = std::vector<U32>(adjacency.Corners.size());
+				auto bases = std::vector<U32>(countVertices + 1, 0);
+				ParallelRange(pScheduler, static_cast<U32>(countVertices), [&](U32 begin, U32 end) {
+					auto groups = SmallVector<Math::Vec3, 16>{};
+					for (auto vertex = begin; vertex < end; vertex++) {
+						groups.Clear();
+						for (auto slot = adjacency.Offsets[vertex]; slot < adjacency.Offsets[vertex + 1]; slot++) {
+							auto const normal = cornerNormal(vertex, slot);
+							auto group = 0u;
+							while (group < groups.Size() && !(groups[group].x == normal.x && groups[group].y == normal.y && groups[group].z == normal.z))
+								group++;
+							if (group == groups.Size())
+								groups.PushBack(normal);
+							groupOf[slot] = group;
+						}
+						bases[vertex + 1] = static_cast<U32>(groups.Size());
+					}
+				});
+				for (auto vertex = size_t{ 0 }; vertex < countVertices; vertex++)
+					bases[vertex + 1] += bases[vertex];
+				if (bases.back() > static_cast<size_t>((std::numeric_limits<IndexType>::max)()) + 1)
+					throw std::out_of_range("Crease split produces more vertices than the index type can address");
+
+				auto result = NormalSplit{};
+				result.Normals.resize(bases.back());
+				result.Remap.resize(bases.back());
+				ParallelRange(pScheduler, static_cast<U32>(countVertices), [&](U32 begin, U32 end) {
+					for (auto vertex = begin; vertex < end; vertex++) {
+						auto countGroups = 0u;
+						for (auto slot = adjacency.Offsets[vertex]; slot < adjacency.Offsets[vertex + 1]; slot++) {
+							auto const output = bases[vertex] + groupOf[slot];
+							if (groupOf[slot] == countGroups) {
+								result.Normals[output] = cornerNormal(vertex, slot);
+								result.Remap[output] = vertex;
+								countGroups++;
+							}
+							indices[adjacency.Corners[slot]] = static_cast<IndexType>(output);
+						}
+					}
+				});
+				return result;
+			}
+
+		}
+	}
+}
\ No newline at end of file
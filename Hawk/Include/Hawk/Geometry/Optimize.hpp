@@ -0,0 +1,455 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+#include "../Math/Math.hpp"
+#include "./Generator.hpp"
+#include "./Normals.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Math/Math.hpp>
+//#include <Hawk/Geometry/Generator.hpp>
+//#include <Hawk/Geometry/Normals.hpp>
+
+namespace Hawk {
+	namespace Geometry {
+
+		// Post-transform cache size the passes optimize for and the analysis simulates as a FIFO
+		constexpr U32 VertexCacheSize = 16;
+
+		// ACMR is transformed vertices per triangle (0.5 is ideal on a closed grid, 3 is the worst),
+		// ATVR transformed vertices per referenced vertex (1 is ideal)
+		struct VertexCacheStatistics {
+			U64 CountTransformed;
+			F32 ACMR;
+			F32 ATVR;
+		};
+
+		// Bytes pulled through a direct-mapped 128 KB cache of 64-byte lines; Overfetch is relative to reading
+		// every referenced vertex exactly once
+		struct VertexFetchStatistics {
+			U64 BytesFetched;
+			F32 Overfetch;
+		};
+
+		struct MeshStatistics {
+			size_t                CountVertices;
+			size_t                CountTriangles;
+			VertexCacheStatistics Cache;
+			VertexFetchStatistics Fetch;
+		};
+
+		struct OptimizeReport {
+			MeshStatistics Before;
+			MeshStatistics After;
+		};
+
+		template<typename IndexType>
+		auto AnalyzeVertexCache(std::span<IndexType const> indices, size_t countVertices, U32 cacheSize = VertexCacheSize) -> VertexCacheStatistics;
+
+		template<typename IndexType>
+		auto AnalyzeVertexFetch(std::span<IndexType const> indices, size_t countVertices, size_t vertexSize) -> VertexFetchStatistics;
+
+		template<typename VertexType, typename IndexType>
+		auto AnalyzeMesh(std::span<VertexType> vertices, std::span<IndexType const> indices, U32 cacheSize = VertexCacheSize) -> MeshStatistics;
+
+		// Tipsify (Sander et al. 2007): fans around the most recently cached vertex that still has triangles left
+		// and falls back to a dead-end stack, so the pass is linear in the triangle count whatever the cache size
+		template<typename VertexType, typename IndexType>
+		auto OptimizeVertexCache(std::span<VertexType> vertices, std::span<IndexType> indices, U32 cacheSize = VertexCacheSize) -> OptimizeReport;
+
+		// Splits a cache-optimized index buffer into clusters and draws outward-facing clusters first. Clusters
+		// break where the cache runs cold and wherever their running ACMR comes within threshold of the cluster
+		// average, so threshold bounds how much ACMR may be traded for less overdraw (1.05 allows 5%).
+		template<typename VertexType, typename IndexType>
+		auto OptimizeOverdraw(std::span<VertexType> vertices, std::span<IndexType> indices, F32 threshold = 1.05f, U32 cacheSize = VertexCacheSize) -> OptimizeReport;
+
+		// Renumbers vertices in order of first use and moves unreferenced ones past After.CountVertices
+		template<typename VertexType, typename IndexType>
+		auto OptimizeVertexFetch(std::span<VertexType> vertices, std::span<IndexType> indices) -> OptimizeReport;
+
+		template<typename VertexType, typename IndexType>
+		auto OptimizeVertexCache(Mesh<VertexType, IndexType>& mesh, U32 cacheSize = VertexCacheSize) -> OptimizeReport;
+
+		template<typename VertexType, typename IndexType>
+		auto OptimizeOverdraw(Mesh<VertexType, IndexType>& mesh, F32 threshold = 1.05f, U32 cacheSize = VertexCacheSize) -> OptimizeReport;
+
+		template<typename VertexType, typename IndexType>
+		auto OptimizeVertexFetch(Mesh<VertexType, IndexType>& mesh) -> OptimizeReport;
+
+		namespace Detail {
+
+			constexpr size_t FetchCacheLine = 64;
+			constexpr size_t FetchCacheLines = 2048;
+
+			// FIFO cache emulated with insertion stamps: a vertex is cached while fewer than Size misses have
+			// happened since it was inserted. Flush ages every stamp out at once.
+			class CacheTimestamps {
+			public:
+				CacheTimestamps(size_t countVertices, U32 size) : m_Stamps(countVertices, 0), m_Time(size + 1), m_Size(size) {}
+
+				auto IsCached(U32 vertex) const noexcept -> bool { return m_Time - m_Stamps[vertex] <= m_Size; }
+				auto Touch(U32 vertex) noexcept -> U32;
+				auto Flush() noexcept -> void { m_Time += m_Size + 1; }
+				auto Stamp(U32 vertex) const noexcept -> U64 { return m_Stamps[vertex]; }
+				auto Time() const noexcept -> U64 { return m_Time; }
+
+			private:
+				std::vector<U64> m_Stamps;
+				U64              m_Time;
+				U64              m_Size;
+			};
+
+			struct OverdrawCluster {
+				U32 Begin;
+				U32 End;
+				F32 Key;
+			};
+
+			template<typename IndexType>
+			auto ValidateIndices(std::span<IndexType const> indices, size_t countVertices) -> void;
+
+			template<typename IndexType>
+			auto TipsifyIndices(std::span<IndexType> indices, size_t countVertices, U32 cacheSize) -> void;
+			template<typename IndexType>
+			auto FindOverdrawClusters(std::span<IndexType const> indices, size_t countVertices, F32 threshold, U32 cacheSize) -> std::vector<OverdrawCluster>;
+			template<typename VertexType, typename IndexType>
+			auto SortOverdrawClusters(std::span<VertexType> vertices, std::span<IndexType> indices, std::vector<OverdrawCluster>& clusters) -> void;
+
+		}
+	}
+}
+
+namespace Hawk {
+	namespace Geometry {
+
+		template<typename IndexType>
+		[[nodiscard]] ILINE auto AnalyzeVertexCache(std::span<IndexType const> indices, size_t countVertices, U32 cacheSize) -> VertexCacheStatistics {
+			auto cache = Detail::CacheTimestamps{ countVertices, cacheSize };
+			auto result = VertexCacheStatistics{};
+			for (auto const index : indices)
+				result.CountTransformed += cache.Touch(index);
+
+			auto countReferenced = size_t{ 0 };
+			for (auto vertex = U32{ 0 }; vertex < countVertices; vertex++)
+				countReferenced += cache.Stamp(vertex) != 0;
+
+			result.ACMR = indices.size() >= 3 ? static_cast<F32>(result.CountTransformed) / static_cast<F32>(indices.size() / 3) : 0.0f;
+			result.ATVR = countReferenced > 0 ? static_cast<F32>(result.CountTransformed) / static_cast<F32>(countReferenced) : 0.0f;
+			return result;
+		}
+
+		template<typename IndexType>
+		[[nodiscard]] ILINE auto AnalyzeVertexFetch(std::span<IndexType const> indices, size_t countVertices, size_t vertexSize) -> VertexFetchStatistics {
+			auto tags = std::vector<size_t>(Detail::FetchCacheLines, (std::numeric_limits<size_t>::max)());
+			auto referenced = std::vector<U8>(countVertices, 0);
+			auto result = VertexFetchStatistics{};
+			auto countReferenced = size_t{ 0 };
+			for (auto const index : indices) {
+				countReferenced += referenced[index] == 0;
+				referenced[index] = 1;
+
+				auto const first = index * vertexSize / Detail::FetchCacheLine;
+				auto const last = (index * vertexSize + vertexSize - 1) / Detail::FetchCacheLine;
+				for (auto line = first; line <= last; line++) {
+					auto& tag = tags[line % Detail::FetchCacheLines];
+					if (tag != line) {
+						tag = line;
+						result.BytesFetched += Detail::FetchCacheLine;
+					}
+				}
+			}
+			result.Overfetch = countReferenced > 0 ? static_cast<F32>(result.BytesFetched) / static_cast<F32>(countReferenced * vertexSize) : 0.0f;
+			return result;
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto AnalyzeMesh(std::span<VertexType> vertices, std::span<IndexType const> indices, U32 cacheSize) -> MeshStatistics {
+			return MeshStatistics{
+				vertices.size(),
+				indices.size() / 3,
+				AnalyzeVertexCache(indices, vertices.size(), cacheSize),
+				AnalyzeVertexFetch(indices, vertices.size(), sizeof(VertexType))
+			};
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto OptimizeVertexCache(std::span<VertexType> vertices, std::span<IndexType> indices, U32 cacheSize) -> OptimizeReport {
+			Detail::ValidateIndices(std::span<IndexType const>{ indices }, vertices.size());
+			auto report = OptimizeReport{};
+			report.Before = AnalyzeMesh(vertices, std::span<IndexType const>{ indices }, cacheSize);
+			Detail::TipsifyIndices(indices, vertices.size(), cacheSize);
+			report.After = AnalyzeMesh(vertices, std::span<IndexType const>{ indices }, cacheSize);
+			return report;
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto OptimizeOverdraw(std::span<VertexType> vertices, std::span<IndexType> indices, F32 threshold, U32 cacheSize) -> OptimizeReport {
+			Detail::ValidateIndices(std::span<IndexType const>{ indices }, vertices.size());
+			auto report = OptimizeReport{};
+			report.Before = AnalyzeMesh(vertices, std::span<IndexType const>{ indices }, cacheSize);
+			auto clusters = Detail::FindOverdrawClusters(std::span<IndexType const>{ indices }, vertices.size(), threshold, cacheSize);
+			Detail::SortOverdrawClusters(vertices, indices, clusters);
+			report.After = AnalyzeMesh(vertices, std::span<IndexType const>{ indices }, cacheSize);
+			return report;
+		}
+
+		template<typename VertexType, typename IndexType>
+		[[nodiscard]] ILINE auto OptimizeVertexFetch(std::span<VertexType> vertices, std::span<IndexType> indices) -> OptimizeReport {
+			Detail::ValidateIndices(std::span<IndexType const>{ indices }, vertices.size());
+			auto report = OptimizeReport{};
+			report.Before = AnalyzeMesh(vertices, std::span<IndexType const>{ indices });
+
+			constexpr auto Unused = (std::numeric_limits<U32>::max)();
+			auto remap = std::vector<U32>(vertices.size(), Unused);
+			auto count = U32{ 0 };
+			for (auto& index : indices) {
+				if (remap[index] == Unused)
+					remap[index] = count++;
+				index = static_cast<IndexType>(remap[index]);
+			}
+
+			// Unreferenced vertices keep their relative order behind the referenced ones
+			auto tail = count;
+			for (auto& target : remap)
+				if (target == Unused)
+					target = tail++;
+
+			auto const source = std::vector<std::remove_const_t<VertexType>>(vertices.begin(), vertices.end());
+			for (auto vertex = size_t{ 0 }; vertex < source.size(); vertex++)
+				vertices[remap[vertex]] = source[vertex];
+
+			report.After = AnalyzeMesh(vertices.first(count), std::span<IndexType const>{ indices });
+			return report;
+		}
+
+		template<typename VertexType, typename IndexType>
+		ILINE auto OptimizeVertexCache(Mesh<VertexType, IndexType>& mesh, U32 cacheSize) -> OptimizeReport {
+			return OptimizeVertexCache(std::span<VertexType const>{ mesh.Vertices }, std::span<IndexType>{ mesh.Indices }, cacheSize);
+		}
+
+		template<typename VertexType, typename IndexType>
+		ILINE auto OptimizeOverdraw(Mesh<VertexType, IndexType>& mesh, F32 threshold, U32 cacheSize) -> OptimizeReport {
+			return OptimizeOverdraw(std::span<VertexType const>{ mesh.Vertices }, std::span<IndexType>{ mesh.Indices }, threshold, cacheSize);
+		}
+
+		template<typename VertexType, typename IndexType>
+		ILINE auto OptimizeVertexFetch(Mesh<VertexType, IndexType>& mesh) -> OptimizeReport {
+			auto const report = OptimizeVertexFetch(std::span<VertexType>{ mesh.Vertices }, std::span<IndexType>{ mesh.Indices });
+			mesh.Vertices.resize(report.After.CountVertices);
+			return report;
+		}
+
+		namespace Detail {
+
+			// Returns 1 on a miss, which is the number of vertices the miss transforms
+			ILINE auto CacheTimestamps::Touch(U32 vertex) noexcept -> U32 {
+				if (this->IsCached(vertex))
+					return 0;
+				m_Stamps[vertex] = m_Time++;
+				return 1;
+			}
+
+			template<typename IndexType>
+			ILINE auto ValidateIndices(std::span<IndexType const> indices, size_t countVertices) -> void {
+				if (indices.size() % 3 != 0)
+					throw std::length_error("Index count is not a multiple of three");
+				if (indices.size() > (std::numeric_limits<U32>::max)() || countVertices >= (std::numeric_limits<U32>::max)())
+					throw std::length_error("Mesh is too large for 32-bit vertex ids");
+				for (auto const index : indices)
+					if (index >= countVertices)
+						throw std::out_of_range("Index references a vertex past the end of the vertex buffer");
+			}
+
+			template<typename IndexType>
+			ILINE auto TipsifyIndices(std::span<IndexType> indices, size_t countVertices, U32 cacheSize) -> void {
+				auto const adjacency = ComputeVertexCorners(std::span<IndexType const>{ indices }, countVertices);
+				auto live = std::vector<U32>(countVertices);
+				for (auto vertex = size_t{ 0 }; vertex < countVertices; vertex++)
+					live[vertex] = adjacency.Offsets[vertex + 1] - adjacency.Offsets[vertex];
+
+				auto cache = CacheTimestamps{ countVertices, cacheSize };
+				auto emitted = std::vector<U8>(indices.size() / 3, 0);
+				auto output = std::vector<IndexType>{};
+				auto deadEnd = std::vector<U32>{};
+				auto candidates = std::vector<U32>{};
+				output.reserve(indices.size());
+				deadEnd.reserve(indices.size());
+
+				auto constexpr None = (std::numeric_limits<U32>::max)();
+				auto cursor = U32{ 0 };
+				auto fanning = countVertices > 0 ? U32{ 0 } : None;
+				while (fanning != None) {
+					candidates.clear();
+					for (auto offset = adjacency.Offsets[fanning]; offset < adjacency.Offsets[fanning + 1]; offset++) {
+						auto const triangle = adjacency.Corners[offset] / 3;
+						if (emitted[triangle])
+							continue;
+						emitted[triangle] = 1;
+						for (auto corner = 3 * triangle; corner < 3 * triangle + 3; corner++) {
+							auto const vertex = static_cast<U32>(indices[corner]);
+							output.push_back(indices[corner]);
+							deadEnd.push_back(vertex);
+							candidates.push_back(vertex);
+							live[vertex]--;
+							cache.Touch(vertex);
+						}
+					}
+
+					// Prefer the oldest cached candidate whose remaining fan still fits before it would be evicted
+					auto best = None;
+					auto bestPriority = I64{ -1 };
+					for (auto const vertex : candidates) {
+						if (live[vertex] == 0)
+							continue;
+						auto const age = static_cast<I64>(cache.Time() - cache.Stamp(vertex));
+						auto const priority = age + 2 * static_cast<I64>(live[vertex]) <= static_cast<I64>(cacheSize) ? age : 0;
+						if (priority > bestPriority) {
+							bestPriority = priority;
+							best = vertex;
+						}
+					}
+
+					while (best == None && !deadEnd.empty()) {
+						auto const vertex = deadEnd.back();
+						deadEnd.pop_back();
+						if (live[vertex] > 0)
+							best = vertex;
+					}
+					while (best == None && cursor < countVertices) {
+						if (live[cursor] > 0)
+							best = cursor;
+						cursor++;
+					}
+					fanning = best;
+				}
+				std::copy(output.begin(), output.end(), indices.begin());
+			}
+
+			template<typename IndexType>
+			[[nodiscard]] ILINE auto FindOverdrawClusters(std::span<IndexType const> indices, size_t countVertices, F32 threshold, U32 cacheSize) -> std::vector<OverdrawCluster> {
+				auto const countTriangles = static_cast<U32>(indices.size() / 3);
+				auto cache = CacheTimestamps{ countVertices, cacheSize };
+				auto const touch = [&](U32 triangle) {
+					return cache.Touch(indices[3 * triangle + 0]) + cache.Touch(indices[3 * triangle + 1]) + cache.Touch(indices[3 * triangle + 2]);
+				};
+
+				if (countTriangles == 0)
+					return {};
+
+				// Hard boundaries: the optimizer restarted somewhere the cache had nothing to offer. A degenerate
+				// triangle hits on its repeated corner, so misses are compared against its distinct vertices.
+				auto hard = std::vector<U32>{ 0 };
+				for (auto triangle = U32{ 0 }; triangle < countTriangles; triangle++) {
+					auto const a = indices[3 * triangle + 0];
+					auto const b = indices[3 * triangle + 1];
+					auto const c = indices[3 * triangle + 2];
+					auto const countDistinct = 1u + (b != a) + (c != a && c != b);
+					if (touch(triangle) == countDistinct && triangle > 0)
+						hard.push_back(triangle);
+				}
+				hard.push_back(countTriangles);
+
+				// Soft boundaries: split a hard cluster once its own running ACMR has caught up with its average
+				auto clusters = std::vector<OverdrawCluster>{};
+				for (auto index = size_t{ 0 }; index + 1 < hard.size(); index++) {
+					auto const begin = hard[index];
+					auto const end = hard[index + 1];
+
+					cache.Flush();
+					auto misses = U32{ 0 };
+					for (auto triangle = begin; triangle < end; triangle++)
+						misses += touch(triangle);
+					auto const limit = threshold * static_cast<F32>(misses) / static_cast<F32>(end - begin);
+
+					cache.Flush();
+					auto start = begin;
+					auto running = U32{ 0 };
+					for (auto triangle = begin; triangle < end; triangle++) {
+						running += touch(triangle);
+						if (triangle + 1 < end && static_cast<F32>(running) <= limit * static_cast<F32>(triangle - start + 1)) {
+							clusters.push_back(OverdrawCluster{ start, triangle + 1, 0.0f });
+							cache.Flush();
+							start = triangle + 1;
+							running = 0;
+						}
+					}
+					clusters.push_back(OverdrawCluster{ start, end, 0.0f });
+				}
+				return clusters;
+			}
+
+			// Ranks clusters by how far their area-weighted centroid sits out along their average normal from
+			// the mesh centroid; drawing the outermost first lets depth testing reject what lies behind them
+			template<typename VertexType, typename IndexType>
+			ILINE auto SortOverdrawClusters(std::span<VertexType> vertices, std::span<IndexType> indices, std::vector<OverdrawCluster>& clusters) -> void {
+				struct Moments {
+					F32 Area;
+					F32 Centroid[3];
+					F32 Normal[3];
+				};
+
+				auto moments = std::vector<Moments>(clusters.size(), Moments{});
+				auto mesh = Moments{};
+				for (auto index = size_t{ 0 }; index < clusters.size(); index++) {
+					auto& cluster = moments[index];
+					for (auto triangle = clusters[index].Begin; triangle < clusters[index].End; triangle++) {
+						auto const& p0 = vertices[indices[3 * triangle + 0]].Position;
+						auto const& p1 = vertices[indices[3 * triangle + 1]].Position;
+						auto const& p2 = vertices[indices[3 * triangle + 2]].Position;
+						auto const ax = p1.x - p0.x, ay = p1.y - p0.y, az = p1.z - p0.z;
+						auto const bx = p2.x - p0.x, by = p2.y - p0.y, bz = p2.z - p0.z;
+						auto const nx = ay * bz - az * by, ny = az * bx - ax * bz, nz = ax * by - ay * bx;
+						auto const area = Math::Sqrt(nx * nx + ny * ny + nz * nz);
+
+						cluster.Area += area;
+						cluster.Centroid[0] += area * (p0.x + p1.x + p2.x);
+						cluster.Centroid[1] += area * (p0.y + p1.y + p2.y);
+						cluster.Centroid[2] += area * (p0.z + p1.z + p2.z);
+						cluster.Normal[0] += nx;
+						cluster.Normal[1] += ny;
+						cluster.Normal[2] += nz;
+					}
+					mesh.Area += cluster.Area;
+					for (auto axis = 0u; axis < 3; axis++)
+						mesh.Centroid[axis] += cluster.Centroid[axis];
+				}
+
+				auto const meshScale = mesh.Area > 0.0f ? 1.0f / (3.0f * mesh.Area) : 0.0f;
+				for (auto index = size_t{ 0 }; index < clusters.size(); index++) {
+					auto const& cluster = moments[index];
+					auto const scale = cluster.Area > 0.0f ? 1.0f / (3.0f * cluster.Area) : 0.0f;
+					auto const lengthSquared = cluster.Normal[0] * cluster.Normal[0] + cluster.Normal[1] * cluster.Normal[1] + cluster.Normal[2] * cluster.Normal[2];
+					auto const normalScale = lengthSquared > 0.0f ? 1.0f / Math::Sqrt(lengthSquared) : 0.0f;
+					auto key = 0.0f;
+					for (auto axis = 0u; axis < 3; axis++)
+						key += (cluster.Centroid[axis] * scale - mesh.Centroid[axis] * meshScale) * cluster.Normal[axis] * normalScale;
+					clusters[index].Key = key;
+				}
+
+				// Reordering whole clusters keeps the triangle multiset only while they tile the index buffer
+				assert(!clusters.empty() || indices.empty());
+				for (auto index = size_t{ 0 }; index < clusters.size(); index++)
+					assert(clusters[index].Begin == (index > 0 ? clusters[index - 1].End : 0) && clusters[index].Begin < clusters[index].End);
+				assert(clusters.empty() || 3 * static_cast<size_t>(clusters.back().End) == indices.size());
+
+				std::stable_sort(clusters.begin(), clusters.end(), [](auto const& lhs, auto const& rhs) { return lhs.Key > rhs.Key; });
+
+				auto const source = std::vector<IndexType>(indices.begin(), indices.end());
+				auto position = size_t{ 0 };
+				for (auto const& cluster : clusters) {
+					auto const count = 3 * static_cast<size_t>(cluster.End - cluster.Begin);
+					std::memcpy(indices.data() + position, source.data() + 3 * static_cast<size_t>(cluster.Begin), count * sizeof(IndexType));
+					position += count;
+				}
+			}
+
+		}
+	}
+}
\ No newline at end of file
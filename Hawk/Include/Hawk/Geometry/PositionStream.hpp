@@ -0,0 +1,99 @@
+#pragma once
+
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+#include "../Containers/FlatHashMap.hpp"
+#include "./Quantize.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Containers/FlatHashMap.hpp>
+//#include <Hawk/Geometry/Quantize.hpp>
+
+namespace Hawk {
+	namespace Geometry {
+
+		// Position of a QuantizedVertex with w cleared; R16G16B16A16_UNORM, 8 bytes against 20
+		struct QuantizedPosition {
+			U16 Position[4];
+		};
+
+		static_assert(sizeof(QuantizedPosition) == 8, "QuantizedPosition must match its input layout");
+
+		// Remap[i] is the position vertex i collapsed into. Positions keep the order of their first vertex, so
+		// remapped indices keep the fetch locality of the source.
+		struct PositionStream {
+			std::vector<QuantizedPosition> Positions;
+			std::vector<U32>               Remap;
+		};
+
+		// Collapses vertices that only differ in attributes, so normal and UV seams share one position. Bits are
+		// compared exactly, which keeps depth rendered from this stream equal to depth from the full vertices.
+		auto BuildPositionStream(std::span<QuantizedVertex const> vertices) -> PositionStream;
+
+		template<typename IndexType>
+		auto RemapPositionIndices(std::span<IndexType const> indices, PositionStream const& stream, std::span<IndexType> result) -> void;
+
+		// Counts the corners whose position differs between the two streams, zero for a valid depth stream
+		template<typename IndexType>
+		auto ValidatePositionStream(std::span<QuantizedVertex const> vertices, std::span<IndexType const> indices, std::span<QuantizedPosition const> positions, std::span<IndexType const> positionIndices) -> size_t;
+	}
+}
+
+namespace Hawk {
+	namespace Geometry {
+
+		[[nodiscard]] ILINE auto BuildPositionStream(std::span<QuantizedVertex const> vertices) -> PositionStream {
+			if (vertices.size() > (std::numeric_limits<U32>::max)())
+				throw std::length_error("Too many vertices for 32-bit ids");
+
+			auto result = PositionStream{};
+			result.Remap.resize(vertices.size());
+			auto map = FlatHashMap<U64, U32>{};
+			map.Reserve(vertices.size());
+			for (auto index = size_t{ 0 }; index < vertices.size(); index++) {
+				auto const& p = vertices[index].Position;
+				auto const key = U64{ p[0] } | (U64{ p[1] } << 16) | (U64{ p[2] } << 32);
+				auto const [position, isInserted] = map.TryEmplace(key, static_cast<U32>(result.Positions.size()));
+				if (isInserted)
+					result.Positions.push_back(QuantizedPosition{ { p[0], p[1], p[2], 0 } });
+				result.Remap[index] = *position;
+			}
+			return result;
+		}
+
+		template<typename IndexType>
+		ILINE auto RemapPositionIndices(std::span<IndexType const> indices, PositionStream const& stream, std::span<IndexType> result) -> void {
+			if (result.size() < indices.size())
+				throw std::length_error("Remapped span is shorter than the index span");
+			for (auto index = size_t{ 0 }; index < indices.size(); index++) {
+				if (static_cast<U64>(indices[index]) >= stream.Remap.size())
+					throw std::out_of_range("Index references a vertex past the end of the vertex buffer");
+				result[index] = static_cast<IndexType>(stream.Remap[indices[index]]);
+			}
+		}
+
+		template<typename IndexType>
+		[[nodiscard]] ILINE auto ValidatePositionStream(std::span<QuantizedVertex const> vertices, std::span<IndexType const> indices, std::span<QuantizedPosition const> positions, std::span<IndexType const> positionIndices) -> size_t {
+			if (positionIndices.size() != indices.size())
+				return indices.size();
+
+			auto countMismatches = size_t{ 0 };
+			for (auto index = size_t{ 0 }; index < indices.size(); index++) {
+				auto const vertex = static_cast<U64>(indices[index]);
+				auto const position = static_cast<U64>(positionIndices[index]);
+				if (vertex >= vertices.size() || position >= positions.size()) {
+					countMismatches++;
+					continue;
+				}
+				auto const& p = vertices[vertex].Position;
+				auto const& q = positions[position].Position;
+				countMismatches += p[0] != q[0] || p[1] != q[1] || p[2] != q[2];
+			}
+			return countMismatches;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define HAWK_GEOMETRY_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#include "../Common/Defines.hpp"
+#include "../Common/Jobs.hpp"
+#include "../Math/Math.hpp"
+#include "./Generator.hpp"
+#include "./Normals.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/Jobs.hpp>
+//#include <Hawk/Math/Math.hpp>
+//#include <Hawk/Geometry/Generator.hpp>
+//#include <Hawk/Geometry/Normals.hpp>
+
+namespace Hawk {
+	namespace Geometry {
+
+		// 20 bytes against the 48 of Vertex. Every field maps onto a DXGI format, so the input assembler does
+		// the unpacking and a shader only finishes the decode:
+		//   Position  R16G16B16A16_UNORM  xyz * Scale + Offset; w is the tangent handedness, 0 for -1 and 1 for +1
+		//   Normal    R16G16_SNORM        octahedral, see DecodeOctahedral
+		//   Tangent   R16G16_SNORM        octahedral, handedness in Position.w
+		//   Texcoord  R16G16_FLOAT
+		struct QuantizedVertex {
+			U16 Position[4];
+			I16 Normal[2];
+			I16 Tangent[2];
+			U16 Texcoord[2];
+		};
+
+		static_assert(sizeof(QuantizedVertex) == 20, "QuantizedVertex must match its input layout");
+
+		// Position = Offset + unorm * Scale per axis; a flat axis has a zero scale and decodes to Offset
+		struct QuantizationBounds {
+			Math::Vec3 Offset;
+			Math::Vec3 Scale;
+		};
+
+		// Worst cases over the mesh: position in mesh units, normal and tangent direction in degrees, texcoord
+		// in texture units. Handedness can only flip for tangents whose w wasn't +-1 to begin with.
+		struct QuantizationStatistics {
+			F32    MaxPositionError;
+			F32    MaxNormalError;
+			F32    MaxTangentError;
+			F32    MaxTexcoordError;
+			size_t CountHandednessFlips;
+			size_t BytesBefore;
+			size_t BytesAfter;
+		};
+
+		auto ComputeQuantizationBounds(std::span<Vertex const> vertices) noexcept -> QuantizationBounds;
+
+		// Four vertices per step with SSE2 where available; the result is bit-identical to EncodeVertex
+		auto EncodeVertices(std::span<Vertex const> vertices, std::span<QuantizedVertex> encoded, QuantizationBounds const& bounds, Jobs::Scheduler* pScheduler = nullptr) -> void;
+
+		auto EncodeVertex(Vertex const& vertex, QuantizationBounds const& bounds) noexcept -> QuantizedVertex;
+		auto DecodeVertex(QuantizedVertex const& vertex, QuantizationBounds const& bounds) noexcept -> Vertex;
+
+		auto MeasureQuantization(std::span<Vertex const> vertices, std::span<QuantizedVertex const> encoded, QuantizationBounds const& bounds) -> QuantizationStatistics;
+
+		namespace Detail {
+
+			struct QuantizeScale {
+				F32 Offset[3];
+				F32 Inverse[3];
+			};
+
+			auto MakeQuantizeScale(QuantizationBounds const& bounds) noexcept -> QuantizeScale;
+			auto QuantizeUnorm16(F32 value, F32 offset, F32 inverse) noexcept -> U16;
+			auto QuantizeSnorm16(F32 value) noexcept -> I16;
+			auto EncodeOctahedral(F32 x, F32 y, F32 z, I16 (&result)[2]) noexcept -> void;
+			auto DecodeOctahedral(I16 const (&value)[2]) noexcept -> Math::Vec3;
+			auto FloatToHalf(F32 value) noexcept -> U16;
+			auto HalfToFloat(U16 value) noexcept -> F32;
+
+		}
+	}
+}
+
+namespace Hawk {
+	namespace Geometry {
+
+		[[nodiscard]] ILINE auto ComputeQuantizationBounds(std::span<Vertex const> vertices) noexcept -> QuantizationBounds {
+			if (vertices.empty())
+				return QuantizationBounds{ Math::Vec3{ 0.0f, 0.0f, 0.0f }, Math::Vec3{ 0.0f, 0.0f, 0.0f } };
+
+			F32 minimum[3] = { vertices[0].Position.x, vertices[0].Position.y, vertices[0].Position.z };
+			F32 maximum[3] = { minimum[0], minimum[1], minimum[2] };
+			for (auto const& vertex : vertices) {
+				F32 const p[3] = { vertex.Position.x, vertex.Position.y, vertex.Position.z };
+				for (auto axis = 0u; axis < 3; axis++) {
+					minimum[axis] = (std::min)(minimum[axis], p[axis]);
+					maximum[axis] = (std::max)(maximum[axis], p[axis]);
+				}
+			}
+			return QuantizationBounds{
+				Math::Vec3{ minimum[0], minimum[1], minimum[2] },
+				Math::Vec3{ maximum[0] - minimum[0], maximum[1] - minimum[1], maximum[2] - minimum[2] }
+			};
+		}
+
+		ILINE auto EncodeVertices(std::span<Vertex const> vertices, std::span<QuantizedVertex> encoded, QuantizationBounds const& bounds, Jobs::Scheduler* pScheduler) -> void {
+			if (encoded.size() < vertices.size())
+				throw std::length_error("Encoded span is shorter than the vertex span");
+			if (vertices.size() > (std::numeric_limits<U32>::max)())
+				throw std::length_error("Too many vertices for 32-bit ids");
+
+			auto const countVertices = static_cast<U32>(vertices.size());
+#if defined(HAWK_GEOMETRY_SSE2)
+			auto const scale = Detail::MakeQuantizeScale(bounds);
+			Detail::ParallelRange(pScheduler, (countVertices + 3) / 4, [&](U32 begin, U32 end) {
+				for (auto group = begin; group < end; group++) {
+					auto const first = 4 * group;
+
+					// Transposed into lanes; a partial last group repeats its final vertex
+					alignas(16) F32 v[12][4];
+					for (auto lane = 0u; lane < 4; lane++) {
+						auto const& vertex = vertices[(std::min)(first + lane, countVertices - 1)];
+						F32 const values[12] = {
+							vertex.Position.x, vertex.Position.y, vertex.Position.z,
+							vertex.Normal.x, vertex.Normal.y, vertex.Normal.z,
+							vertex.Tangent.x, vertex.Tangent.y, vertex.Tangent.z, vertex.Tangent.w,
+							vertex.Texcoord.x, vertex.Texcoord.y
+						};
+						for (auto index = 0u; index < 12; index++)
+							v[index][lane] = values[index];
+					}
+
+					alignas(16) I32 result[10][4];
+					for (auto axis = 0u; axis < 3; axis++) {
+						auto const unit = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(v[axis]), _mm_set1_ps(scale.Offset[axis])), _mm_set1_ps(scale.Inverse[axis]));
+						auto const clamped = _mm_min_ps(_mm_max_ps(_mm_mul_ps(unit, _mm_set1_ps(65535.0f)), _mm_setzero_ps()), _mm_set1_ps(65535.0f));
+						_mm_store_si128(reinterpret_cast<__m128i*>(result[axis]), _mm_cvtps_epi32(clamped));
+					}
+					auto const handedness = _mm_cmpge_ps(_mm_load_ps(v[9]), _mm_setzero_ps());
+					_mm_store_si128(reinterpret_cast<__m128i*>(result[3]), _mm_and_si128(_mm_castps_si128(handedness), _mm_set1_epi32(65535)));
+
+					auto const sign = _mm_set1_ps(-0.0f);
+					auto const octahedral = [&](F32 const (&x)[4], F32 const (&y)[4], F32 const (&z)[4], I32 (&u)[4], I32 (&w)[4]) {
+						auto const vx = _mm_load_ps(x), vy = _mm_load_ps(y), vz = _mm_load_ps(z);
+						auto const sum = _mm_add_ps(_mm_add_ps(_mm_andnot_ps(sign, vx), _mm_andnot_ps(sign, vy)), _mm_andnot_ps(sign, vz));
+						auto const inverse = _mm_and_ps(_mm_cmpgt_ps(sum, _mm_setzero_ps()), _mm_div_ps(_mm_set1_ps(1.0f), sum));
+						auto const ox = _mm_mul_ps(vx, inverse), oy = _mm_mul_ps(vy, inverse);
+
+						// The lower hemisphere folds over the diagonals; a zero component counts as positive
+						auto const signX = _mm_or_ps(_mm_and_ps(sign, _mm_and_ps(ox, _mm_cmplt_ps(ox, _mm_setzero_ps()))), _mm_set1_ps(1.0f));
+						auto const signY = _mm_or_ps(_mm_and_ps(sign, _mm_and_ps(oy, _mm_cmplt_ps(oy, _mm_setzero_ps()))), _mm_set1_ps(1.0f));
+						auto const fx = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_andnot_ps(sign, oy)), signX);
+						auto const fy = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_andnot_ps(sign, ox)), signY);
+						auto const isLower = _mm_cmplt_ps(vz, _mm_setzero_ps());
+						auto const ex = _mm_or_ps(_mm_and_ps(isLower, fx), _mm_andnot_ps(isLower, ox));
+						auto const ey = _mm_or_ps(_mm_and_ps(isLower, fy), _mm_andnot_ps(isLower, oy));
+
+						auto const snorm = [](__m128 value) { return _mm_cvtps_epi32(_mm_mul_ps(_mm_min_ps(_mm_max_ps(value, _mm_set1_ps(-1.0f)), _mm_set1_ps(1.0f)), _mm_set1_ps(32767.0f))); };
+						_mm_store_si128(reinterpret_cast<__m128i*>(u), snorm(ex));
+						_mm_store_si128(reinterpret_cast<__m128i*>(w), snorm(ey));
+					};
+					octahedral(v[3], v[4], v[5], result[4], result[5]);
+					octahedral(v[6], v[7], v[8], result[6], result[7]);
+
+					// Round-to-nearest-even float to half (F. Giesen), with overflow to infinity and NaN kept quiet
+					for (auto axis = 0u; axis < 2; axis++) {
+						auto const value = _mm_load_ps(v[10 + axis]);
+						auto const justSign = _mm_and_ps(sign, value);
+						auto const absolute = _mm_castps_si128(_mm_xor_ps(value, justSign));
+						auto const isNaN = _mm_castps_si128(_mm_cmpunord_ps(_mm_castsi128_ps(absolute), _mm_castsi128_ps(absolute)));
+						auto const isRegular = _mm_cmpgt_epi32(_mm_set1_epi32((127 + 16) << 23), absolute);
+						auto const special = _mm_or_si128(_mm_and_si128(isNaN, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7c00));
+						auto const isSubnormal = _mm_cmpgt_epi32(_mm_set1_epi32((127 - 14) << 23), absolute);
+
+						auto const magic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+						auto const subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(absolute), _mm_castsi128_ps(magic))), magic);
+						auto const isOdd = _mm_srai_epi32(_mm_slli_epi32(absolute, 31 - 13), 31);
+						auto const normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absolute, _mm_set1_epi32(0xfff - ((127 - 15) << 23))), isOdd), 13);
+
+						auto const finite = _mm_or_si128(_mm_and_si128(isSubnormal, subnormal), _mm_andnot_si128(isSubnormal, normal));
+						auto const joined = _mm_or_si128(_mm_and_si128(isRegular, finite), _mm_andnot_si128(isRegular, special));
+						auto const half = _mm_and_si128(_mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(justSign), 16)), _mm_set1_epi32(0xffff));
+						_mm_store_si128(reinterpret_cast<__m128i*>(result[8 + axis]), half);
+					}
+
+					for (auto lane = 0u; lane < 4 && first + lane < countVertices; lane++) {
+						auto& target = encoded[first + lane];
+						for (auto axis = 0u; axis < 4; axis++)
+							target.Position[axis] = static_cast<U16>(result[axis][lane]);
+						target.Normal[0] = static_cast<I16>(result[4][lane]);
+						target.Normal[1] = static_cast<I16>(result[5][lane]);
+						target.Tangent[0] = static_cast<I16>(result[6][lane]);
+						target.Tangent[1] = static_cast<I16>(result[7][lane]);
+						target.Texcoord[0] = static_cast<U16>(result[8][lane]);
+						target.Texcoord[1] = static_cast<U16>(result[9][lane]);
+					}
+				}
+			});
+#else
+			Detail::ParallelRange(pScheduler, countVertices, [&](U32 begin, U32 end) {
+				for (auto index = begin; index < end; index++)
+					encoded[index] = EncodeVertex(vertices[index], bounds);
+			});
+#endif
+		}
+
+		[[nodiscard]] ILINE auto EncodeVertex(Vertex const& vertex, QuantizationBounds const& bounds) noexcept -> QuantizedVertex {
+			auto const scale = Detail::MakeQuantizeScale(bounds);
+			auto result = QuantizedVertex{};
+			result.Position[0] = Detail::QuantizeUnorm16(vertex.Position.x, scale.Offset[0], scale.Inverse[0]);
+			result.Position[1] = Detail::QuantizeUnorm16(vertex.Position.y, scale.Offset[1], scale.Inverse[1]);
+			result.Position[2] = Detail::QuantizeUnorm16(vertex.Position.z, scale.Offset[2], scale.Inverse[2]);
+			result.Position[3] = vertex.Tangent.w >= 0.0f ? U16{ 65535 } : U16{ 0 };
+			Detail::EncodeOctahedral(vertex.Normal.x, vertex.Normal.y, vertex.Normal.z, result.Normal);
+			Detail::EncodeOctahedral(vertex.Tangent.x, vertex.Tangent.y, vertex.Tangent.z, result.Tangent);
+			result.Texcoord[0] = Detail::FloatToHalf(vertex.Texcoord.x);
+			result.Texcoord[1] = Detail::FloatToHalf(vertex.Texcoord.y);
+			return result;
+		}
+
+		[[nodiscard]] ILINE auto DecodeVertex(QuantizedVertex const& vertex, QuantizationBounds const& bounds) noexcept -> Vertex {
+			auto const unorm = [](U16 value) { return static_cast<F32>(value) / 65535.0f; };
+			auto const tangent = Detail::DecodeOctahedral(vertex.Tangent);
+			return Vertex{
+				Math::Vec3{
+					bounds.Offset.x + unorm(vertex.Position[0]) * bounds.Scale.x,
+					bounds.Offset.y + unorm(vertex.Position[1]) * bounds.Scale.y,
+					bounds.Offset.z + unorm(vertex.Position[2]) * bounds.Scale.z },
+				Detail::DecodeOctahedral(vertex.Normal),
+				Math::Vec4{ tangent, unorm(vertex.Position[3]) * 2.0f - 1.0f },
+				Math::Vec2{ Detail::HalfToFloat(vertex.Texcoord[0]), Detail::HalfToFloat(vertex.Texcoord[1]) }
+			};
+		}
+
+		[[nodiscard]] ILINE auto MeasureQuantization(std::span<Vertex const> vertices, std::span<QuantizedVertex const> encoded, QuantizationBounds const& bounds) -> QuantizationStatistics {
+			if (encoded.size() < vertices.size())
+				throw std::length_error("Encoded span is shorter than the vertex span");
+
+			auto const angle = [](F32 x, F32 y, F32 z, Math::Vec3 const& decoded) {
+				auto const length = Math::Sqrt(x * x + y * y + z * z);
+				if (length <= 0.0f)
+					return 0.0f;
+				auto const cosine = std::clamp((x * decoded.x + y * decoded.y + z * decoded.z) / length, -1.0f, 1.0f);
+				return std::acos(cosine) * (180.0f / Math::PI<F32>);
+			};
+
+			auto result = QuantizationStatistics{};
+			for (auto index = size_t{ 0 }; index < vertices.size(); index++) {
+				auto const& source = vertices[index];
+				auto const decoded = DecodeVertex(encoded[index], bounds);
+				result.MaxPositionError = (std::max)({ result.MaxPositionError,
+					std::abs(decoded.Position.x - source.Position.x), std::abs(decoded.Position.y - source.Position.y), std::abs(decoded.Position.z - source.Position.z) });
+				result.MaxNormalError = (std::max)(result.MaxNormalError, angle(source.Normal.x, source.Normal.y, source.Normal.z, decoded.Normal));
+				result.MaxTangentError = (std::max)(result.MaxTangentError, angle(source.Tangent.x, source.Tangent.y, source.Tangent.z, Math::Vec3{ decoded.Tangent.x, decoded.Tangent.y, decoded.Tangent.z }));
+				result.MaxTexcoordError = (std::max)({ result.MaxTexcoordError, std::abs(decoded.Texcoord.x - source.Texcoord.x), std::abs(decoded.Texcoord.y - source.Texcoord.y) });
+				result.CountHandednessFlips += (decoded.Tangent.w < 0.0f) != (source.Tangent.w < 0.0f);
+			}
+			result.BytesBefore = vertices.size() * sizeof(Vertex);
+			result.BytesAfter = vertices.size() * sizeof(QuantizedVertex);
+			return result;
+		}
+
+		namespace Detail {
+
+			[[nodiscard]] ILINE auto MakeQuantizeScale(QuantizationBounds const& bounds) noexcept -> QuantizeScale {
+				auto const inverse = [](F32 scale) { return scale > 0.0f ? 1.0f / scale : 0.0f; };
+				return QuantizeScale{
+					{ bounds.Offset.x, bounds.Offset.y, bounds.Offset.z },
+					{ inverse(bounds.Scale.x), inverse(bounds.Scale.y), inverse(bounds.Scale.z) }
+				};
+			}
+
+			// Same operations in the same order as the SSE2 lanes, and nearbyint rounds half to even like cvtps
+			[[nodiscard]] ILINE auto QuantizeUnorm16(F32 value, F32 offset, F32 inverse) noexcept -> U16 {
+				auto const scaled = (std::min)((std::max)((value - offset) * inverse * 65535.0f, 0.0f), 65535.0f);
+				return static_cast<U16>(std::nearbyint(scaled));
+			}
+
+			[[nodiscard]] ILINE auto QuantizeSnorm16(F32 value) noexcept -> I16 {
+				return static_cast<I16>(std::nearbyint((std::min)((std::max)(value, -1.0f), 1.0f) * 32767.0f));
+			}
+
+			// Project onto the octahedron |x| + |y| + |z| = 1 and fold the lower half over the diagonals
+			ILINE auto EncodeOctahedral(F32 x, F32 y, F32 z, I16 (&result)[2]) noexcept -> void {
+				auto const sum = std::abs(x) + std::abs(y) + std::abs(z);
+				auto const inverse = sum > 0.0f ? 1.0f / sum : 0.0f;
+				auto ox = x * inverse;
+				auto oy = y * inverse;
+				if (z < 0.0f) {
+					auto const fx = (1.0f - std::abs(oy)) * (ox < 0.0f ? -1.0f : 1.0f);
+					auto const fy = (1.0f - std::abs(ox)) * (oy < 0.0f ? -1.0f : 1.0f);
+					ox = fx;
+					oy = fy;
+				}
+				result[0] = QuantizeSnorm16(ox);
+				result[1] = QuantizeSnorm16(oy);
+			}
+
+			// SNORM decodes -32768 and -32767 both to -1, as the input assembler does
+			[[nodiscard]] ILINE auto DecodeOctahedral(I16 const (&value)[2]) noexcept -> Math::Vec3 {
+				auto const x = (std::max)(static_cast<F32>(value[0]) / 32767.0f, -1.0f);
+				auto const y = (std::max)(static_cast<F32>(value[1]) / 32767.0f, -1.0f);
+				auto const z = 1.0f - std::abs(x) - std::abs(y);
+				auto const t = (std::max)(-z, 0.0f);
+				auto const nx = x + (x >= 0.0f ? -t : t);
+				auto const ny = y + (y >= 0.0f ? -t : t);
+				return NormalizeOrZero(Math::Vec3{ nx, ny, z });
+			}
+
+			[[nodiscard]] ILINE auto FloatToHalf(F32 value) noexcept -> U16 {
+				auto bits = std::bit_cast<U32>(value);
+				auto const sign = bits & 0x80000000u;
+				bits ^= sign;
+
+				auto result = U32{ 0 };
+				if (bits >= ((127u + 16u) << 23))
+					result = bits > 0x7f800000u ? 0x7e00u : 0x7c00u;
+				else if (bits < ((127u - 14u) << 23)) {
+					auto const magic = ((127u - 15u) + (23u - 10u) + 1u) << 23;
+					result = std::bit_cast<U32>(std::bit_cast<F32>(bits) + std::bit_cast<F32>(magic)) - magic;
+				} else {
+					auto const isOdd = (bits >> 13) & 1u;
+					result = (bits + 0xfffu - ((127u - 15u) << 23) + isOdd) >> 13;
+				}
+				return static_cast<U16>(result | (sign >> 16));
+			}
+
+			[[nodiscard]] ILINE auto HalfToFloat(U16 value) noexcept -> F32 {
+				auto const sign = static_cast<U32>(value & 0x8000u) << 16;
+				auto const exponent = (value >> 10) & 0x1fu;
+				auto const mantissa = value & 0x3ffu;
+				if (exponent == 0) {
+					auto const magnitude = static_cast<F32>(mantissa) * (1.0f / 16777216.0f);
+					return std::bit_cast<F32>(std::bit_cast<U32>(magnitude) | sign);
+				}
+				if (exponent == 0x1f)
+					return std::bit_cast<F32>(sign | 0x7f800000u | (static_cast<U32>(mantissa) << 13));
+				return std::bit_cast<F32>(sign | ((exponent + 127u - 15u) << 23) | (static_cast<U32>(mantissa) << 13));
+			}
+
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,579 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+#include "../Common/Jobs.hpp"
+#include "../Containers/FlatHashMap.hpp"
+#include "../Math/Math.hpp"
+#include "./Generator.hpp"
+#include "./Normals.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/Jobs.hpp>
+//#include <Hawk/Containers/FlatHashMap.hpp>
+//#include <Hawk/Math/Math.hpp>
+//#include <Hawk/Geometry/Generator.hpp>
+//#include <Hawk/Geometry/Normals.hpp>
+
+namespace Hawk {
+	namespace Geometry {
+
+		// TargetError is relative to the largest extent of the mesh's bounding box; collapses costing more are
+		// never taken, so the result may keep more than TargetTriangles. Attribute weights scale how much a
+		// normal or texcoord discontinuity costs against geometric distance.
+		struct SimplifyOptions {
+			size_t TargetTriangles = 0;
+			F32    TargetError     = 1.0e-2f;
+			F32    NormalWeight    = 0.5f;
+			F32    TexcoordWeight  = 1.0f;
+			bool   LockBorder      = false;
+		};
+
+		// Error is the deviation of the worst collapse taken, in the units of the vertex positions
+		struct SimplifyResult {
+			size_t CountIndices;
+			F32    Error;
+		};
+
+		// Each level simplifies the previous one down to Ratio of its triangles. The chain ends at MaxLevels,
+		// at MinTriangles, or at a level that removes less than a quarter of the previous one.
+		struct LodOptions {
+			U32             MaxLevels    = 8;
+			F32             Ratio        = 0.5f;
+			size_t          MinTriangles = 64;
+			SimplifyOptions Simplify     = { 0, 5.0e-2f };
+		};
+
+		// Error is the conservative deviation from level 0 in position units: the sum of every level's error.
+		// Project it to the screen and draw the coarsest level under a pixel.
+		struct LodLevel {
+			U32 FirstIndex;
+			U32 CountIndices;
+			F32 Error;
+		};
+
+		template<typename IndexType>
+		struct LodChain {
+			std::vector<IndexType> Indices;
+			std::vector<LodLevel>  Levels;
+		};
+
+		// Quadric error edge collapse onto existing vertices, so the vertex buffer is shared by every result and
+		// only the indices change; they are written to the front of the span. Costs combine area-weighted plane
+		// quadrics with attribute quadrics that measure how far the collapse bends linearly interpolated normals
+		// and texcoords. Vertices sharing a position with different attributes (seams) and non-manifold vertices
+		// never move; border vertices only slide along the border unless LockBorder pins them too.
+		template<typename IndexType>
+		auto Simplify(std::span<Vertex const> vertices, std::span<IndexType> indices, SimplifyOptions const& options = {}, Jobs::Scheduler* pScheduler = nullptr) -> SimplifyResult;
+
+		template<typename IndexType>
+		auto Simplify(Mesh<Vertex, IndexType>& mesh, SimplifyOptions const& options = {}, Jobs::Scheduler* pScheduler = nullptr) -> SimplifyResult;
+
+		// Level 0 is the source indices; every level indexes the same vertices
+		template<typename IndexType>
+		auto GenerateLodChain(std::span<Vertex const> vertices, std::span<IndexType const> indices, LodOptions const& options = {}, Jobs::Scheduler* pScheduler = nullptr) -> LodChain<IndexType>;
+
+		namespace Detail {
+
+			constexpr U32 SimplifyAttributes = 5;
+
+			enum class SimplifyVertexKind : U8 {
+				Manifold,
+				Border,
+				Locked
+			};
+
+			// Sum over the triangles merged into a vertex of area * (distance to the plane)^2 and, per attribute,
+			// area * (g.p + d - s)^2, where g.p + d interpolates the attribute linearly across the triangle.
+			// The parts independent of the attribute value s share A, B and C; G holds area * (g, d) per attribute.
+			struct Quadric {
+				F32 A00, A11, A22, A01, A02, A12;
+				F32 B0, B1, B2;
+				F32 C;
+				F32 W;
+				F32 G[SimplifyAttributes][4];
+			};
+
+			struct SimplifyVertex {
+				F32 Position[3];
+				F32 Attributes[SimplifyAttributes];
+			};
+
+			struct EdgeCollapse {
+				U32 From;
+				U32 To;
+				F32 Error;
+			};
+
+			struct PositionKey {
+				U32 Bits[3];
+
+				auto operator==(PositionKey const& rhs) const noexcept -> bool = default;
+			};
+
+			auto Accumulate(Quadric& lhs, Quadric const& rhs) noexcept -> void;
+			auto Evaluate(Quadric const& quadric, SimplifyVertex const& vertex) noexcept -> F32;
+			auto ComputeTriangleQuadric(SimplifyVertex const& v0, SimplifyVertex const& v1, SimplifyVertex const& v2) noexcept -> Quadric;
+			auto ComputeBorderQuadric(SimplifyVertex const& v0, SimplifyVertex const& v1, SimplifyVertex const& v2) noexcept -> Quadric;
+
+			auto PrepareSimplifyVertices(std::span<Vertex const> vertices, SimplifyOptions const& options, F32& extent) -> std::vector<SimplifyVertex>;
+			auto ComputePositionIds(std::span<Vertex const> vertices) -> std::vector<U32>;
+
+			template<typename IndexType>
+			auto ClassifySimplifyVertices(std::span<IndexType const> indices, VertexCorners const& adjacency, std::vector<U32> const& positionIds, bool lockBorder, Jobs::Scheduler* pScheduler) -> std::vector<SimplifyVertexKind>;
+			template<typename IndexType>
+			auto CountSharedTriangles(std::span<IndexType const> indices, VertexCorners const& adjacency, std::vector<U32> const& positionIds, U32 from, U32 to) noexcept -> U32;
+			template<typename IndexType>
+			auto HasTriangleFlips(std::span<IndexType const> indices, VertexCorners const& adjacency, std::vector<U32> const& positionIds, std::vector<SimplifyVertex> const& vertices, std::vector<U32> const& collapseTo, U32 from, U32 to) noexcept -> bool;
+			template<typename IndexType>
+			auto SimplifyIndices(std::span<Vertex const> vertices, std::span<IndexType> indices, SimplifyOptions const& options, Jobs::Scheduler* pScheduler) -> SimplifyResult;
+
+		}
+	}
+}
+
+namespace Hawk {
+	namespace Geometry {
+
+		template<typename IndexType>
+		[[nodiscard]] ILINE auto Simplify(std::span<Vertex const> vertices, std::span<IndexType> indices, SimplifyOptions const& options, Jobs::Scheduler* pScheduler) -> SimplifyResult {
+			return Detail::SimplifyIndices(vertices, indices, options, pScheduler);
+		}
+
+		template<typename IndexType>
+		ILINE auto Simplify(Mesh<Vertex, IndexType>& mesh, SimplifyOptions const& options, Jobs::Scheduler* pScheduler) -> SimplifyResult {
+			auto const result = Detail::SimplifyIndices(std::span<Vertex const>{ mesh.Vertices }, std::span<IndexType>{ mesh.Indices }, options, pScheduler);
+			mesh.Indices.resize(result.CountIndices);
+			return result;
+		}
+
+		template<typename IndexType>
+		[[nodiscard]] ILINE auto GenerateLodChain(std::span<Vertex const> vertices, std::span<IndexType const> indices, LodOptions const& options, Jobs::Scheduler* pScheduler) -> LodChain<IndexType> {
+			if (indices.size() > (std::numeric_limits<U32>::max)())
+				throw std::length_error("Mesh is too large for 32-bit index offsets");
+
+			auto chain = LodChain<IndexType>{};
+			chain.Indices.assign(indices.begin(), indices.end());
+			chain.Levels.push_back(LodLevel{ 0, static_cast<U32>(indices.size()), 0.0f });
+
+			auto current = std::vector<IndexType>(indices.begin(), indices.end());
+			auto error = 0.0f;
+			while (chain.Levels.size() < options.MaxLevels && current.size() / 3 > options.MinTriangles) {
+				auto simplify = options.Simplify;
+				simplify.TargetTriangles = (std::max)(options.MinTriangles, static_cast<size_t>(static_cast<F32>(current.size() / 3) * options.Ratio));
+
+				auto const result = Detail::SimplifyIndices(vertices, std::span<IndexType>{ current }, simplify, pScheduler);
+				if (4 * result.CountIndices > 3 * current.size())
+					break;
+
+				current.resize(result.CountIndices);
+				error += result.Error;
+				chain.Levels.push_back(LodLevel{ static_cast<U32>(chain.Indices.size()), static_cast<U32>(current.size()), error });
+				chain.Indices.insert(chain.Indices.end(), current.begin(), current.end());
+			}
+			return chain;
+		}
+
+		namespace Detail {
+
+			ILINE auto Accumulate(Quadric& lhs, Quadric const& rhs) noexcept -> void {
+				auto* target = &lhs.A00;
+				auto const* source = &rhs.A00;
+				for (auto index = 0u; index < sizeof(Quadric) / sizeof(F32); index++)
+					target[index] += source[index];
+			}
+
+			// Unnormalized: divide by W for the area-weighted mean squared deviation
+			[[nodiscard]] ILINE auto Evaluate(Quadric const& quadric, SimplifyVertex const& vertex) noexcept -> F32 {
+				auto const x = vertex.Position[0], y = vertex.Position[1], z = vertex.Position[2];
+				auto error = quadric.A00 * x * x + quadric.A11 * y * y + quadric.A22 * z * z
+					+ 2.0f * (quadric.A01 * x * y + quadric.A02 * x * z + quadric.A12 * y * z)
+					+ 2.0f * (quadric.B0 * x + quadric.B1 * y + quadric.B2 * z) + quadric.C;
+				for (auto attribute = 0u; attribute < SimplifyAttributes; attribute++) {
+					auto const s = vertex.Attributes[attribute];
+					auto const* g = quadric.G[attribute];
+					error += s * (s * quadric.W - 2.0f * (g[0] * x + g[1] * y + g[2] * z + g[3]));
+				}
+				return (std::max)(error, 0.0f);
+			}
+
+			[[nodiscard]] ILINE auto ComputeTriangleQuadric(SimplifyVertex const& v0, SimplifyVertex const& v1, SimplifyVertex const& v2) noexcept -> Quadric {
+				auto const* p0 = v0.Position;
+				auto const e1x = v1.Position[0] - p0[0], e1y = v1.Position[1] - p0[1], e1z = v1.Position[2] - p0[2];
+				auto const e2x = v2.Position[0] - p0[0], e2y = v2.Position[1] - p0[1], e2z = v2.Position[2] - p0[2];
+				auto const nx = e1y * e2z - e1z * e2y, ny = e1z * e2x - e1x * e2z, nz = e1x * e2y - e1y * e2x;
+				auto const lengthSquared = nx * nx + ny * ny + nz * nz;
+
+				auto quadric = Quadric{};
+				if (lengthSquared <= 0.0f)
+					return quadric;
+
+				auto const length = Math::Sqrt(lengthSquared);
+				auto const area = 0.5f * length;
+				auto const add = [&](F32 ax, F32 ay, F32 az, F32 d) {
+					quadric.A00 += area * ax * ax; quadric.A11 += area * ay * ay; quadric.A22 += area * az * az;
+					quadric.A01 += area * ax * ay; quadric.A02 += area * ax * az; quadric.A12 += area * ay * az;
+					quadric.B0 += area * ax * d; quadric.B1 += area * ay * d; quadric.B2 += area * az * d;
+					quadric.C += area * d * d;
+				};
+
+				auto const ux = nx / length, uy = ny / length, uz = nz / length;
+				add(ux, uy, uz, -(ux * p0[0] + uy * p0[1] + uz * p0[2]));
+				quadric.W = area;
+
+				// Gradient in the triangle's plane: g.e1 = ds1 and g.e2 = ds2 with g perpendicular to the normal
+				auto const ax = (e2y * nz - e2z * ny) / lengthSquared, ay = (e2z * nx - e2x * nz) / lengthSquared, az = (e2x * ny - e2y * nx) / lengthSquared;
+				auto const bx = (ny * e1z - nz * e1y) / lengthSquared, by = (nz * e1x - nx * e1z) / lengthSquared, bz = (nx * e1y - ny * e1x) / lengthSquared;
+				for (auto attribute = 0u; attribute < SimplifyAttributes; attribute++) {
+					auto const s0 = v0.Attributes[attribute];
+					auto const ds1 = v1.Attributes[attribute] - s0;
+					auto const ds2 = v2.Attributes[attribute] - s0;
+					auto const gx = ds1 * ax + ds2 * bx, gy = ds1 * ay + ds2 * by, gz = ds1 * az + ds2 * bz;
+					auto const d = s0 - (gx * p0[0] + gy * p0[1] + gz * p0[2]);
+					add(gx, gy, gz, d);
+					quadric.G[attribute][0] = area * gx;
+					quadric.G[attribute][1] = area * gy;
+					quadric.G[attribute][2] = area * gz;
+					quadric.G[attribute][3] = area * d;
+				}
+				return quadric;
+			}
+
+			// The plane through the border edge v0 v1 perpendicular to its triangle, weighted by the squared edge
+			// length so it competes with the area-weighted triangle planes. Sliding along a straight border costs
+			// nothing while pulling a corner or a curved border inwards does. It leaves W alone.
+			[[nodiscard]] ILINE auto ComputeBorderQuadric(SimplifyVertex const& v0, SimplifyVertex const& v1, SimplifyVertex const& v2) noexcept -> Quadric {
+				constexpr auto BorderWeight = 10.0f;
+
+				auto const* p0 = v0.Position;
+				auto const e1x = v1.Position[0] - p0[0], e1y = v1.Position[1] - p0[1], e1z = v1.Position[2] - p0[2];
+				auto const e2x = v2.Position[0] - p0[0], e2y = v2.Position[1] - p0[1], e2z = v2.Position[2] - p0[2];
+				auto const nx = e1y * e2z - e1z * e2y, ny = e1z * e2x - e1x * e2z, nz = e1x * e2y - e1y * e2x;
+				auto const px = e1y * nz - e1z * ny, py = e1z * nx - e1x * nz, pz = e1x * ny - e1y * nx;
+				auto const lengthSquared = px * px + py * py + pz * pz;
+
+				auto quadric = Quadric{};
+				if (lengthSquared <= 0.0f)
+					return quadric;
+
+				auto const length = Math::Sqrt(lengthSquared);
+				auto const ux = px / length, uy = py / length, uz = pz / length;
+				auto const d = -(ux * p0[0] + uy * p0[1] + uz * p0[2]);
+				auto const weight = BorderWeight * (e1x * e1x + e1y * e1y + e1z * e1z);
+				quadric.A00 = weight * ux * ux; quadric.A11 = weight * uy * uy; quadric.A22 = weight * uz * uz;
+				quadric.A01 = weight * ux * uy; quadric.A02 = weight * ux * uz; quadric.A12 = weight * uy * uz;
+				quadric.B0 = weight * ux * d; quadric.B1 = weight * uy * d; quadric.B2 = weight * uz * d;
+				quadric.C = weight * d * d;
+				return quadric;
+			}
+
+			// Positions move into the unit cube so errors and attribute weights don't depend on the mesh's scale
+			[[nodiscard]] ILINE auto PrepareSimplifyVertices(std::span<Vertex const> vertices, SimplifyOptions const& options, F32& extent) -> std::vector<SimplifyVertex> {
+				F32 minimum[3] = { (std::numeric_limits<F32>::max)(), (std::numeric_limits<F32>::max)(), (std::numeric_limits<F32>::max)() };
+				F32 maximum[3] = { std::numeric_limits<F32>::lowest(), std::numeric_limits<F32>::lowest(), std::numeric_limits<F32>::lowest() };
+				for (auto const& vertex : vertices) {
+					F32 const p[3] = { vertex.Position.x, vertex.Position.y, vertex.Position.z };
+					for (auto axis = 0u; axis < 3; axis++) {
+						minimum[axis] = (std::min)(minimum[axis], p[axis]);
+						maximum[axis] = (std::max)(maximum[axis], p[axis]);
+					}
+				}
+				extent = vertices.empty() ? 0.0f : (std::max)({ maximum[0] - minimum[0], maximum[1] - minimum[1], maximum[2] - minimum[2] });
+				auto const scale = extent > 0.0f ? 1.0f / extent : 0.0f;
+
+				auto result = std::vector<SimplifyVertex>(vertices.size());
+				for (auto index = size_t{ 0 }; index < vertices.size(); index++) {
+					auto const& source = vertices[index];
+					result[index] = SimplifyVertex{
+						{ (source.Position.x - minimum[0]) * scale, (source.Position.y - minimum[1]) * scale, (source.Position.z - minimum[2]) * scale },
+						{ source.Normal.x * options.NormalWeight, source.Normal.y * options.NormalWeight, source.Normal.z * options.NormalWeight,
+						  source.Texcoord.x * options.TexcoordWeight, source.Texcoord.y * options.TexcoordWeight }
+					};
+				}
+				return result;
+			}
+
+			// Maps every vertex to the first vertex with bitwise the same position
+			[[nodiscard]] ILINE auto ComputePositionIds(std::span<Vertex const> vertices) -> std::vector<U32> {
+				auto result = std::vector<U32>(vertices.size());
+				auto map = FlatHashMap<PositionKey, U32>{};
+				map.Reserve(vertices.size());
+				for (auto index = U32{ 0 }; index < vertices.size(); index++) {
+					auto const& p = vertices[index].Position;
+					auto const key = PositionKey{ { std::bit_cast<U32>(p.x + 0.0f), std::bit_cast<U32>(p.y + 0.0f), std::bit_cast<U32>(p.z + 0.0f) } };
+					result[index] = *map.TryEmplace(key, index).first;
+				}
+				return result;
+			}
+
+			// Counts, for every neighbouring position, the triangles of the vertex that also contain it: one means
+			// a border edge, more than two a non-manifold one. Seam vertices are locked outright.
+			template<typename IndexType>
+			[[nodiscard]] ILINE auto ClassifySimplifyVertices(std::span<IndexType const> indices, VertexCorners const& adjacency, std::vector<U32> const& positionIds, bool lockBorder, Jobs::Scheduler* pScheduler) -> std::vector<SimplifyVertexKind> {
+				auto const countVertices = static_cast<U32>(positionIds.size());
+				auto isSeam = std::vector<U8>(countVertices, 0);
+				for (auto vertex = U32{ 0 }; vertex < countVertices; vertex++)
+					if (positionIds[vertex] != vertex)
+						isSeam[vertex] = isSeam[positionIds[vertex]] = 1;
+
+				auto kinds = std::vector<SimplifyVertexKind>(countVertices, SimplifyVertexKind::Manifold);
+				ParallelRange(pScheduler, countVertices, [&](U32 begin, U32 end) {
+					auto neighbours = std::vector<U32>{};
+					for (auto vertex = begin; vertex < end; vertex++) {
+						if (isSeam[vertex]) {
+							kinds[vertex] = SimplifyVertexKind::Locked;
+							continue;
+						}
+
+						neighbours.clear();
+						for (auto offset = adjacency.Offsets[vertex]; offset < adjacency.Offsets[vertex + 1]; offset++) {
+							auto const corner = adjacency.Corners[offset];
+							auto const first = corner - corner % 3;
+							neighbours.push_back(positionIds[indices[first + (corner + 1) % 3]]);
+							neighbours.push_back(positionIds[indices[first + (corner + 2) % 3]]);
+						}
+						std::sort(neighbours.begin(), neighbours.end());
+
+						auto kind = SimplifyVertexKind::Manifold;
+						for (auto index = size_t{ 0 }; index < neighbours.size() && kind != SimplifyVertexKind::Locked;) {
+							auto next = index;
+							while (next < neighbours.size() && neighbours[next] == neighbours[index])
+								next++;
+							if (next - index > 2 || neighbours[index] == positionIds[vertex])
+								kind = SimplifyVertexKind::Locked;
+							else if (next - index == 1)
+								kind = lockBorder ? SimplifyVertexKind::Locked : SimplifyVertexKind::Border;
+							index = next;
+						}
+						kinds[vertex] = kind;
+					}
+				});
+				return kinds;
+			}
+
+			template<typename IndexType>
+			[[nodiscard]] ILINE auto CountSharedTriangles(std::span<IndexType const> indices, VertexCorners const& adjacency, std::vector<U32> const& positionIds, U32 from, U32 to) noexcept -> U32 {
+				auto count = U32{ 0 };
+				for (auto offset = adjacency.Offsets[from]; offset < adjacency.Offsets[from + 1]; offset++) {
+					auto const first = adjacency.Corners[offset] - adjacency.Corners[offset] % 3;
+					count += positionIds[indices[first + 0]] == positionIds[to] || positionIds[indices[first + 1]] == positionIds[to] || positionIds[indices[first + 2]] == positionIds[to];
+				}
+				return count;
+			}
+
+			// A triangle that survives the collapse must not turn over or fold to a sliver; one that is already a
+			// sliver has no facing to lose. The test only holds for corners that stay put, so a triangle whose
+			// other corners already moved this pass also counts.
+			template<typename IndexType>
+			[[nodiscard]] ILINE auto HasTriangleFlips(std::span<IndexType const> indices, VertexCorners const& adjacency, std::vector<U32> const& positionIds, std::vector<SimplifyVertex> const& vertices, std::vector<U32> const& collapseTo, U32 from, U32 to) noexcept -> bool {
+				auto const* target = vertices[to].Position;
+				for (auto offset = adjacency.Offsets[from]; offset < adjacency.Offsets[from + 1]; offset++) {
+					auto const corner = adjacency.Corners[offset];
+					auto const first = corner - corner % 3;
+					auto const b = static_cast<U32>(indices[first + (corner + 1) % 3]);
+					auto const c = static_cast<U32>(indices[first + (corner + 2) % 3]);
+					if (positionIds[b] == positionIds[to] || positionIds[c] == positionIds[to])
+						continue;
+					if (collapseTo[b] != b || collapseTo[c] != c)
+						return true;
+
+					auto const* pa = vertices[from].Position;
+					auto const* pb = vertices[b].Position;
+					auto const* pc = vertices[c].Position;
+					auto const bx = pb[0] - pa[0], by = pb[1] - pa[1], bz = pb[2] - pa[2];
+					auto const cx = pc[0] - pa[0], cy = pc[1] - pa[1], cz = pc[2] - pa[2];
+					auto const tbx = pb[0] - target[0], tby = pb[1] - target[1], tbz = pb[2] - target[2];
+					auto const tcx = pc[0] - target[0], tcy = pc[1] - target[1], tcz = pc[2] - target[2];
+					auto const n0x = by * cz - bz * cy, n0y = bz * cx - bx * cz, n0z = bx * cy - by * cx;
+					auto const n1x = tby * tcz - tbz * tcy, n1y = tbz * tcx - tbx * tcz, n1z = tbx * tcy - tby * tcx;
+					auto const n0 = n0x * n0x + n0y * n0y + n0z * n0z;
+					if (n0 <= 1.0e-6f * (bx * bx + by * by + bz * bz) * (cx * cx + cy * cy + cz * cz))
+						continue;
+
+					auto const dot = n0x * n1x + n0y * n1y + n0z * n1z;
+					if (dot <= 0.0f || dot * dot < 0.0625f * n0 * (n1x * n1x + n1y * n1y + n1z * n1z))
+						return true;
+				}
+				return false;
+			}
+
+			// Passes of independent collapses: every vertex's cheapest allowed collapse is bucket-sorted by cost
+			// and taken in order unless an endpoint already moved or received a vertex in this pass.
+			// Degenerate triangles are dropped and the adjacency rebuilt before the next pass.
+			template<typename IndexType>
+			[[nodiscard]] ILINE auto SimplifyIndices(std::span<Vertex const> vertices, std::span<IndexType> indices, SimplifyOptions const& options, Jobs::Scheduler* pScheduler) -> SimplifyResult {
+				if (indices.size() % 3 != 0)
+					throw std::length_error("Index count is not a multiple of three");
+				if (indices.size() > (std::numeric_limits<U32>::max)() || vertices.size() >= (std::numeric_limits<U32>::max)())
+					throw std::length_error("Mesh is too large for 32-bit vertex ids");
+
+				auto extent = 0.0f;
+				auto const points = PrepareSimplifyVertices(vertices, options, extent);
+				auto const positionIds = ComputePositionIds(vertices);
+				auto const countVertices = static_cast<U32>(vertices.size());
+
+				auto adjacency = ComputeVertexCorners(std::span<IndexType const>{ indices }, countVertices);
+				auto const kinds = ClassifySimplifyVertices(std::span<IndexType const>{ indices }, adjacency, positionIds, options.LockBorder, pScheduler);
+
+				auto quadrics = std::vector<Quadric>(countVertices, Quadric{});
+				for (auto first = size_t{ 0 }; first < indices.size(); first += 3) {
+					auto const quadric = ComputeTriangleQuadric(points[indices[first + 0]], points[indices[first + 1]], points[indices[first + 2]]);
+					for (auto corner = first; corner < first + 3; corner++)
+						Accumulate(quadrics[indices[corner]], quadric);
+				}
+
+				// Border vertices see all of their triangles, so the edge count is taken from their side
+				for (auto corner = size_t{ 0 }; corner < indices.size(); corner++) {
+					auto const first = corner - corner % 3;
+					auto const a = static_cast<U32>(indices[corner]);
+					auto const b = static_cast<U32>(indices[first + (corner + 1) % 3]);
+					auto const c = static_cast<U32>(indices[first + (corner + 2) % 3]);
+					if (kinds[a] != SimplifyVertexKind::Border && kinds[b] != SimplifyVertexKind::Border)
+						continue;
+					if (CountSharedTriangles(std::span<IndexType const>{ indices }, adjacency, positionIds, kinds[a] == SimplifyVertexKind::Border ? a : b, kinds[a] == SimplifyVertexKind::Border ? b : a) != 1)
+						continue;
+
+					auto const quadric = ComputeBorderQuadric(points[a], points[b], points[c]);
+					Accumulate(quadrics[a], quadric);
+					Accumulate(quadrics[b], quadric);
+				}
+
+				// The target's own share of the cost only changes with its quadric, so it is kept per vertex and
+				// refreshed for the vertices a pass touched
+				auto residuals = std::vector<F32>(countVertices);
+				ParallelRange(pScheduler, countVertices, [&](U32 begin, U32 end) {
+					for (auto vertex = begin; vertex < end; vertex++)
+						residuals[vertex] = Evaluate(quadrics[vertex], points[vertex]);
+				});
+				auto const cost = [&](U32 from, U32 to) {
+					auto const weight = quadrics[from].W + quadrics[to].W;
+					return weight > 0.0f ? (Evaluate(quadrics[from], points[to]) + residuals[to]) / weight : 0.0f;
+				};
+				auto const canCollapse = [&](U32 from, U32 to) {
+					switch (kinds[from]) {
+					case SimplifyVertexKind::Manifold:
+						return true;
+					case SimplifyVertexKind::Border:
+						return kinds[to] != SimplifyVertexKind::Manifold && CountSharedTriangles(std::span<IndexType const>{ indices }, adjacency, positionIds, from, to) == 1;
+					default:
+						return false;
+					}
+				};
+
+				constexpr auto Invalid = (std::numeric_limits<U32>::max)();
+				auto const errorLimit = options.TargetError * options.TargetError;
+				auto countIndices = indices.size();
+				auto maxError = 0.0f;
+				auto candidates = std::vector<EdgeCollapse>(countVertices);
+				auto sorted = std::vector<EdgeCollapse>{};
+				auto touched = std::vector<U8>(countVertices);
+				auto collapseTo = std::vector<U32>(countVertices);
+
+				while (countIndices / 3 > options.TargetTriangles) {
+					auto const current = std::span<IndexType const>{ indices.data(), countIndices };
+
+					// One candidate per vertex: its cheapest allowed collapse, so the vertex's quadric stays in cache
+					// while its neighbours are tried and every edge is still costed in both directions. Around a
+					// consistently wound manifold fan each neighbour follows the vertex in exactly one triangle;
+					// border fans also need the neighbours that only precede it.
+					ParallelRange(pScheduler, countVertices, [&](U32 begin, U32 end) {
+						for (auto vertex = begin; vertex < end; vertex++) {
+							auto best = EdgeCollapse{ Invalid, Invalid, (std::numeric_limits<F32>::max)() };
+							auto const consider = [&](U32 to) {
+								if (!canCollapse(vertex, to))
+									return;
+								auto const error = cost(vertex, to);
+								if (error < best.Error)
+									best = EdgeCollapse{ vertex, to, error };
+							};
+							if (kinds[vertex] != SimplifyVertexKind::Locked) {
+								for (auto offset = adjacency.Offsets[vertex]; offset < adjacency.Offsets[vertex + 1]; offset++) {
+									auto const corner = adjacency.Corners[offset];
+									auto const first = corner - corner % 3;
+									consider(static_cast<U32>(current[first + (corner + 1) % 3]));
+									if (kinds[vertex] == SimplifyVertexKind::Border)
+										consider(static_cast<U32>(current[first + (corner + 2) % 3]));
+								}
+							}
+							candidates[vertex] = best.Error <= errorLimit ? best : EdgeCollapse{ Invalid, Invalid, 0.0f };
+						}
+					});
+					auto const countCandidates = static_cast<size_t>(std::count_if(candidates.begin(), candidates.end(), [](auto const& candidate) { return candidate.From != Invalid; }));
+					if (countCandidates == 0)
+						break;
+
+					// Counting sort on the top bits of the float cost: exponent and two mantissa bits are plenty
+					constexpr auto CountBuckets = 1u << 11;
+					auto buckets = std::vector<U32>(CountBuckets + 1, 0);
+					for (auto const& candidate : candidates)
+						if (candidate.From != Invalid)
+							buckets[(std::bit_cast<U32>(candidate.Error) >> 21) + 1]++;
+					for (auto bucket = 1u; bucket <= CountBuckets; bucket++)
+						buckets[bucket] += buckets[bucket - 1];
+					sorted.resize(countCandidates);
+					for (auto const& candidate : candidates)
+						if (candidate.From != Invalid)
+							sorted[buckets[std::bit_cast<U32>(candidate.Error) >> 21]++] = candidate;
+
+					std::fill(touched.begin(), touched.end(), U8{ 0 });
+					for (auto vertex = U32{ 0 }; vertex < countVertices; vertex++)
+						collapseTo[vertex] = vertex;
+
+					// A collapse removes about two triangles but blocks the half dozen around it, so a pass settles
+					// for a sixth of the goal before it gives up on collapses costing well over the cheapest goal / 6
+					// candidates. Free collapses (the lowest bucket) are often degenerate and rejected, so they don't
+					// set the bar.
+					auto const goal = countIndices / 3 - options.TargetTriangles;
+					auto const countFree = buckets[0];
+					auto const passLimit = countFree + goal / 6 < sorted.size() ? 1.5f * sorted[countFree + goal / 6].Error : (std::numeric_limits<F32>::max)();
+					auto removed = size_t{ 0 };
+					auto collapsed = size_t{ 0 };
+					for (auto const& candidate : sorted) {
+						if (removed >= goal || (candidate.Error > passLimit && candidate.Error > maxError && removed > goal / 6))
+							break;
+						if (touched[candidate.From] || touched[candidate.To])
+							continue;
+						if (HasTriangleFlips(current, adjacency, positionIds, points, collapseTo, candidate.From, candidate.To))
+							continue;
+
+						removed += CountSharedTriangles(current, adjacency, positionIds, candidate.From, candidate.To);
+						collapseTo[candidate.From] = candidate.To;
+						touched[candidate.From] = touched[candidate.To] = 1;
+						Accumulate(quadrics[candidate.To], quadrics[candidate.From]);
+						maxError = (std::max)(maxError, candidate.Error);
+						collapsed++;
+					}
+					if (collapsed == 0)
+						break;
+
+					for (auto vertex = U32{ 0 }; vertex < countVertices; vertex++)
+						if (touched[vertex] && collapseTo[vertex] == vertex)
+							residuals[vertex] = Evaluate(quadrics[vertex], points[vertex]);
+
+					// Triangles that lost an edge, including ones squeezed between two wedges of one position, go away
+					auto write = size_t{ 0 };
+					for (auto first = size_t{ 0 }; first < countIndices; first += 3) {
+						auto const i0 = collapseTo[indices[first + 0]], i1 = collapseTo[indices[first + 1]], i2 = collapseTo[indices[first + 2]];
+						if (positionIds[i0] == positionIds[i1] || positionIds[i1] == positionIds[i2] || positionIds[i0] == positionIds[i2])
+							continue;
+						indices[write + 0] = static_cast<IndexType>(i0);
+						indices[write + 1] = static_cast<IndexType>(i1);
+						indices[write + 2] = static_cast<IndexType>(i2);
+						write += 3;
+					}
+					countIndices = write;
+					adjacency = ComputeVertexCorners(std::span<IndexType const>{ indices.data(), countIndices }, countVertices);
+				}
+				return SimplifyResult{ countIndices, Math::Sqrt(maxError) * extent };
+			}
+
+		}
+	}
+}
\ No newline at end of file
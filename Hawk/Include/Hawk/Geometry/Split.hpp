@@ -0,0 +1,143 @@
+#pragma once
+
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+#include "./Generator.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Geometry/Generator.hpp>
+
+namespace Hawk {
+	namespace Geometry {
+
+		constexpr U32 MaxVertices16Bit = U32{ (std::numeric_limits<U16>::max)() } + 1;
+
+		// One draw: CountIndices indices from FirstIndex, relative to the CountVertices vertices from VertexBase
+		struct SubMesh {
+			U32 FirstIndex;
+			U32 CountIndices;
+			U32 VertexBase;
+			U32 CountVertices;
+		};
+
+		// Remap[i] is the source vertex of output vertex i; sub-meshes follow each other in both the index and the
+		// output vertex order. When the source is in first-use order, as OptimizeVertexFetch leaves it, Remap[i] <= i
+		// and a vertex array can be expanded in place from the back.
+		struct IndexSplit {
+			std::vector<SubMesh> SubMeshes;
+			std::vector<U32>     Remap;
+		};
+
+		// Cuts the triangle list, keeping its order, into runs that reference at most maxVertices distinct vertices
+		// and rewrites the indices relative to their run, so each run fits 16-bit indices. Only vertices used on
+		// both sides of a cut are copied. A mesh that already fits stays whole, with its indices and vertex order
+		// untouched.
+		template<typename IndexType>
+		auto SplitFor16BitIndices(std::span<IndexType> indices, U32 countVertices, U32 maxVertices = MaxVertices16Bit) -> IndexSplit;
+
+		template<typename IndexType>
+		auto SplitFor16BitIndices(Mesh<Vertex, IndexType> const& mesh) -> std::vector<Mesh<Vertex, U16>>;
+
+		template<typename IndexType>
+		auto NarrowIndices(std::span<IndexType const> indices, std::span<U16> result) -> void;
+	}
+}
+
+namespace Hawk {
+	namespace Geometry {
+
+		template<typename IndexType>
+		[[nodiscard]] ILINE auto SplitFor16BitIndices(std::span<IndexType> indices, U32 countVertices, U32 maxVertices) -> IndexSplit {
+			if (indices.size() % 3 != 0)
+				throw std::length_error("Index count is not a multiple of three");
+			if (indices.size() > (std::numeric_limits<U32>::max)())
+				throw std::length_error("Mesh is too large for 32-bit index offsets");
+			if (maxVertices < 3 || maxVertices > MaxVertices16Bit)
+				throw std::out_of_range("Sub-mesh vertex limit out of range");
+			for (auto const index : indices)
+				if (static_cast<U64>(index) >= countVertices)
+					throw std::out_of_range("Index references a vertex past the end of the vertex buffer");
+
+			auto result = IndexSplit{};
+			if (countVertices <= maxVertices) {
+				result.SubMeshes.push_back(SubMesh{ 0, static_cast<U32>(indices.size()), 0, countVertices });
+				result.Remap.resize(countVertices);
+				std::iota(result.Remap.begin(), result.Remap.end(), U32{ 0 });
+				return result;
+			}
+
+			// Local ids are valid only while the stamp matches the current sub-mesh
+			constexpr auto Invalid = (std::numeric_limits<U32>::max)();
+			auto local = std::vector<U32>(countVertices, 0);
+			auto stamp = std::vector<U32>(countVertices, Invalid);
+
+			auto current = SubMesh{ 0, 0, 0, 0 };
+			auto const close = [&]() {
+				result.SubMeshes.push_back(current);
+				current = SubMesh{ current.FirstIndex + current.CountIndices, 0, current.VertexBase + current.CountVertices, 0 };
+			};
+
+			auto const countSubMesh = [&]() { return static_cast<U32>(result.SubMeshes.size()); };
+			for (auto first = size_t{ 0 }; first < indices.size(); first += 3) {
+				auto countNew = U32{ 0 };
+				for (auto corner = 0u; corner < 3; corner++) {
+					auto const vertex = static_cast<U32>(indices[first + corner]);
+					auto isRepeated = stamp[vertex] == countSubMesh();
+					for (auto previous = 0u; previous < corner; previous++)
+						isRepeated |= static_cast<U32>(indices[first + previous]) == vertex;
+					countNew += !isRepeated;
+				}
+				if (current.CountVertices + countNew > maxVertices)
+					close();
+
+				for (auto corner = 0u; corner < 3; corner++) {
+					auto const vertex = static_cast<U32>(indices[first + corner]);
+					if (stamp[vertex] != countSubMesh()) {
+						stamp[vertex] = countSubMesh();
+						local[vertex] = current.CountVertices++;
+						result.Remap.push_back(vertex);
+					}
+					indices[first + corner] = static_cast<IndexType>(local[vertex]);
+				}
+				current.CountIndices += 3;
+			}
+			if (current.CountIndices > 0)
+				close();
+			return result;
+		}
+
+		template<typename IndexType>
+		[[nodiscard]] ILINE auto SplitFor16BitIndices(Mesh<Vertex, IndexType> const& mesh) -> std::vector<Mesh<Vertex, U16>> {
+			auto indices = mesh.Indices;
+			auto const split = SplitFor16BitIndices(std::span<IndexType>{ indices }, static_cast<U32>(mesh.Vertices.size()));
+
+			auto result = std::vector<Mesh<Vertex, U16>>(split.SubMeshes.size());
+			for (auto index = size_t{ 0 }; index < split.SubMeshes.size(); index++) {
+				auto const& subMesh = split.SubMeshes[index];
+				auto& target = result[index];
+				target.Vertices.reserve(subMesh.CountVertices);
+				for (auto vertex = subMesh.VertexBase; vertex < subMesh.VertexBase + subMesh.CountVertices; vertex++)
+					target.Vertices.push_back(mesh.Vertices[split.Remap[vertex]]);
+				target.Indices.resize(subMesh.CountIndices);
+				NarrowIndices(std::span<IndexType const>{ indices }.subspan(subMesh.FirstIndex, subMesh.CountIndices), std::span<U16>{ target.Indices });
+			}
+			return result;
+		}
+
+		template<typename IndexType>
+		ILINE auto NarrowIndices(std::span<IndexType const> indices, std::span<U16> result) -> void {
+			if (result.size() < indices.size())
+				throw std::length_error("Narrowed span is shorter than the index span");
+			for (auto index = size_t{ 0 }; index < indices.size(); index++) {
+				if (static_cast<U64>(indices[index]) > (std::numeric_limits<U16>::max)())
+					throw std::out_of_range("Index does not fit 16 bits");
+				result[index] = static_cast<U16>(indices[index]);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,252 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+#include "../Common/Jobs.hpp"
+#include "../Math/Math.hpp"
+#include "./Generator.hpp"
+#include "./Normals.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/Jobs.hpp>
+//#include <Hawk/Math/Math.hpp>
+//#include <Hawk/Geometry/Generator.hpp>
+//#include <Hawk/Geometry/Normals.hpp>
+
+namespace Hawk {
+	namespace Geometry {
+
+		// Output of ComputeTangents: Remap[i] is the source vertex of output vertex i. Every source vertex keeps at
+		// least one output and outputs follow source order, so Remap[i] <= i and a vertex array can be expanded
+		// in place from the back.
+		struct TangentSplit {
+			std::vector<Math::Vec4> Tangents;
+			std::vector<U32>        Remap;
+		};
+
+		// Tangent frames following MikkTSpace: each corner contributes its face's texture-space u direction,
+		// projected into the vertex's tangent plane and weighted by the corner angle measured in that plane.
+		// Corners are only averaged with corners of the same handedness, so a vertex on a mirrored UV seam is
+		// split in two and the indices are rewritten. Tangent.w is the bitangent sign, B = w * Cross(N, T).
+		template<typename IndexType>
+		auto ComputeTangents(std::span<Math::Vec3 const> positions, std::span<Math::Vec3 const> normals, std::span<Math::Vec2 const> texcoords, std::span<IndexType> indices, Jobs::Scheduler* pScheduler = nullptr) -> TangentSplit;
+
+		template<typename IndexType>
+		auto ComputeTangents(std::span<Vertex const> vertices, std::span<IndexType> indices, Jobs::Scheduler* pScheduler = nullptr) -> TangentSplit;
+
+		template<typename IndexType>
+		auto ComputeTangents(Mesh<Vertex, IndexType>& mesh, Jobs::Scheduler* pScheduler = nullptr) -> void;
+
+		namespace Detail {
+
+			struct TangentInput {
+				Strided<Math::Vec3 const> Positions;
+				Strided<Math::Vec3 const> Normals;
+				Strided<Math::Vec2 const> Texcoords;
+				size_t                    CountVertices;
+			};
+
+			// Unit texture-space u direction of a face and Cross(dP/du, dP/dv), whose side of the vertex normal
+			// gives the handedness. Both are zero for faces without a usable UV mapping.
+			struct FaceTangent {
+				Math::Vec3 Tangent;
+				Math::Vec3 Orientation;
+			};
+
+			auto Orthogonal(Math::Vec3 const& normal) noexcept -> Math::Vec3;
+			auto ProjectToPlane(Math::Vec3 const& normal, Math::Vec3 const& v) noexcept -> Math::Vec3;
+
+			template<typename IndexType>
+			auto ComputeFaceTangents(TangentInput const& input, std::span<IndexType const> indices, Jobs::Scheduler* pScheduler) -> std::vector<FaceTangent>;
+			template<typename IndexType>
+			auto ComputeTangentSplit(TangentInput const& input, std::span<IndexType> indices, Jobs::Scheduler* pScheduler) -> TangentSplit;
+
+		}
+	}
+}
+
+namespace Hawk {
+	namespace Geometry {
+
+		template<typename IndexType>
+		[[nodiscard]] ILINE auto ComputeTangents(std::span<Math::Vec3 const> positions, std::span<Math::Vec3 const> normals, std::span<Math::Vec2 const> texcoords, std::span<IndexType> indices, Jobs::Scheduler* pScheduler) -> TangentSplit {
+			if (normals.size() < positions.size() || texcoords.size() < positions.size())
+				throw std::length_error("Normal or texcoord span is smaller than the position span");
+			auto const input = Detail::TangentInput{
+				Detail::Strided<Math::Vec3 const>{ reinterpret_cast<U8 const*>(positions.data()), sizeof(Math::Vec3) },
+				Detail::Strided<Math::Vec3 const>{ reinterpret_cast<U8 const*>(normals.data()), sizeof(Math::Vec3) },
+				Detail::Strided<Math::Vec2 const>{ reinterpret_cast<U8 const*>(texcoords.data()), sizeof(Math::Vec2) },
+				positions.size()
+			};
+			return Detail::ComputeTangentSplit(input, indices, pScheduler);
+		}
+
+		template<typename IndexType>
+		[[nodiscard]] ILINE auto ComputeTangents(std::span<Vertex const> vertices, std::span<IndexType> indices, Jobs::Scheduler* pScheduler) -> TangentSplit {
+			auto const* data = reinterpret_cast<U8 const*>(vertices.data());
+			auto const input = Detail::TangentInput{
+				Detail::Strided<Math::Vec3 const>{ data + offsetof(Vertex, Position), sizeof(Vertex) },
+				Detail::Strided<Math::Vec3 const>{ data + offsetof(Vertex, Normal), sizeof(Vertex) },
+				Detail::Strided<Math::Vec2 const>{ data + offsetof(Vertex, Texcoord), sizeof(Vertex) },
+				vertices.size()
+			};
+			return Detail::ComputeTangentSplit(input, indices, pScheduler);
+		}
+
+		template<typename IndexType>
+		ILINE auto ComputeTangents(Mesh<Vertex, IndexType>& mesh, Jobs::Scheduler* pScheduler) -> void {
+			auto const split = ComputeTangents(std::span<Vertex const>{ mesh.Vertices }, std::span<IndexType>{ mesh.Indices }, pScheduler);
+			mesh.Vertices.resize(split.Remap.size());
+			for (auto index = split.Remap.size(); index-- > 0;) {
+				mesh.Vertices[index] = mesh.Vertices[split.Remap[index]];
+				mesh.Vertices[index].Tangent = split.Tangents[index];
+			}
+		}
+
+		namespace Detail {
+
+			[[nodiscard]] ILINE auto Orthogonal(Math::Vec3 const& normal) noexcept -> Math::Vec3 {
+				auto const axis = Math::Abs(normal.x) > Math::Abs(normal.z) ? Math::Vec3{ -normal.y, normal.x, 0.0f } : Math::Vec3{ 0.0f, -normal.z, normal.y };
+				auto const tangent = NormalizeOrZero(axis);
+				return Math::Dot(tangent, tangent) > 0.0f ? tangent : Math::Vec3{ 1.0f, 0.0f, 0.0f };
+			}
+
+			// Spelled out in scalars: it runs three times per corner and the generic vector operators don't fold away
+			[[nodiscard]] ILINE auto ProjectToPlane(Math::Vec3 const& normal, Math::Vec3 const& v) noexcept -> Math::Vec3 {
+				auto const distance = normal.x * v.x + normal.y * v.y + normal.z * v.z;
+				auto const x = v.x - distance * normal.x;
+				auto const y = v.y - distance * normal.y;
+				auto const z = v.z - distance * normal.z;
+				auto const lengthSquared = x * x + y * y + z * z;
+				auto const scale = lengthSquared > 0.0f ? 1.0f / Math::Sqrt(lengthSquared) : 0.0f;
+				return Math::Vec3{ x * scale, y * scale, z * scale };
+			}
+
+			template<typename IndexType>
+			[[nodiscard]] ILINE auto ComputeFaceTangents(TangentInput const& input, std::span<IndexType const> indices, Jobs::Scheduler* pScheduler) -> std::vector<FaceTangent> {
+				auto faces = std::vector<FaceTangent>(indices.size() / 3);
+				ParallelRange(pScheduler, static_cast<U32>(faces.size()), [&](U32 begin, U32 end) {
+					for (auto face = begin; face < end; face++) {
+						auto const& p0 = input.Positions[indices[3 * face + 0]];
+						auto const& p1 = input.Positions[indices[3 * face + 1]];
+						auto const& p2 = input.Positions[indices[3 * face + 2]];
+						auto const& t0 = input.Texcoords[indices[3 * face + 0]];
+						auto const& t1 = input.Texcoords[indices[3 * face + 1]];
+						auto const& t2 = input.Texcoords[indices[3 * face + 2]];
+						auto const d1 = Math::Vec3{ p1.x - p0.x, p1.y - p0.y, p1.z - p0.z };
+						auto const d2 = Math::Vec3{ p2.x - p0.x, p2.y - p0.y, p2.z - p0.z };
+						auto const s1 = Math::Vec2{ t1.x - t0.x, t1.y - t0.y };
+						auto const s2 = Math::Vec2{ t2.x - t0.x, t2.y - t0.y };
+
+						// Twice the signed UV area; dP/du and dP/dv are these scaled by its inverse
+						auto const area = s1.x * s2.y - s1.y * s2.x;
+						auto const os = Math::Vec3{ s2.y * d1.x - s1.y * d2.x, s2.y * d1.y - s1.y * d2.y, s2.y * d1.z - s1.y * d2.z };
+						auto const ot = Math::Vec3{ s1.x * d2.x - s2.x * d1.x, s1.x * d2.y - s2.x * d1.y, s1.x * d2.z - s2.x * d1.z };
+						if (area == 0.0f) {
+							faces[face] = FaceTangent{ Math::Vec3{ 0.0f }, Math::Vec3{ 0.0f } };
+							continue;
+						}
+						auto const tangent = NormalizeOrZero(area > 0.0f ? os : Math::Vec3{ -os.x, -os.y, -os.z });
+						auto const orientation = Math::Vec3{ os.y * ot.z - os.z * ot.y, os.z * ot.x - os.x * ot.z, os.x * ot.y - os.y * ot.x };
+						faces[face] = FaceTangent{ tangent, orientation };
+					}
+				});
+				return faces;
+			}
+
+			template<typename IndexType>
+			[[nodiscard]] ILINE auto ComputeTangentSplit(TangentInput const& input, std::span<IndexType> indices, Jobs::Scheduler* pScheduler) -> TangentSplit {
+				auto const adjacency = ComputeVertexCorners(std::span<IndexType const>{ indices }, input.CountVertices);
+				auto const faces = ComputeFaceTangents(input, std::span<IndexType const>{ indices }, pScheduler);
+
+				// Group 0 takes the handedness of the vertex's first usable corner, group 1 the other one.
+				// Corners without a usable UV mapping join group 0.
+				auto const classify = [&](Math::Vec3 const& normal, U32 slot) -> I32 {
+					auto const& face = faces[adjacency.Corners[slot] / 3];
+					if (face.Tangent.x == 0.0f && face.Tangent.y == 0.0f && face.Tangent.z == 0.0f)
+						return 0;
+					return normal.x * face.Orientation.x + normal.y * face.Orientation.y + normal.z * face.Orientation.z < 0.0f ? -1 : 1;
+				};
+
+				auto bases = std::vector<U32>(input.CountVertices + 1, 0);
+				ParallelRange(pScheduler, static_cast<U32>(input.CountVertices), [&](U32 begin, U32 end) {
+					for (auto vertex = begin; vertex < end; vertex++) {
+						auto const normal = input.Normals[vertex];
+						auto first = 0;
+						auto countGroups = 1u;
+						for (auto slot = adjacency.Offsets[vertex]; slot < adjacency.Offsets[vertex + 1] && countGroups == 1; slot++) {
+							auto const sign = classify(normal, slot);
+							if (first == 0)
+								first = sign;
+							else if (sign != 0 && sign != first)
+								countGroups = 2;
+						}
+						bases[vertex + 1] = countGroups;
+					}
+				});
+				for (auto vertex = size_t{ 0 }; vertex < input.CountVertices; vertex++)
+					bases[vertex + 1] += bases[vertex];
+				if (bases.back() > static_cast<size_t>((std::numeric_limits<IndexType>::max)()) + 1)
+					throw std::out_of_range("Tangent split produces more vertices than the index type can address");
+
+				// Neighbouring corners are read through the indices, so they are only rewritten once every vertex is done
+				auto groupOf = std::vector<U8>(indices.size());
+				auto result = TangentSplit{};
+				result.Tangents.resize(bases.back());
+				result.Remap.resize(bases.back());
+				ParallelRange(pScheduler, static_cast<U32>(input.CountVertices), [&](U32 begin, U32 end) {
+					for (auto vertex = begin; vertex < end; vertex++) {
+						auto const normal = NormalizeOrZero(input.Normals[vertex]);
+						auto const position = input.Positions[vertex];
+
+						auto first = 0;
+						F32 sums[2][3] = {};
+						for (auto slot = adjacency.Offsets[vertex]; slot < adjacency.Offsets[vertex + 1]; slot++) {
+							auto const corner = adjacency.Corners[slot];
+							auto const sign = classify(normal, slot);
+							if (first == 0)
+								first = sign;
+							auto const group = sign != 0 && sign != first ? 1u : 0u;
+							groupOf[corner] = static_cast<U8>(group);
+							if (sign == 0)
+								continue;
+
+							// Project the face tangent and the two edges leaving this corner into the vertex's tangent plane
+							auto const face = corner / 3;
+							auto const& next = input.Positions[indices[3 * face + (corner + 1) % 3]];
+							auto const& prev = input.Positions[indices[3 * face + (corner + 2) % 3]];
+							auto const tangent = ProjectToPlane(normal, faces[face].Tangent);
+							auto const edgeNext = ProjectToPlane(normal, Math::Vec3{ next.x - position.x, next.y - position.y, next.z - position.z });
+							auto const edgePrev = ProjectToPlane(normal, Math::Vec3{ prev.x - position.x, prev.y - position.y, prev.z - position.z });
+							auto const angle = AcosApproximate(Math::Clamp(edgeNext.x * edgePrev.x + edgeNext.y * edgePrev.y + edgeNext.z * edgePrev.z, -1.0f, 1.0f));
+							sums[group][0] += angle * tangent.x;
+							sums[group][1] += angle * tangent.y;
+							sums[group][2] += angle * tangent.z;
+						}
+
+						for (auto group = 0u; group < bases[vertex + 1] - bases[vertex]; group++) {
+							auto tangent = NormalizeOrZero(Math::Vec3{ sums[group][0], sums[group][1], sums[group][2] });
+							if (Math::Dot(tangent, tangent) == 0.0f)
+								tangent = Orthogonal(normal);
+							auto const sign = group == 0 ? (first < 0 ? -1.0f : 1.0f) : (first < 0 ? 1.0f : -1.0f);
+							result.Tangents[bases[vertex] + group] = Math::Vec4{ tangent, sign };
+							result.Remap[bases[vertex] + group] = vertex;
+						}
+					}
+				});
+				ParallelRange(pScheduler, static_cast<U32>(input.CountVertices), [&](U32 begin, U32 end) {
+					for (auto vertex = begin; vertex < end; vertex++)
+						for (auto slot = adjacency.Offsets[vertex]; slot < adjacency.Offsets[vertex + 1]; slot++)
+							indices[adjacency.Corners[slot]] = static_cast<IndexType>(bases[vertex] + groupOf[adjacency.Corners[slot]]);
+				});
+				return result;
+			}
+
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+#include "../Common/Hash.hpp"
+#include "../Common/Jobs.hpp"
+#include "../Containers/FlatHashMap.hpp"
+#include "./Generator.hpp"
+#include "./Normals.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/Hash.hpp>
+//#include <Hawk/Common/Jobs.hpp>
+//#include <Hawk/Containers/FlatHashMap.hpp>
+//#include <Hawk/Geometry/Generator.hpp>
+//#include <Hawk/Geometry/Normals.hpp>
+
+namespace Hawk {
+	namespace Geometry {
+
+		// Cell size per attribute. Components are snapped to multiples of their tolerance and vertices whose
+		// snapped attributes all match are welded, so a seam stays open wherever any attribute differs by more
+		// than its cell. Two values just either side of a cell border stay apart; zero compares exact bits.
+		struct WeldTolerance {
+			F32 Position = 1.0e-5f;
+			F32 Normal   = 1.0e-3f;
+			F32 Tangent  = 1.0e-3f;
+			F32 Texcoord = 1.0e-5f;
+		};
+
+		// Remap[i] is the output vertex that source vertex i was welded into
+		struct WeldResult {
+			size_t           CountVerticesBefore;
+			size_t           CountVerticesAfter;
+			size_t           BytesSaved;
+			std::vector<U32> Remap;
+		};
+
+		// Keeps the first vertex of every distinct key in source order, compacts the span in place and rewrites
+		// the indices. Vertices past CountVerticesAfter are left in an unspecified state.
+		template<typename IndexType>
+		auto Weld(std::span<Vertex> vertices, std::span<IndexType> indices, WeldTolerance const& tolerance = {}, Jobs::Scheduler* pScheduler = nullptr) -> WeldResult;
+
+		template<typename IndexType>
+		auto Weld(Mesh<Vertex, IndexType>& mesh, WeldTolerance const& tolerance = {}, Jobs::Scheduler* pScheduler = nullptr) -> WeldResult;
+
+		namespace Detail {
+
+			constexpr U32 WeldPartitionBits = 8;
+			constexpr U32 WeldCountPartitions = 1u << WeldPartitionBits;
+			constexpr U32 WeldBlockSize = 1u << 16;
+
+			struct WeldKey {
+				U64 Hash;
+				U32 Cells[12];
+
+				auto operator==(WeldKey const& rhs) const noexcept -> bool = default;
+			};
+
+			struct WeldKeyHasher {
+				auto operator()(WeldKey const& key) const noexcept -> U64 { return key.Hash; }
+			};
+
+			// Reciprocal cell size of every snapped component, zero where the component is compared exactly
+			struct WeldScale {
+				F32 Values[12];
+			};
+
+			auto MakeWeldScale(WeldTolerance const& tolerance) noexcept -> WeldScale;
+			auto QuantizeWeld(F32 value, F32 scale) noexcept -> U32;
+			auto MakeWeldKey(Vertex const& vertex, WeldScale const& scale) noexcept -> WeldKey;
+			auto FindWeldRepresentatives(std::span<Vertex const> vertices, WeldScale const& scale, Jobs::Scheduler* pScheduler) -> std::vector<U32>;
+
+		}
+	}
+}
+
+namespace Hawk {
+	namespace Geometry {
+
+		template<typename IndexType>
+		[[nodiscard]] ILINE auto Weld(std::span<Vertex> vertices, std::span<IndexType> indices, WeldTolerance const& tolerance, Jobs::Scheduler* pScheduler) -> WeldResult {
+			if (vertices.size() >= (std::numeric_limits<U32>::max)() || indices.size() > (std::numeric_limits<U32>::max)())
+				throw std::length_error("Mesh is too large for 32-bit vertex ids");
+			for (auto const index : indices)
+				if (index >= vertices.size())
+					throw std::out_of_range("Index references a vertex past the end of the vertex buffer");
+
+			auto result = WeldResult{};
+			result.CountVerticesBefore = vertices.size();
+			result.Remap = Detail::FindWeldRepresentatives(vertices, Detail::MakeWeldScale(tolerance), pScheduler);
+
+			// Representatives always come first, so a single forward pass both numbers and compacts them
+			auto count = U32{ 0 };
+			for (auto index = U32{ 0 }; index < vertices.size(); index++) {
+				auto const representative = result.Remap[index];
+				if (representative == index) {
+					if (count != index)
+						vertices[count] = vertices[index];
+					result.Remap[index] = count++;
+				} else {
+					result.Remap[index] = result.Remap[representative];
+				}
+			}
+
+			Detail::ParallelRange(pScheduler, static_cast<U32>(indices.size()), [&](U32 begin, U32 end) {
+				for (auto index = begin; index < end; index++)
+					indices[index] = static_cast<IndexType>(result.Remap[indices[index]]);
+			});
+
+			result.CountVerticesAfter = count;
+			result.BytesSaved = (result.CountVerticesBefore - result.CountVerticesAfter) * sizeof(Vertex);
+			return result;
+		}
+
+		template<typename IndexType>
+		ILINE auto Weld(Mesh<Vertex, IndexType>& mesh, WeldTolerance const& tolerance, Jobs::Scheduler* pScheduler) -> WeldResult {
+			auto result = Weld(std::span<Vertex>{ mesh.Vertices }, std::span<IndexType>{ mesh.Indices }, tolerance, pScheduler);
+			mesh.Vertices.resize(result.CountVerticesAfter);
+			return result;
+		}
+
+		namespace Detail {
+
+			[[nodiscard]] ILINE auto MakeWeldScale(WeldTolerance const& tolerance) noexcept -> WeldScale {
+				auto const reciprocal = [](F32 cell) { return cell > 0.0f ? 1.0f / cell : 0.0f; };
+				auto const position = reciprocal(tolerance.Position);
+				auto const normal = reciprocal(tolerance.Normal);
+				auto const tangent = reciprocal(tolerance.Tangent);
+				auto const texcoord = reciprocal(tolerance.Texcoord);
+				return WeldScale{ { position, position, position, normal, normal, normal, tangent, tangent, tangent, tangent, texcoord, texcoord } };
+			}
+
+			// Snapped cells stay floats, so a huge coordinate can't overflow an integer cell id; adding zero folds -0 into +0
+			[[nodiscard]] ILINE auto QuantizeWeld(F32 value, F32 scale) noexcept -> U32 {
+				auto const cell = scale > 0.0f ? std::floor(value * scale + 0.5f) : value;
+				return std::bit_cast<U32>(cell + 0.0f);
+			}
+
+			[[nodiscard]] ILINE auto MakeWeldKey(Vertex const& vertex, WeldScale const& scale) noexcept -> WeldKey {
+				F32 const values[12] = {
+					vertex.Position.x, vertex.Position.y, vertex.Position.z,
+					vertex.Normal.x, vertex.Normal.y, vertex.Normal.z,
+					vertex.Tangent.x, vertex.Tangent.y, vertex.Tangent.z, vertex.Tangent.w,
+					vertex.Texcoord.x, vertex.Texcoord.y
+				};
+
+				auto key = WeldKey{};
+				for (auto index = 0u; index < 12; index++)
+					key.Cells[index] = QuantizeWeld(values[index], scale.Values[index]);
+				key.Hash = Hash::Bytes(key.Cells, sizeof(key.Cells));
+				return key;
+			}
+
+			// Hash-partitioned: vertices are bucketed by the top bits of their key hash with a stable counting sort,
+			// then every partition is welded on its own with a local map. Equal keys always share a partition and
+			// meet there in ascending order, so the first one seen is also the first in the mesh.
+			[[nodiscard]] ILINE auto FindWeldRepresentatives(std::span<Vertex const> vertices, WeldScale const& scale, Jobs::Scheduler* pScheduler) -> std::vector<U32> {
+				auto const countVertices = static_cast<U32>(vertices.size());
+
+				// Without spare workers one map walked in source order wins: it keeps the locality of the mesh,
+				// while partitions gather their vertices from all over it
+				if (pScheduler == nullptr || pScheduler->CountWorkers() < 2) {
+					auto representatives = std::vector<U32>(countVertices);
+					auto map = FlatHashMap<WeldKey, U32, WeldKeyHasher>{};
+					for (auto index = U32{ 0 }; index < countVertices; index++)
+						representatives[index] = *map.TryEmplace(MakeWeldKey(vertices[index], scale), index).first;
+					return representatives;
+				}
+
+				auto const countBlocks = (countVertices + WeldBlockSize - 1) / WeldBlockSize;
+				auto const partitionOf = [](U64 hash) { return static_cast<U32>(hash >> (64 - WeldPartitionBits)); };
+
+				auto hashes = std::vector<U64>(countVertices);
+				auto cursors = std::vector<U32>(static_cast<size_t>(countBlocks) * WeldCountPartitions);
+				ParallelRange(pScheduler, countBlocks, [&](U32 begin, U32 end) {
+					for (auto block = begin; block < end; block++) {
+						auto* counts = cursors.data() + static_cast<size_t>(block) * WeldCountPartitions;
+						for (auto index = block * WeldBlockSize; index < (std::min)(countVertices, (block + 1) * WeldBlockSize); index++) {
+							hashes[index] = MakeWeldKey(vertices[index], scale).Hash;
+							counts[partitionOf(hashes[index])]++;
+						}
+					}
+				});
+
+				// Partition-major prefix sum turns each block's counts into its write cursors
+				auto partitions = std::vector<U32>(WeldCountPartitions + 1);
+				auto total = U32{ 0 };
+				for (auto partition = 0u; partition < WeldCountPartitions; partition++) {
+					partitions[partition] = total;
+					for (auto block = 0u; block < countBlocks; block++) {
+						auto& cursor = cursors[static_cast<size_t>(block) * WeldCountPartitions + partition];
+						total += std::exchange(cursor, total);
+					}
+				}
+				partitions[WeldCountPartitions] = total;
+
+				auto order = std::vector<U32>(countVertices);
+				ParallelRange(pScheduler, countBlocks, [&](U32 begin, U32 end) {
+					for (auto block = begin; block < end; block++) {
+						auto* cursor = cursors.data() + static_cast<size_t>(block) * WeldCountPartitions;
+						for (auto index = block * WeldBlockSize; index < (std::min)(countVertices, (block + 1) * WeldBlockSize); index++)
+							order[cursor[partitionOf(hashes[index])]++] = index;
+					}
+				});
+
+				auto representatives = std::vector<U32>(countVertices);
+				ParallelRange(pScheduler, WeldCountPartitions, [&](U32 begin, U32 end) {
+					auto map = FlatHashMap<WeldKey, U32, WeldKeyHasher>{};
+					for (auto partition = begin; partition < end; partition++) {
+						map.Clear();
+						map.Reserve(partitions[partition + 1] - partitions[partition]);
+						for (auto position = partitions[partition]; position < partitions[partition + 1]; position++) {
+							auto const index = order[position];
+							representatives[index] = *map.TryEmplace(MakeWeldKey(vertices[index], scale), index).first;
+						}
+					}
+				});
+				return representatives;
+			}
+
+		}
+	}
+}
\ No newline at end of file
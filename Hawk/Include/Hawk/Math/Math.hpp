@@ -131,6 +131,7 @@ namespace Hawk {
 		template<typename T, U32 N> constexpr auto Atan(Vector<T, N> const& v) noexcept->Vector<T, N>;
 		template<typename T, U32 N> constexpr auto Sqrt(Vector<T, N> const& v) noexcept->Vector<T, N>;
 		template<typename T, U32 N> constexpr auto Lerp(Vector<T, N> const& v0, Vector<T, N> const& v1, Vector<T, N> const& t) noexcept->Vector<T, N>;
+		template<typename T, U32 N> constexpr auto Lerp(Vector<T, N> const& v0, Vector<T, N> const& v1, T t) noexcept->Vector<T, N>;
 
 
 		template<typename T, U32 N> constexpr auto Transpose(Matrix<T, N, N> const& m)                        noexcept->Matrix<T, N, N>;
@@ -145,6 +146,8 @@ namespace Hawk {
 		template<typename T> constexpr auto Normalize(Quaternion<T> const& lhs)                               noexcept->Quaternion<T>;
 		template<typename T> constexpr auto Conjugate(Quaternion<T> const& lhs)                               noexcept->Quaternion<T>;
 		template<typename T> constexpr auto Inverse(Quaternion<T> const& lhs)                                 noexcept->Quaternion<T>;
+		template<typename T> constexpr auto Nlerp(Quaternion<T> const& q0, Quaternion<T> const& q1, T t)      noexcept->Quaternion<T>;
+		template<typename T> constexpr auto Slerp(Quaternion<T> const& q0, Quaternion<T> const& q1, T t)      noexcept->Quaternion<T>;
 
 
 
@@ -165,7 +168,7 @@ namespace Hawk {
 
 		template<typename T>
 		[[nodiscard]] ILINE constexpr auto Degrees(T radians) noexcept -> T {
-			return  (T{ 180 } * radians) / PI;
+			return  (T{ 180 } * radians) / PI<T>;
 		}
 
 		template<typename T>
@@ -256,7 +259,7 @@ namespace Hawk {
 
 		template<typename T>
 		[[nodiscard]] ILINE constexpr auto CosinCurve(T t) noexcept -> T {
-			return T{0.5} * (T(1) - Math::Cos(t * PI));
+			return T{0.5} * (T(1) - Math::Cos(t * PI<T>));
 		}
 
 		template<typename T>
@@ -361,6 +364,14 @@ namespace Hawk {
 			return res;
 		}
 
+		template<typename T, U32 N>
+		[[nodiscard]] ILINE constexpr auto Lerp(Vector<T, N> const & v0, Vector<T, N> const & v1, T t) noexcept -> Vector<T, N> {
+			auto res = Vector<T, N>{};
+			for (auto index = 0u; index < N; index++)
+				res[index] = Math::Lerp(v0[index], v1[index], t);
+			return res;
+		}
+
 		template<typename T, U32 N>
 		[[nodiscard]] ILINE constexpr auto Dot(Vector<T, N> const& lhs, Vector<T, N> const& rhs) noexcept -> T {
 			auto result = T{ 0 };
@@ -450,6 +461,32 @@ namespace Hawk {
 			return Math::Conjugate(lhs) / Math::Dot(lhs, lhs);
 		}
 
+		template<typename T>
+		[[nodiscard]] ILINE constexpr auto Nlerp(Quaternion<T> const & q0, Quaternion<T> const & q1, T t) noexcept -> Quaternion<T> {
+			auto const sign = Math::Dot(q0, q1) < T{ 0 } ? T{ -1 } : T{ 1 };
+			return Math::Normalize((T{ 1 } - t) * q0 + (sign * t) * q1);
+		}
+
+		template<typename T>
+		[[nodiscard]] ILINE constexpr auto Slerp(Quaternion<T> const & q0, Quaternion<T> const & q1, T t) noexcept -> Quaternion<T> {
+			auto cosTheta = Math::Dot(q0, q1);
+			auto target = q1;
+			if (cosTheta < T{ 0 }) {
+				cosTheta = -cosTheta;
+				target = -q1;
+			}
+
+			// Nearly parallel rotations: sin(theta) vanishes, Nlerp is exact enough
+			if (cosTheta > T{ 1 } - T{ 16 } * std::numeric_limits<T>::epsilon())
+				return Math::Nlerp(q0, target, t);
+
+			auto const theta    = Math::Acos(cosTheta);
+			auto const invSin   = T{ 1 } / Math::Sin(theta);
+			auto const weight0  = Math::Sin((T{ 1 } - t) * theta) * invSin;
+			auto const weight1  = Math::Sin(t * theta) * invSin;
+			return weight0 * q0 + weight1 * target;
+		}
+
 
 	}
 }
@@ -0,0 +1,483 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+#include "../Common/MPMCQueue.hpp"
+#include "../Common/NonCopyable.hpp"
+#include "./Utility.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/MPMCQueue.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+//#include <Hawk/Memory/Utility.hpp>
+
+namespace Hawk {
+	namespace Memory {
+
+		class BlockAllocator;
+
+		struct BlockAllocatorStats {
+			size_t CountAllocations;
+			size_t BytesRequested;
+			size_t BytesUsed;
+			size_t BytesReserved;
+
+			auto InternalFragmentation() const noexcept -> F32;
+			auto ExternalFragmentation() const noexcept -> F32;
+		};
+
+		namespace Detail {
+
+			struct Magazine {
+				static constexpr U32 Capacity = 64;
+
+				U32       Count = 0;
+				Magazine* Next = nullptr;
+				void*     Blocks[Capacity];
+			};
+
+			struct alignas(HAWK_CACHE_LINE_SIZE) BlockThreadCache {
+				static constexpr U32 CountClasses = 8;
+
+				Magazine*        Loaded[CountClasses] = {};
+				Magazine*        Previous[CountClasses] = {};
+				std::atomic<I64> CountAllocations{ 0 };
+				std::atomic<I64> BytesRequested{ 0 };
+				std::atomic<I64> BytesUsed{ 0 };
+				bool             IsInitialized = false;
+			};
+
+			constexpr U32 BlockMaxThreads    = 128;
+			constexpr U32 BlockInvalidThread = ~0u;
+
+			// Live allocators and the free thread ids, shared by all allocators of the process
+			struct BlockThreadRegistry {
+				std::mutex                   Mutex;
+				std::vector<BlockAllocator*> Allocators;
+				std::vector<U32>             FreeIndices;
+				U32                          CountIndices = 0;
+			};
+
+			// A thread leases its cache id on first use. On exit it hands its magazines in every live allocator
+			// back to the depot and returns the id, so ids only run out with more than BlockMaxThreads live threads.
+			struct BlockThreadLease {
+				BlockThreadLease();
+				~BlockThreadLease();
+
+				U32 Index;
+			};
+
+			auto BlockThreads() -> BlockThreadRegistry&;
+
+			inline thread_local BlockThreadLease t_BlockThreadLease;
+
+			class BlockAllocatorResource : public std::pmr::memory_resource {
+			public:
+				BlockAllocatorResource(BlockAllocator& allocator) noexcept : m_Allocator(allocator) {}
+			private:
+				auto do_allocate(size_t size, size_t alignment) -> void* override;
+				auto do_deallocate(void* pointer, size_t size, size_t alignment) noexcept -> void override;
+				auto do_is_equal(std::pmr::memory_resource const& rhs) const noexcept -> bool override { return this == &rhs; }
+
+				BlockAllocator& m_Allocator;
+			};
+
+		}
+
+		// Size-class allocator for blocks of 16 to 2048 bytes. Each thread allocates from and frees into its own
+		// pair of magazines; only when both run empty or full does it trade a whole magazine with the global
+		// depot, which is a lock-free MPMC queue. Fresh chunks are carved under a mutex, which is rare.
+		// Threads beyond MaxThreads alive at once, and threads that free before they ever allocated, share one
+		// extra cache under a mutex. Freeing never allocates. Larger requests go straight to the aligned
+		// global heap.
+		class BlockAllocator : NonCopyable {
+		public:
+			static constexpr U32    CountClasses = Detail::BlockThreadCache::CountClasses;
+			static constexpr size_t MinBlockSize = 16;
+			static constexpr size_t MaxBlockSize = MinBlockSize << (CountClasses - 1);
+			static constexpr U32    MaxThreads   = Detail::BlockMaxThreads;
+
+			BlockAllocator(size_t chunkSize = 256 * 1024, U32 depotCapacity = 1024);
+			~BlockAllocator();
+
+			auto Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) -> void*;
+			auto Free(void* pointer, size_t size, size_t alignment = alignof(std::max_align_t)) noexcept -> void;
+
+			auto Resource() noexcept -> std::pmr::memory_resource&;
+			auto Stats() const noexcept -> BlockAllocatorStats;
+
+			static constexpr auto SizeClass(size_t size) noexcept -> U32;
+			static constexpr auto BlockSize(U32 sizeClass) noexcept -> size_t;
+
+		private:
+			struct Depot {
+				Depot(U32 capacity) : Full(capacity), Empty(capacity) {}
+
+				MPMCQueue<Detail::Magazine*> Full;
+				MPMCQueue<Detail::Magazine*> Empty;
+			};
+
+			friend struct Detail::BlockThreadLease;
+
+			auto Cache(U32 index) -> Detail::BlockThreadCache&;
+			auto AllocateBlock(U32 sizeClass, size_t size, Detail::BlockThreadCache& cache) -> void*;
+			auto FreeBlock(U32 sizeClass, void* pointer, size_t size, Detail::BlockThreadCache& cache) noexcept -> void;
+			auto ReleaseCache(U32 index) -> void;
+			auto RefillMagazine(U32 sizeClass, Detail::BlockThreadCache& cache) -> Detail::Magazine*;
+			auto FlushMagazine(U32 sizeClass, Detail::BlockThreadCache& cache) noexcept -> Detail::Magazine*;
+			auto PushOverflow(U32 sizeClass, Detail::Magazine* magazine) noexcept -> void;
+			auto Carve(U32 sizeClass, Detail::Magazine& magazine) -> void;
+			auto Track(Detail::BlockThreadCache& cache, I64 count, I64 requested, I64 used) noexcept -> void;
+
+			// MaxThreads leased caches, then the shared one guarded by m_SharedMutex
+			std::unique_ptr<Detail::BlockThreadCache[]> m_Caches;
+			std::vector<std::unique_ptr<Depot>>         m_Depots;
+			std::mutex                                  m_SharedMutex;
+			std::mutex                                  m_Mutex;
+			std::vector<AlignedBuffer>                  m_Chunks;
+			Detail::Magazine*                           m_Overflow[CountClasses];
+			void*                                       m_Loose[CountClasses];
+			U8*                                         m_ChunkCurrent[CountClasses];
+			size_t                                      m_ChunkOffset[CountClasses];
+			size_t                                      m_ChunkSize;
+			std::atomic<size_t>                         m_BytesReserved;
+			std::atomic<I64>                            m_BytesLarge;
+			Detail::BlockAllocatorResource              m_Resource;
+		};
+
+	}
+}
+
+namespace Hawk {
+	namespace Memory {
+
+		[[nodiscard]] ILINE auto BlockAllocatorStats::InternalFragmentation() const noexcept -> F32 {
+			return BytesUsed > 0 ? 1.0f - static_cast<F32>(BytesRequested) / static_cast<F32>(BytesUsed) : 0.0f;
+		}
+
+		[[nodiscard]] ILINE auto BlockAllocatorStats::ExternalFragmentation() const noexcept -> F32 {
+			return BytesReserved > 0 ? 1.0f - static_cast<F32>(BytesUsed) / static_cast<F32>(BytesReserved) : 0.0f;
+		}
+
+		namespace Detail {
+
+			ILINE auto BlockAllocatorResource::do_allocate(size_t size, size_t alignment) -> void* {
+				return m_Allocator.Allocate(size, alignment);
+			}
+
+			ILINE auto BlockAllocatorResource::do_deallocate(void* pointer, size_t size, size_t alignment) noexcept -> void {
+				m_Allocator.Free(pointer, size, alignment);
+			}
+
+			// Never destroyed: detached threads may still exit after static destructors ran
+			[[nodiscard]] ILINE auto BlockThreads() -> BlockThreadRegistry& {
+				static auto* registry = new BlockThreadRegistry{};
+				return *registry;
+			}
+
+			ILINE BlockThreadLease::BlockThreadLease() : Index(BlockInvalidThread) {
+				auto& registry = BlockThreads();
+				std::lock_guard<std::mutex> lock(registry.Mutex);
+				if (!registry.FreeIndices.empty()) {
+					Index = registry.FreeIndices.back();
+					registry.FreeIndices.pop_back();
+				} else if (registry.CountIndices < BlockMaxThreads) {
+					Index = registry.CountIndices++;
+				}
+			}
+
+			ILINE BlockThreadLease::~BlockThreadLease() {
+				if (Index == BlockInvalidThread)
+					return;
+
+				auto& registry = BlockThreads();
+				std::lock_guard<std::mutex> lock(registry.Mutex);
+				for (auto* allocator : registry.Allocators)
+					allocator->ReleaseCache(Index);
+				registry.FreeIndices.push_back(Index);
+			}
+
+		}
+
+		ILINE BlockAllocator::BlockAllocator(size_t chunkSize, U32 depotCapacity)
+			: m_Caches(std::make_unique<Detail::BlockThreadCache[]>(MaxThreads + 1))
+			, m_Overflow{}
+			, m_Loose{}
+			, m_ChunkCurrent{}
+			, m_ChunkOffset{}
+			, m_ChunkSize(AlignUp(chunkSize, MaxBlockSize))
+			, m_BytesReserved(0)
+			, m_BytesLarge(0)
+			, m_Resource(*this) {
+			m_Depots.reserve(CountClasses);
+			for (auto index = 0u; index < CountClasses; index++) {
+				m_Depots.push_back(std::make_unique<Depot>(depotCapacity));
+				m_ChunkOffset[index] = m_ChunkSize;
+			}
+			this->Cache(MaxThreads);
+
+			auto& registry = Detail::BlockThreads();
+			std::lock_guard<std::mutex> lock(registry.Mutex);
+			registry.Allocators.push_back(this);
+		}
+
+		ILINE BlockAllocator::~BlockAllocator() {
+			{
+				auto& registry = Detail::BlockThreads();
+				std::lock_guard<std::mutex> lock(registry.Mutex);
+				std::erase(registry.Allocators, this);
+			}
+
+			for (auto index = 0u; index < MaxThreads + 1; index++) {
+				for (auto sizeClass = 0u; sizeClass < CountClasses; sizeClass++) {
+					delete m_Caches[index].Loaded[sizeClass];
+					delete m_Caches[index].Previous[sizeClass];
+				}
+			}
+
+			for (auto sizeClass = 0u; sizeClass < CountClasses; sizeClass++) {
+				auto* magazine = static_cast<Detail::Magazine*>(nullptr);
+				while (m_Depots[sizeClass]->Full.TryPop(magazine))
+					delete magazine;
+				while (m_Depots[sizeClass]->Empty.TryPop(magazine))
+					delete magazine;
+				while (auto* overflow = m_Overflow[sizeClass]) {
+					m_Overflow[sizeClass] = overflow->Next;
+					delete overflow;
+				}
+			}
+		}
+
+		[[nodiscard]] ILINE auto BlockAllocator::Allocate(size_t size, size_t alignment) -> void* {
+			assert(IsPowerOfTwo(alignment) && alignment <= HAWK_CACHE_LINE_SIZE);
+
+			// Blocks are naturally aligned to their size up to a cache line, so alignment only bumps the class
+			auto const effectiveSize = (std::max)(size, alignment);
+			if (effectiveSize > MaxBlockSize) {
+				m_BytesLarge.fetch_add(static_cast<I64>(size), std::memory_order_relaxed);
+				return ::operator new(size, std::align_val_t{ alignment });
+			}
+
+			auto const sizeClass = SizeClass(effectiveSize);
+			auto const index = Detail::t_BlockThreadLease.Index;
+			if (index != Detail::BlockInvalidThread)
+				return this->AllocateBlock(sizeClass, size, this->Cache(index));
+
+			std::lock_guard<std::mutex> lock(m_SharedMutex);
+			return this->AllocateBlock(sizeClass, size, this->Cache(MaxThreads));
+		}
+
+		ILINE auto BlockAllocator::Free(void* pointer, size_t size, size_t alignment) noexcept -> void {
+			if (pointer == nullptr)
+				return;
+
+			auto const effectiveSize = (std::max)(size, alignment);
+			if (effectiveSize > MaxBlockSize) {
+				m_BytesLarge.fetch_sub(static_cast<I64>(size), std::memory_order_relaxed);
+				::operator delete(pointer, std::align_val_t{ alignment });
+				return;
+			}
+
+			// Setting up a cache allocates, so a thread that never allocated here frees into the shared one
+			auto const sizeClass = SizeClass(effectiveSize);
+			auto const index = Detail::t_BlockThreadLease.Index;
+			if (index != Detail::BlockInvalidThread && m_Caches[index].IsInitialized)
+				return this->FreeBlock(sizeClass, pointer, size, m_Caches[index]);
+
+			std::lock_guard<std::mutex> lock(m_SharedMutex);
+			this->FreeBlock(sizeClass, pointer, size, m_Caches[MaxThreads]);
+		}
+
+		[[nodiscard]] ILINE auto BlockAllocator::Resource() noexcept -> std::pmr::memory_resource& {
+			return m_Resource;
+		}
+
+		[[nodiscard]] ILINE auto BlockAllocator::Stats() const noexcept -> BlockAllocatorStats {
+			auto count = I64{ 0 };
+			auto requested = I64{ 0 };
+			auto used = I64{ 0 };
+			for (auto index = 0u; index < MaxThreads + 1; index++) {
+				count     += m_Caches[index].CountAllocations.load(std::memory_order_relaxed);
+				requested += m_Caches[index].BytesRequested.load(std::memory_order_relaxed);
+				used      += m_Caches[index].BytesUsed.load(std::memory_order_relaxed);
+			}
+
+			auto const large = m_BytesLarge.load(std::memory_order_relaxed);
+			return BlockAllocatorStats{
+				static_cast<size_t>(count),
+				static_cast<size_t>(requested + large),
+				static_cast<size_t>(used + large),
+				m_BytesReserved.load(std::memory_order_relaxed) + static_cast<size_t>(large)
+			};
+		}
+
+		[[nodiscard]] ILINE constexpr auto BlockAllocator::SizeClass(size_t size) noexcept -> U32 {
+			auto sizeClass = 0u;
+			while ((MinBlockSize << sizeClass) < size)
+				sizeClass++;
+			return sizeClass;
+		}
+
+		[[nodiscard]] ILINE constexpr auto BlockAllocator::BlockSize(U32 sizeClass) noexcept -> size_t {
+			return MinBlockSize << sizeClass;
+		}
+
+		ILINE auto BlockAllocator::Cache(U32 index) -> Detail::BlockThreadCache& {
+			auto& cache = m_Caches[index];
+			if (!cache.IsInitialized) {
+				for (auto sizeClass = 0u; sizeClass < CountClasses; sizeClass++) {
+					cache.Loaded[sizeClass] = new Detail::Magazine{};
+					cache.Previous[sizeClass] = new Detail::Magazine{};
+				}
+				cache.IsInitialized = true;
+			}
+			return cache;
+		}
+
+		[[nodiscard]] ILINE auto BlockAllocator::AllocateBlock(U32 sizeClass, size_t size, Detail::BlockThreadCache& cache) -> void* {
+			auto* magazine = cache.Loaded[sizeClass];
+			if (magazine->Count == 0)
+				magazine = this->RefillMagazine(sizeClass, cache);
+
+			auto* pointer = magazine->Blocks[--magazine->Count];
+			this->Track(cache, 1, static_cast<I64>(size), static_cast<I64>(BlockSize(sizeClass)));
+			Poison(pointer, BlockSize(sizeClass), PoisonAllocated);
+			return pointer;
+		}
+
+		ILINE auto BlockAllocator::FreeBlock(U32 sizeClass, void* pointer, size_t size, Detail::BlockThreadCache& cache) noexcept -> void {
+			auto* magazine = cache.Loaded[sizeClass];
+			if (magazine->Count == Detail::Magazine::Capacity)
+				magazine = this->FlushMagazine(sizeClass, cache);
+
+			Poison(pointer, BlockSize(sizeClass), PoisonReleased);
+			if (magazine != nullptr) {
+				magazine->Blocks[magazine->Count++] = pointer;
+			} else {
+				// Blocks are at least 16 bytes, so the loose list links through them
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				*static_cast<void**>(pointer) = m_Loose[sizeClass];
+				m_Loose[sizeClass] = pointer;
+			}
+			this->Track(cache, -1, -static_cast<I64>(size), -static_cast<I64>(BlockSize(sizeClass)));
+		}
+
+		// The owning thread exited: partly filled magazines join the full ones in the depot, so other threads
+		// reuse the blocks. Statistics stay with the cache and carry over to the next lease of its id.
+		ILINE auto BlockAllocator::ReleaseCache(U32 index) -> void {
+			auto& cache = m_Caches[index];
+			if (!cache.IsInitialized)
+				return;
+
+			for (auto sizeClass = 0u; sizeClass < CountClasses; sizeClass++) {
+				auto& depot = *m_Depots[sizeClass];
+				for (auto* magazine : { cache.Loaded[sizeClass], cache.Previous[sizeClass] }) {
+					if (magazine->Count == 0) {
+						if (!depot.Empty.TryPush(magazine))
+							delete magazine;
+					} else if (!depot.Full.TryPush(magazine)) {
+						this->PushOverflow(sizeClass, magazine);
+					}
+				}
+				cache.Loaded[sizeClass] = nullptr;
+				cache.Previous[sizeClass] = nullptr;
+			}
+			cache.IsInitialized = false;
+		}
+
+		// Both magazines are empty: trade one for a full magazine from the depot, or carve new blocks into it.
+		// Carving also puts a spare empty magazine into the depot, so threads freeing these blocks can hand
+		// their full magazines on without allocating.
+		ILINE auto BlockAllocator::RefillMagazine(U32 sizeClass, Detail::BlockThreadCache& cache) -> Detail::Magazine* {
+			std::swap(cache.Loaded[sizeClass], cache.Previous[sizeClass]);
+			auto* magazine = cache.Loaded[sizeClass];
+			if (magazine->Count > 0)
+				return magazine;
+
+			auto& depot = *m_Depots[sizeClass];
+			auto* full = static_cast<Detail::Magazine*>(nullptr);
+			if (!depot.Full.TryPop(full)) {
+				std::lock_guard<std::mutex> lock(m_Mutex);
+				if (m_Overflow[sizeClass] != nullptr) {
+					full = m_Overflow[sizeClass];
+					m_Overflow[sizeClass] = full->Next;
+				}
+			}
+
+			if (full == nullptr) {
+				auto spare = std::make_unique<Detail::Magazine>();
+				if (depot.Empty.TryPush(spare.get()))
+					spare.release();
+				this->Carve(sizeClass, *magazine);
+				return magazine;
+			}
+
+			if (!depot.Empty.TryPush(magazine))
+				delete magazine;
+			cache.Loaded[sizeClass] = full;
+			return full;
+		}
+
+		// Both magazines are full: trade one for an empty magazine from the depot. Without a spare both stay
+		// full and the caller leaves the block loose for the next carve.
+		ILINE auto BlockAllocator::FlushMagazine(U32 sizeClass, Detail::BlockThreadCache& cache) noexcept -> Detail::Magazine* {
+			std::swap(cache.Loaded[sizeClass], cache.Previous[sizeClass]);
+			auto* magazine = cache.Loaded[sizeClass];
+			if (magazine->Count < Detail::Magazine::Capacity)
+				return magazine;
+
+			auto& depot = *m_Depots[sizeClass];
+			auto* empty = static_cast<Detail::Magazine*>(nullptr);
+			if (!depot.Empty.TryPop(empty))
+				return nullptr;
+
+			if (!depot.Full.TryPush(magazine))
+				this->PushOverflow(sizeClass, magazine);
+			cache.Loaded[sizeClass] = empty;
+			return empty;
+		}
+
+		ILINE auto BlockAllocator::PushOverflow(U32 sizeClass, Detail::Magazine* magazine) noexcept -> void {
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			magazine->Next = m_Overflow[sizeClass];
+			m_Overflow[sizeClass] = magazine;
+		}
+
+		// Loose blocks go first, then the current chunk
+		ILINE auto BlockAllocator::Carve(U32 sizeClass, Detail::Magazine& magazine) -> void {
+			std::lock_guard<std::mutex> lock(m_Mutex);
+			while (magazine.Count < Detail::Magazine::Capacity && m_Loose[sizeClass] != nullptr) {
+				auto* block = m_Loose[sizeClass];
+				m_Loose[sizeClass] = *static_cast<void**>(block);
+				magazine.Blocks[magazine.Count++] = block;
+			}
+
+			auto const blockSize = BlockSize(sizeClass);
+			while (magazine.Count < Detail::Magazine::Capacity) {
+				if (m_ChunkOffset[sizeClass] + blockSize > m_ChunkSize) {
+					m_Chunks.push_back(AllocateAligned(m_ChunkSize, HAWK_CACHE_LINE_SIZE));
+					m_BytesReserved.fetch_add(m_ChunkSize, std::memory_order_relaxed);
+					m_ChunkCurrent[sizeClass] = m_Chunks.back().get();
+					m_ChunkOffset[sizeClass] = 0;
+				}
+
+				magazine.Blocks[magazine.Count++] = m_ChunkCurrent[sizeClass] + m_ChunkOffset[sizeClass];
+				m_ChunkOffset[sizeClass] += blockSize;
+			}
+		}
+
+		ILINE auto BlockAllocator::Track(Detail::BlockThreadCache& cache, I64 count, I64 requested, I64 used) noexcept -> void {
+			cache.CountAllocations.store(cache.CountAllocations.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+			cache.BytesRequested.store(cache.BytesRequested.load(std::memory_order_relaxed) + requested, std::memory_order_relaxed);
+			cache.BytesUsed.store(cache.BytesUsed.load(std::memory_order_relaxed) + used, std::memory_order_relaxed);
+		}
+
+	}
+}
\ No newline at end of file
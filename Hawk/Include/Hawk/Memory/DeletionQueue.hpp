@@ -0,0 +1,173 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+#include "../Common/NonCopyable.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+
+namespace Hawk {
+	namespace Memory {
+
+		// Defers releasing objects the GPU may still read until a fence passes the value that was signalled after
+		// their last use. The queue only compares numbers, so it works with ID3D12Fence::GetCompletedValue,
+		// a Vulkan timeline semaphore or Hawk::Fence alike; use one queue per fence timeline.
+		// Retires with the same or an older fence value join the newest batch, which keeps a release from ever
+		// running early. Retire may be called from any thread; Collect runs the releases on the caller's thread.
+		class DeletionQueue : NonCopyable {
+		public:
+			DeletionQueue() = default;
+			~DeletionQueue();
+
+			template<typename T>
+			auto Retire(U64 fenceValue, T&& object) -> void;
+			template<typename F>
+			auto Enqueue(U64 fenceValue, F&& function) -> void;
+
+			auto Collect(U64 completedValue) -> size_t;
+			auto Flush() -> size_t;
+
+			auto Size()    const noexcept -> size_t;
+			auto IsEmpty() const noexcept -> bool { return this->Size() == 0; }
+
+		private:
+			struct Entry {
+				void* Object;
+				void (*Release)(void* object) noexcept;
+			};
+
+			struct Batch {
+				U64                FenceValue;
+				std::vector<Entry> Entries;
+			};
+
+			auto Push(U64 fenceValue, Entry entry) -> void;
+			auto Run(std::vector<Batch>& batches) -> size_t;
+
+			mutable std::mutex              m_Mutex;
+			std::deque<Batch>               m_Batches;
+			std::vector<std::vector<Entry>> m_FreeEntries;
+			size_t                          m_Count = 0;
+		};
+
+		namespace Detail {
+
+			template<typename T, typename = void>
+			struct IsReleasable : std::false_type {};
+
+			template<typename T>
+			struct IsReleasable<T, std::void_t<decltype(std::declval<T&>().Release())>> : std::true_type {};
+
+			template<typename T, typename = void>
+			struct IsDetachable : std::false_type {};
+
+			template<typename T>
+			struct IsDetachable<T, std::void_t<decltype(std::declval<T&>().Detach())>>
+				: IsReleasable<std::remove_pointer_t<decltype(std::declval<T&>().Detach())>> {};
+
+		}
+
+	}
+}
+
+namespace Hawk {
+	namespace Memory {
+
+		ILINE DeletionQueue::~DeletionQueue() {
+			this->Flush();
+		}
+
+		// Raw pointers to reference-counted objects and smart pointers that can detach one (ComPtr, RefPtr) give up
+		// a single reference without allocating; anything else is moved into a heap box and destroyed later
+		template<typename T>
+		ILINE auto DeletionQueue::Retire(U64 fenceValue, T&& object) -> void {
+			using Type = std::decay_t<T>;
+			if constexpr (std::is_pointer_v<Type> && Detail::IsReleasable<std::remove_pointer_t<Type>>::value) {
+				using Pointee = std::remove_pointer_t<Type>;
+				if (object != nullptr)
+					this->Push(fenceValue, Entry{ const_cast<void*>(static_cast<void const*>(object)), [](void* pointer) noexcept { static_cast<Pointee*>(pointer)->Release(); } });
+			} else if constexpr (Detail::IsDetachable<Type>::value && std::is_rvalue_reference_v<T&&>) {
+				this->Retire(fenceValue, object.Detach());
+			} else {
+				this->Push(fenceValue, Entry{ new Type(std::forward<T>(object)), [](void* pointer) noexcept { delete static_cast<Type*>(pointer); } });
+			}
+		}
+
+		template<typename F>
+		ILINE auto DeletionQueue::Enqueue(U64 fenceValue, F&& function) -> void {
+			using Function = std::decay_t<F>;
+			this->Push(fenceValue, Entry{ new Function(std::forward<F>(function)), [](void* pointer) noexcept {
+				auto* function = static_cast<Function*>(pointer);
+				(*function)();
+				delete function;
+			} });
+		}
+
+		// Releases every batch whose fence value has been reached and returns how many objects went away
+		ILINE auto DeletionQueue::Collect(U64 completedValue) -> size_t {
+			auto ready = std::vector<Batch>{};
+			{
+				std::lock_guard<std::mutex> lock{ m_Mutex };
+				while (!m_Batches.empty() && m_Batches.front().FenceValue <= completedValue) {
+					ready.push_back(std::move(m_Batches.front()));
+					m_Batches.pop_front();
+				}
+			}
+			return this->Run(ready);
+		}
+
+		// Releases everything regardless of fence values; the caller must know the GPU is idle
+		ILINE auto DeletionQueue::Flush() -> size_t {
+			auto ready = std::vector<Batch>{};
+			{
+				std::lock_guard<std::mutex> lock{ m_Mutex };
+				ready.assign(std::make_move_iterator(m_Batches.begin()), std::make_move_iterator(m_Batches.end()));
+				m_Batches.clear();
+			}
+			return this->Run(ready);
+		}
+
+		[[nodiscard]] ILINE auto DeletionQueue::Size() const noexcept -> size_t {
+			std::lock_guard<std::mutex> lock{ m_Mutex };
+			return m_Count;
+		}
+
+		ILINE auto DeletionQueue::Push(U64 fenceValue, Entry entry) -> void {
+			std::lock_guard<std::mutex> lock{ m_Mutex };
+			if (m_Batches.empty() || m_Batches.back().FenceValue < fenceValue) {
+				auto entries = std::vector<Entry>{};
+				if (!m_FreeEntries.empty()) {
+					entries = std::move(m_FreeEntries.back());
+					m_FreeEntries.pop_back();
+				}
+				m_Batches.push_back(Batch{ fenceValue, std::move(entries) });
+			}
+			m_Batches.back().Entries.push_back(entry);
+			m_Count++;
+		}
+
+		// Releases run outside the lock, so a destructor may retire further objects into this queue
+		ILINE auto DeletionQueue::Run(std::vector<Batch>& batches) -> size_t {
+			auto count = size_t{ 0 };
+			for (auto& batch : batches) {
+				for (auto const& entry : batch.Entries)
+					entry.Release(entry.Object);
+				count += batch.Entries.size();
+				batch.Entries.clear();
+			}
+
+			std::lock_guard<std::mutex> lock{ m_Mutex };
+			m_Count -= count;
+			for (auto& batch : batches)
+				m_FreeEntries.push_back(std::move(batch.Entries));
+			return count;
+		}
+
+	}
+}
\ No newline at end of file
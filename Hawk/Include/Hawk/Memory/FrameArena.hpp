@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <memory_resource>
+#include <new>
+
+#include "../Common/Defines.hpp"
+#include "../Common/NonCopyable.hpp"
+#include "./Utility.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+//#include <Hawk/Memory/Utility.hpp>
+
+namespace Hawk {
+	namespace Memory {
+
+		class FrameArena;
+
+		namespace Detail {
+
+			class FrameArenaResource : public std::pmr::memory_resource {
+			public:
+				FrameArenaResource(FrameArena& arena) noexcept : m_Arena(arena) {}
+			private:
+				auto do_allocate(size_t size, size_t alignment) -> void* override;
+				auto do_deallocate(void*, size_t, size_t) noexcept -> void override {}
+				auto do_is_equal(std::pmr::memory_resource const& rhs) const noexcept -> bool override { return this == &rhs; }
+
+				FrameArena& m_Arena;
+			};
+
+		}
+
+		// Linear allocator split into one region per frame in flight. BeginFrame recycles the oldest region,
+		// so anything allocated during frame N stays valid until frame N + countFrames begins.
+		// Allocation is a lock-free bump and may be called from jobs; BeginFrame must not race with it.
+		class FrameArena : NonCopyable {
+		public:
+			FrameArena(size_t capacityPerFrame, U32 countFrames = 2);
+
+			auto BeginFrame() noexcept -> void;
+			auto Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept -> void*;
+			template<typename T> auto Allocate(size_t count) noexcept -> T*;
+
+			auto Resource() noexcept -> std::pmr::memory_resource&;
+
+			auto Used()       const noexcept -> size_t;
+			auto Peak()       const noexcept -> size_t;
+			auto Capacity()   const noexcept -> size_t;
+			auto FrameIndex() const noexcept -> U32;
+
+		private:
+			AlignedBuffer                 m_Memory;
+			size_t                        m_Capacity;
+			U32                           m_CountFrames;
+			U32                           m_FrameIndex;
+			alignas(HAWK_CACHE_LINE_SIZE) std::atomic<size_t> m_Offset;
+			size_t                        m_Peak;
+			Detail::FrameArenaResource    m_Resource;
+		};
+
+	}
+}
+
+namespace Hawk {
+	namespace Memory {
+
+		namespace Detail {
+
+			ILINE auto FrameArenaResource::do_allocate(size_t size, size_t alignment) -> void* {
+				if (auto* pointer = m_Arena.Allocate(size, alignment))
+					return pointer;
+				throw std::bad_alloc{};
+			}
+
+		}
+
+		ILINE FrameArena::FrameArena(size_t capacityPerFrame, U32 countFrames)
+			: m_Memory(AllocateAligned(AlignUp(capacityPerFrame, HAWK_CACHE_LINE_SIZE) * countFrames))
+			, m_Capacity(AlignUp(capacityPerFrame, HAWK_CACHE_LINE_SIZE))
+			, m_CountFrames(countFrames)
+			, m_FrameIndex(0)
+			, m_Offset(0)
+			, m_Peak(0)
+			, m_Resource(*this) {
+			assert(countFrames > 0);
+			Poison(m_Memory.get(), m_Capacity * m_CountFrames, PoisonReleased);
+		}
+
+		ILINE auto FrameArena::BeginFrame() noexcept -> void {
+			auto const used = m_Offset.load(std::memory_order_relaxed);
+			m_Peak = (std::max)(m_Peak, used);
+
+			m_FrameIndex = (m_FrameIndex + 1) % m_CountFrames;
+			m_Offset.store(0, std::memory_order_relaxed);
+			Poison(m_Memory.get() + m_FrameIndex * m_Capacity, m_Capacity, PoisonReleased);
+		}
+
+		[[nodiscard]] ILINE auto FrameArena::Allocate(size_t size, size_t alignment) noexcept -> void* {
+			assert(IsPowerOfTwo(alignment) && alignment <= HAWK_CACHE_LINE_SIZE);
+
+			auto offset = m_Offset.load(std::memory_order_relaxed);
+			auto begin = size_t{ 0 };
+			do {
+				begin = AlignUp(offset, alignment);
+				if (begin + size > m_Capacity) {
+					assert(false && "FrameArena is out of memory for this frame");
+					return nullptr;
+				}
+			} while (!m_Offset.compare_exchange_weak(offset, begin + size, std::memory_order_relaxed));
+
+			auto* pointer = m_Memory.get() + m_FrameIndex * m_Capacity + begin;
+			Poison(pointer, size, PoisonAllocated);
+			return pointer;
+		}
+
+		template<typename T>
+		[[nodiscard]] ILINE auto FrameArena::Allocate(size_t count) noexcept -> T* {
+			return static_cast<T*>(this->Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		[[nodiscard]] ILINE auto FrameArena::Resource() noexcept -> std::pmr::memory_resource& {
+			return m_Resource;
+		}
+
+		[[nodiscard]] ILINE auto FrameArena::Used() const noexcept -> size_t {
+			return m_Offset.load(std::memory_order_relaxed);
+		}
+
+		[[nodiscard]] ILINE auto FrameArena::Peak() const noexcept -> size_t {
+			return (std::max)(m_Peak, this->Used());
+		}
+
+		[[nodiscard]] ILINE auto FrameArena::Capacity() const noexcept -> size_t {
+			return m_Capacity;
+		}
+
+		[[nodiscard]] ILINE auto FrameArena::FrameIndex() const noexcept -> U32 {
+			return m_FrameIndex;
+		}
+
+	}
+}
\ No newline at end of file
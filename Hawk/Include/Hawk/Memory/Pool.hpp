@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "../Common/Defines.hpp"
+#include "../Common/NonCopyable.hpp"
+#include "./Utility.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+//#include <Hawk/Memory/Utility.hpp>
+
+namespace Hawk {
+	namespace Memory {
+
+		struct PoolStats {
+			size_t CountLive;
+			size_t CountPeak;
+			size_t CountReserved;
+			size_t CountChunks;
+
+			auto Occupancy() const noexcept -> F32;
+		};
+
+		// Fixed-size object pool: blocks are carved from chunks and recycled through an intrusive free list.
+		// Single-threaded; use BlockAllocator for allocations that cross threads.
+		template<typename T>
+		class Pool : NonCopyable {
+		public:
+			Pool(U32 blocksPerChunk = 256);
+			~Pool();
+
+			template<typename... Args>
+			auto Create(Args&&... args) -> T*;
+			auto Destroy(T* object) noexcept -> void;
+
+			auto Allocate() -> void*;
+			auto Free(void* pointer) noexcept -> void;
+
+			auto Stats() const noexcept -> PoolStats;
+
+		private:
+			union Block {
+				Block*        Next;
+				alignas(T) U8 Storage[sizeof(T)];
+			};
+
+			auto AllocateChunk() -> void;
+
+			std::vector<AlignedBuffer> m_Chunks;
+			Block*                     m_FreeList;
+			U32                        m_BlocksPerChunk;
+			size_t                     m_CountLive;
+			size_t                     m_CountPeak;
+		};
+
+	}
+}
+
+namespace Hawk {
+	namespace Memory {
+
+		[[nodiscard]] ILINE auto PoolStats::Occupancy() const noexcept -> F32 {
+			return CountReserved > 0 ? static_cast<F32>(CountLive) / static_cast<F32>(CountReserved) : 1.0f;
+		}
+
+		template<typename T>
+		ILINE Pool<T>::Pool(U32 blocksPerChunk)
+			: m_FreeList(nullptr)
+			, m_BlocksPerChunk(blocksPerChunk)
+			, m_CountLive(0)
+			, m_CountPeak(0) {
+			assert(blocksPerChunk > 0);
+		}
+
+		template<typename T>
+		ILINE Pool<T>::~Pool() {
+			assert(m_CountLive == 0 && "Pool destroyed with live objects");
+		}
+
+		template<typename T>
+		template<typename... Args>
+		[[nodiscard]] ILINE auto Pool<T>::Create(Args&&... args) -> T* {
+			auto* pointer = this->Allocate();
+			try {
+				return new (pointer) T(std::forward<Args>(args)...);
+			} catch (...) {
+				this->Free(pointer);
+				throw;
+			}
+		}
+
+		template<typename T>
+		ILINE auto Pool<T>::Destroy(T* object) noexcept -> void {
+			if (object == nullptr)
+				return;
+			object->~T();
+			this->Free(object);
+		}
+
+		template<typename T>
+		[[nodiscard]] ILINE auto Pool<T>::Allocate() -> void* {
+			if (m_FreeList == nullptr)
+				this->AllocateChunk();
+
+			auto* block = m_FreeList;
+			m_FreeList = block->Next;
+			m_CountLive++;
+			m_CountPeak = (std::max)(m_CountPeak, m_CountLive);
+			Poison(block, sizeof(Block), PoisonAllocated);
+			return block;
+		}
+
+		template<typename T>
+		ILINE auto Pool<T>::Free(void* pointer) noexcept -> void {
+			assert(m_CountLive > 0);
+			Poison(pointer, sizeof(Block), PoisonReleased);
+			auto* block = static_cast<Block*>(pointer);
+			block->Next = m_FreeList;
+			m_FreeList = block;
+			m_CountLive--;
+		}
+
+		template<typename T>
+		[[nodiscard]] ILINE auto Pool<T>::Stats() const noexcept -> PoolStats {
+			return PoolStats{ m_CountLive, m_CountPeak, m_Chunks.size() * m_BlocksPerChunk, m_Chunks.size() };
+		}
+
+		template<typename T>
+		ILINE auto Pool<T>::AllocateChunk() -> void {
+			auto chunk = AllocateAligned(sizeof(Block) * m_BlocksPerChunk, (std::max)(alignof(Block), size_t{ HAWK_CACHE_LINE_SIZE }));
+			auto* blocks = reinterpret_cast<Block*>(chunk.get());
+
+			for (auto index = 0u; index < m_BlocksPerChunk; index++)
+				blocks[index].Next = index + 1 < m_BlocksPerChunk ? &blocks[index + 1] : m_FreeList;
+			m_FreeList = blocks;
+			m_Chunks.push_back(std::move(chunk));
+		}
+
+	}
+}
\ No newline at end of file
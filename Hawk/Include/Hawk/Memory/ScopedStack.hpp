@@ -0,0 +1,145 @@
+#pragma once
+
+#include <algorithm>
+#include <memory_resource>
+#include <new>
+
+#include "../Common/Defines.hpp"
+#include "../Common/NonCopyable.hpp"
+#include "./Utility.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+//#include <Hawk/Common/NonCopyable.hpp>
+//#include <Hawk/Memory/Utility.hpp>
+
+namespace Hawk {
+	namespace Memory {
+
+		class ScopedStack;
+
+		namespace Detail {
+
+			class ScopedStackResource : public std::pmr::memory_resource {
+			public:
+				ScopedStackResource(ScopedStack& stack) noexcept : m_Stack(stack) {}
+			private:
+				auto do_allocate(size_t size, size_t alignment) -> void* override;
+				auto do_deallocate(void*, size_t, size_t) noexcept -> void override {}
+				auto do_is_equal(std::pmr::memory_resource const& rhs) const noexcept -> bool override { return this == &rhs; }
+
+				ScopedStack& m_Stack;
+			};
+
+		}
+
+		// Single-threaded stack allocator: memory is handed back in bulk by rewinding to a marker.
+		class ScopedStack : NonCopyable {
+		public:
+			using Marker = size_t;
+
+			class Scope : NonCopyable {
+			public:
+				Scope(ScopedStack& stack) noexcept : m_Stack(stack), m_Marker(stack.GetMarker()) {}
+				~Scope() { m_Stack.Rewind(m_Marker); }
+			private:
+				ScopedStack& m_Stack;
+				Marker       m_Marker;
+			};
+
+			ScopedStack(size_t capacity);
+
+			auto Allocate(size_t size, size_t alignment = alignof(std::max_align_t)) noexcept -> void*;
+			template<typename T> auto Allocate(size_t count) noexcept -> T*;
+
+			auto GetMarker() const noexcept -> Marker;
+			auto Rewind(Marker marker) noexcept -> void;
+
+			auto Resource() noexcept -> std::pmr::memory_resource&;
+
+			auto Used()     const noexcept -> size_t;
+			auto Peak()     const noexcept -> size_t;
+			auto Capacity() const noexcept -> size_t;
+
+		private:
+			AlignedBuffer               m_Memory;
+			size_t                      m_Capacity;
+			size_t                      m_Offset;
+			size_t                      m_Peak;
+			Detail::ScopedStackResource m_Resource;
+		};
+
+	}
+}
+
+namespace Hawk {
+	namespace Memory {
+
+		namespace Detail {
+
+			ILINE auto ScopedStackResource::do_allocate(size_t size, size_t alignment) -> void* {
+				if (auto* pointer = m_Stack.Allocate(size, alignment))
+					return pointer;
+				throw std::bad_alloc{};
+			}
+
+		}
+
+		ILINE ScopedStack::ScopedStack(size_t capacity)
+			: m_Memory(AllocateAligned(capacity))
+			, m_Capacity(capacity)
+			, m_Offset(0)
+			, m_Peak(0)
+			, m_Resource(*this) {
+			Poison(m_Memory.get(), m_Capacity, PoisonReleased);
+		}
+
+		[[nodiscard]] ILINE auto ScopedStack::Allocate(size_t size, size_t alignment) noexcept -> void* {
+			assert(IsPowerOfTwo(alignment) && alignment <= HAWK_CACHE_LINE_SIZE);
+
+			auto const begin = AlignUp(m_Offset, alignment);
+			if (begin + size > m_Capacity) {
+				assert(false && "ScopedStack is out of memory");
+				return nullptr;
+			}
+
+			m_Offset = begin + size;
+			m_Peak = (std::max)(m_Peak, m_Offset);
+
+			auto* pointer = m_Memory.get() + begin;
+			Poison(pointer, size, PoisonAllocated);
+			return pointer;
+		}
+
+		template<typename T>
+		[[nodiscard]] ILINE auto ScopedStack::Allocate(size_t count) noexcept -> T* {
+			return static_cast<T*>(this->Allocate(sizeof(T) * count, alignof(T)));
+		}
+
+		[[nodiscard]] ILINE auto ScopedStack::GetMarker() const noexcept -> Marker {
+			return m_Offset;
+		}
+
+		ILINE auto ScopedStack::Rewind(Marker marker) noexcept -> void {
+			assert(marker <= m_Offset);
+			Poison(m_Memory.get() + marker, m_Offset - marker, PoisonReleased);
+			m_Offset = marker;
+		}
+
+		[[nodiscard]] ILINE auto ScopedStack::Resource() noexcept -> std::pmr::memory_resource& {
+			return m_Resource;
+		}
+
+		[[nodiscard]] ILINE auto ScopedStack::Used() const noexcept -> size_t {
+			return m_Offset;
+		}
+
+		[[nodiscard]] ILINE auto ScopedStack::Peak() const noexcept -> size_t {
+			return m_Peak;
+		}
+
+		[[nodiscard]] ILINE auto ScopedStack::Capacity() const noexcept -> size_t {
+			return m_Capacity;
+		}
+
+	}
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstring>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+#include "../Common/Defines.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+
+#if !defined(HAWK_MEMORY_POISON) && defined(_DEBUG)
+#define HAWK_MEMORY_POISON 1
+#endif
+
+namespace Hawk {
+	namespace Memory {
+
+		constexpr U8 PoisonAllocated = 0xCD;
+		constexpr U8 PoisonReleased  = 0xDD;
+
+		struct AlignedDeleter {
+			size_t Alignment;
+			auto operator()(U8* pointer) const noexcept -> void;
+		};
+
+		using AlignedBuffer = std::unique_ptr<U8[], AlignedDeleter>;
+
+		constexpr auto AlignUp(size_t value, size_t alignment) noexcept -> size_t;
+		constexpr auto IsPowerOfTwo(size_t value) noexcept -> bool;
+
+		auto AllocateAligned(size_t size, size_t alignment = HAWK_CACHE_LINE_SIZE) -> AlignedBuffer;
+		auto Poison(void* pointer, size_t size, U8 pattern) noexcept -> void;
+
+		// A type is trivially relocatable when moving it to a new address and dropping the old object is the same
+		// as copying its bytes. Trivially copyable types always are; containers that hold no pointers into
+		// themselves specialize this so their own containers can grow with memcpy.
+		template<typename T>
+		struct IsTriviallyRelocatable : std::is_trivially_copyable<T> {};
+
+		template<typename T>
+		constexpr bool IsTriviallyRelocatableV = IsTriviallyRelocatable<T>::value;
+
+		template<typename T>
+		auto Relocate(T* destination, T* source, size_t count) noexcept -> void;
+
+	}
+}
+
+namespace Hawk {
+	namespace Memory {
+
+		ILINE auto AlignedDeleter::operator()(U8* pointer) const noexcept -> void {
+			::operator delete[](pointer, std::align_val_t{ Alignment });
+		}
+
+		[[nodiscard]] ILINE constexpr auto AlignUp(size_t value, size_t alignment) noexcept -> size_t {
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		[[nodiscard]] ILINE constexpr auto IsPowerOfTwo(size_t value) noexcept -> bool {
+			return value > 0 && (value & (value - 1)) == 0;
+		}
+
+		[[nodiscard]] ILINE auto AllocateAligned(size_t size, size_t alignment) -> AlignedBuffer {
+			assert(IsPowerOfTwo(alignment));
+			auto* pointer = static_cast<U8*>(::operator new[](size, std::align_val_t{ alignment }));
+			return AlignedBuffer{ pointer, AlignedDeleter{ alignment } };
+		}
+
+		template<typename T>
+		ILINE auto Relocate(T* destination, T* source, size_t count) noexcept -> void {
+			if constexpr (IsTriviallyRelocatableV<T>) {
+				if (count > 0)
+					std::memcpy(static_cast<void*>(destination), static_cast<void const*>(source), count * sizeof(T));
+			} else {
+				static_assert(std::is_nothrow_move_constructible_v<T>, "Relocation requires a noexcept move constructor");
+				for (auto index = size_t{ 0 }; index < count; index++) {
+					new (destination + index) T(std::move(source[index]));
+					source[index].~T();
+				}
+			}
+		}
+
+		// Fills memory with a recognisable pattern in debug builds so use-after-reset reads stand out
+		ILINE auto Poison(void* pointer, size_t size, U8 pattern) noexcept -> void {
+#if defined(HAWK_MEMORY_POISON)
+			std::memset(pointer, pattern, size);
+#else
+			(void)pointer;
+			(void)size;
+			(void)pattern;
+#endif
+		}
+
+	}
+}
\ No newline at end of file
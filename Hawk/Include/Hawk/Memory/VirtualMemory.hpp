@@ -0,0 +1,89 @@
+#pragma once
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "../Common/Defines.hpp"
+
+//#include <Hawk/Common/Defines.hpp>
+
+namespace Hawk {
+	namespace Memory {
+
+		// Thin wrappers over the OS virtual memory API. Reserve claims address space only; pages cost nothing
+		// until committed, and decommitted pages go back to the OS while the range stays reserved.
+		namespace Virtual {
+
+			auto PageSize() noexcept -> size_t;
+			auto Reserve(size_t size) noexcept -> void*;
+			auto Commit(void* pointer, size_t size) noexcept -> bool;
+			auto Decommit(void* pointer, size_t size) noexcept -> void;
+			auto Release(void* pointer, size_t size) noexcept -> void;
+
+		}
+
+	}
+}
+
+namespace Hawk {
+	namespace Memory {
+		namespace Virtual {
+
+			[[nodiscard]] ILINE auto PageSize() noexcept -> size_t {
+#if defined(_WIN32)
+				SYSTEM_INFO info;
+				::GetSystemInfo(&info);
+				return static_cast<size_t>(info.dwPageSize);
+#else
+				return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+			}
+
+			[[nodiscard]] ILINE auto Reserve(size_t size) noexcept -> void* {
+#if defined(_WIN32)
+				return ::VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS);
+#else
+				auto* pointer = ::mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+				return pointer != MAP_FAILED ? pointer : nullptr;
+#endif
+			}
+
+			[[nodiscard]] ILINE auto Commit(void* pointer, size_t size) noexcept -> bool {
+#if defined(_WIN32)
+				return ::VirtualAlloc(pointer, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+#else
+				return ::mprotect(pointer, size, PROT_READ | PROT_WRITE) == 0;
+#endif
+			}
+
+			ILINE auto Decommit(void* pointer, size_t size) noexcept -> void {
+#if defined(_WIN32)
+				::VirtualFree(pointer, size, MEM_DECOMMIT);
+#else
+				::madvise(pointer, size, MADV_DONTNEED);
+				::mprotect(pointer, size, PROT_NONE);
+#endif
+			}
+
+			ILINE auto Release(void* pointer, size_t size) noexcept -> void {
+#if defined(_WIN32)
+				(void)size;
+				::VirtualFree(pointer, 0, MEM_RELEASE);
+#else
+				::munmap(pointer, size);
+#endif
+			}
+
+		}
+	}
+}
\ No newline at end of file